@@ -6,14 +6,15 @@
  *****************************************************************************/
 
 #include "day08.hpp"
-#include "lib.hpp"   // for parse_args, DEBUG
-#include <algorithm> // for max, any_of
-#include <cstdlib>   // for abs, size_t
-#include <fstream>   // for ifstream
-#include <iostream>  // for cout, cerr
-#include <numeric>   // for lcm
-#include <string>    // for string
-// IWYU pragma: no_include <functional>  // for identity, less (ranges::{max,any_of})
+#include "lib.hpp"       // for parse_args, DEBUG
+#include "util/math.hpp" // for CongruenceSolver
+#include <algorithm>     // for max, all_of
+#include <cstddef>       // for size_t
+#include <fstream>       // for ifstream
+#include <iostream>      // for cout, cerr
+#include <string>        // for string
+#include <vector>        // for vector
+// IWYU pragma: no_include <functional>  // for identity, less (ranges::{max,all_of})
 
 int part_1(const std::string &directions, const aoc::day08::Network &network) {
     int steps = 0;
@@ -33,50 +34,87 @@ int part_1(const std::string &directions, const aoc::day08::Network &network) {
 
 /// fast version that works for the real input, using LCM
 long part_2_fast(const std::vector<aoc::day08::CycleInfo> &cycles) {
-    long multiple = 1;
+    // each cycle finishes on multiples of its length, so this is their lcm
+    aoc::math::CongruenceSolver solver;
     for (const auto &cycle : cycles) {
-        multiple = std::lcm(multiple, cycle.length);
+        solver.add(0, cycle.length);
     }
-    return multiple;
+    return solver.solution()->modulus;
 }
 
-/// slower version that works for any input, using accelerated time-stepping
+/// slower version that works for any input, using CRT on every combination of
+/// finish entries
 long part_2_slow(const std::vector<aoc::day08::CycleInfo> &cycles) {
     using namespace aoc::day08;
-    // follow the cycle with the longest average time between encountering
-    // finish nodes
-    const CycleInfo &base_cycle =
+    using aoc::math::CongruenceSolver;
+    using crt_entry = CongruenceSolver::crt_entry;
+    // every cycle is periodic once the last one starts
+    const CycleInfo &last_cycle =
         std::ranges::max(cycles, {}, [](const CycleInfo &cycle) {
-            return cycle.length / cycle.entries.size();
+            return cycle.start;
         });
-    std::vector<long> diffs;
-    if (base_cycle.entries.size() > 1) {
-        for (std::size_t i = 0; i < base_cycle.entries.size(); ++i) {
-            diffs.push_back(std::abs(
-                base_cycle.entries[(i + 1) % base_cycle.entries.size()].step -
-                base_cycle.entries[i].step));
+    const long periodic_start = last_cycle.start;
+    // before then, the answer has to be one of the last cycle's finish steps
+    // (entries are sorted by step)
+    for (const FinishEntry &entry : last_cycle.entries) {
+        if (entry.step >= periodic_start) {
+            break;
+        }
+        if (std::ranges::all_of(cycles, [&entry](const CycleInfo &cycle) {
+                return cycle.at_finish(entry.step);
+            })) {
+            return entry.step;
         }
-    } else {
-        diffs.push_back(base_cycle.length);
     }
-    long step = 0;
-    std::size_t i = 0;
-    long counter = 0;
-    // while any of the cycles aren't at a finish node:
-    while (std::ranges::any_of(cycles, [&step](const CycleInfo &cycle) {
-        return !cycle.at_finish(step);
-    })) {
-        step += diffs[i];
-        i = (i + 1) % diffs.size();
-        if constexpr (aoc::DEBUG) {
-            if (counter % 1'000'000 == 0) {
-                std::cerr << ".";
-                std::cerr.flush();
+
+    // afterwards, each finish entry on a cycle gives a congruence, and the
+    // answer has to satisfy one from every cycle
+    std::vector<std::vector<crt_entry>> congruences;
+    for (const CycleInfo &cycle : cycles) {
+        auto &cycle_congruences = congruences.emplace_back();
+        for (const FinishEntry &entry : cycle.entries) {
+            if (entry.step >= cycle.start) {
+                cycle_congruences.push_back({entry.step, cycle.length});
+            }
+        }
+    }
+    long best = -1;
+    // pick one congruence per cycle, depth-first, so each prefix of choices is
+    // only combined once
+    const auto recurse = [&congruences, &best, periodic_start](
+                             const auto &self, std::size_t i,
+                             const CongruenceSolver &prefix) -> void {
+        if (i + 1 < congruences.size()) {
+            for (const crt_entry &congruence : congruences[i]) {
+                CongruenceSolver solver = prefix;
+                if (solver.add(congruence)) {
+                    self(self, i + 1, solver);
+                }
+            }
+            return;
+        }
+        for (const auto &result : prefix.solve_each(congruences[i])) {
+            if (!result) {
+                continue;
             }
-            ++counter;
+            // smallest solution that's past every cycle's start
+            long step = result->remainder;
+            if (step < periodic_start) {
+                step += (periodic_start - step + result->modulus - 1) /
+                        result->modulus * result->modulus;
+            }
+            if (best < 0 || step < best) {
+                best = step;
+            }
+        }
+    };
+    recurse(recurse, 0, CongruenceSolver{});
+    if constexpr (aoc::DEBUG) {
+        if (best < 0) {
+            std::cerr << "no solution found\n";
         }
     }
-    return step;
+    return best;
 }
 
 long part_2(const std::string &directions, const aoc::day08::Network &network) {
@@ -6,22 +6,20 @@
  *****************************************************************************/
 
 #include "day09.hpp"
-#include "lib.hpp"   // for parse_args
-#include <algorithm> // for any_of
-#include <fstream>   // for ifstream
-#include <iostream>  // for cout
-#include <stack>     // for stack
-#include <string>    // for string, getline
-#include <vector>    // for vector
+#include "lib.hpp"     // for parse_args, lines
+#include <algorithm>   // for any_of
+#include <iostream>    // for cout
+#include <stack>       // for stack
+#include <string_view> // for string_view
+#include <vector>      // for vector
 // IWYU pragma: no_include <functional>  // for identity (ranges::any_of)
 
 int main(int argc, char **argv) {
-    std::ifstream infile = aoc::parse_args(argc, argv).infile;
+    const auto input = aoc::parse_args(argc, argv).map_infile();
 
     // read file line-by-line
-    std::string line;
     int part_1 = 0, part_2 = 0;
-    while (std::getline(infile, line)) {
+    for (std::string_view line : aoc::lines(input.view())) {
         using namespace aoc::day09;
         std::stack<std::vector<int>> diffs;
         diffs.push(read_history(line));
@@ -8,18 +8,16 @@
 #ifndef DAY09_HPP_UZDLAO3M
 #define DAY09_HPP_UZDLAO3M
 
-#include "lib.hpp" // for read_vector
-#include <cassert> // for assert
-#include <cstddef> // for size_t
-#include <sstream> // for istringstream
-#include <string>  // for string
-#include <vector>  // for vector
+#include "lib.hpp"     // for read_vector
+#include <cassert>     // for assert
+#include <cstddef>     // for size_t
+#include <string_view> // for string_view
+#include <vector>      // for vector
 
 namespace aoc::day09 {
 
-std::vector<int> read_history(const std::string &line) {
-    std::istringstream ss{line};
-    return aoc::read_vector<int>(ss);
+std::vector<int> read_history(std::string_view line) {
+    return aoc::read_vector<int>(line);
 }
 
 std::vector<int> diff(const std::vector<int> &vec) {
@@ -6,75 +6,75 @@
  *****************************************************************************/
 
 #include "day14.hpp"
+#include "bench.hpp"     // for Benchmark
+#include "cycle.hpp"     // for fast_forward
 #include "lib.hpp"       // for parse_args, DEBUG
-#include <fstream>       // for ifstream
+#include "util/hash.hpp" // for hash_bytes
 #include <iostream>      // for cout, cerr
-#include <unordered_map> // for unordered_map
-// IWYU pragma: no_include <functional>  // for hash (unordered_map)
 
-void solve(int argc, char **argv, bool print) {
-    std::ifstream infile = aoc::parse_args(argc, argv).infile;
-
-    std::unordered_map<std::vector<bool>, long> states;
-    auto platform = aoc::day14::read_platform(infile);
+namespace aoc::day14 {
 
+/// Returns the load after tilting north once.
+int tilted_load(Platform &platform) {
+    platform.tilt();
     if constexpr (aoc::DEBUG) {
-        std::cerr << "before tilting:\n" << platform << "\n";
+        std::cerr << "after tilting:\n" << platform << "\n";
     }
-    // rotate so north is the initial tilt direction
-    platform.rotate_ccw();
+    return platform.calculate_load();
+}
+
+/// Returns the load after a billion spin cycles.
+int spin_cycle_load(Platform &platform) {
+    constexpr long num_cycles = 1'000'000'000;
+    const auto spin_cycle = [](Platform &state) {
+        for (int i = 0; i < 4; ++i) {
+            state.tilt();
+            state.rotate_cw();
+        }
+    };
+    // the cube rocks never move, so this only depends on the round rocks
+    const auto fingerprint = [](const Platform &state) {
+        return util::hash_bytes(state.rocks.data());
+    };
+    const auto cycle = aoc::cycle::fast_forward(platform, num_cycles,
+                                                spin_cycle, fingerprint);
     if constexpr (aoc::DEBUG) {
-        std::cerr << "after rotating counter-clockwise:\n" << platform << "\n";
+        if (cycle) {
+            std::cerr << "found cycle: " << cycle->start << " -> "
+                      << cycle->start + cycle->length << "\n";
+        }
     }
+    return platform.calculate_load();
+}
+
+} // namespace aoc::day14
 
-    constexpr long max_step = 4'000'000'000;
+int main(int argc, char **argv) {
+    const auto input = aoc::parse_args(argc, argv).map_infile();
+    aoc::bench::Benchmark bench("2023 day14");
 
-    long cycle_length = 0;
-    for (long step = 0; step < max_step; ++step) {
-        platform.tilt();
-        if (cycle_length == 0 && step % 4 == 0) {
-            const std::vector<bool> round_rocks = platform.round_rocks();
-            auto it = states.find(round_rocks);
-            if (it != states.end()) {
-                cycle_length = step - it->second;
-                if constexpr (aoc::DEBUG) {
-                    std::cerr << "found cycle: " << it->second << " -> " << step
-                              << "\n";
-                }
-                // skip to the final cycle iteration
-                step += (max_step - step - 1) / cycle_length * cycle_length;
-                if constexpr (aoc::DEBUG) {
-                    std::cerr << "skipped to " << step << "\n";
-                }
-            } else {
-                states.try_emplace(round_rocks, step);
-            }
+    const auto platform = bench.stage("parse", [&input]() {
+        auto platform = aoc::day14::read_platform(input.view());
+        if constexpr (aoc::DEBUG) {
+            std::cerr << "before tilting:\n" << platform << "\n";
         }
-        if (step == 0) {
-            if constexpr (aoc::DEBUG) {
-                std::cerr << "after tilting:\n" << platform << "\n";
-            }
-            // part 1
-            int part_1 = platform.calculate_load();
-            if (print) {
-                std::cout << part_1 << "\n";
-            }
+        // rotate so north is the initial tilt direction
+        platform.rotate_ccw();
+        if constexpr (aoc::DEBUG) {
+            std::cerr << "after rotating counter-clockwise:\n"
+                      << platform << "\n";
         }
-        platform.rotate_cw();
-    }
+        return platform;
+    });
 
-    // part 2
-    int part_2 = platform.calculate_load();
-    if (print) {
-        std::cout << part_2 << "\n";
-    }
-}
+    // both parts tilt the platform in place, so they get a fresh copy each run
+    const auto copy_platform = [&platform]() { return platform; };
+    int part_1 = bench.stage("part1", copy_platform, aoc::day14::tilted_load);
+    std::cout << part_1 << "\n";
+
+    int part_2 =
+        bench.stage("part2", copy_platform, aoc::day14::spin_cycle_load);
+    std::cout << part_2 << "\n";
 
-int main(int argc, char **argv) {
-    constexpr int N = 1;
-    // constexpr int N = 100;
-    for (int i = 0; i < N; ++i) {
-        solve(argc, argv, i == 0);
-    }
     return 0;
 }
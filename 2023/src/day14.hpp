@@ -11,10 +11,9 @@
 #include "ds/grid.hpp" // for Grid
 #include "lib.hpp"     // for Pos
 #include <cstddef>     // for size_t
-#include <iostream>    // for istream
-#include <string>      // for string, getline
-#include <utility>     // for move
-#include <vector>      // for vector
+#include <iostream>    // for ostream
+#include <string_view> // for string_view
+#include <utility>     // for move, swap
 
 namespace aoc::day14 {
 
@@ -36,13 +35,16 @@ struct Platform {
     void roll_row_down(int row);
 
   public:
-    explicit Platform(std::vector<std::vector<Rock>> &&rocks_)
+    explicit Platform(aoc::ds::Grid<Rock> &&rocks_)
         : rocks(std::move(rocks_)) {}
     void rotate_cw();
     void rotate_ccw();
     void tilt();
     int calculate_load() const;
-    std::vector<bool> round_rocks() const;
+
+    bool operator==(const Platform &other) const {
+        return rocks.data() == other.rocks.data();
+    }
 };
 
 void Platform::transpose() {
@@ -124,31 +126,14 @@ int Platform::calculate_load() const {
     return load;
 }
 
-std::vector<bool> Platform::round_rocks() const {
-    std::vector<bool> round(rocks.data().size(), false);
-    for (std::size_t i = 0; i < rocks.data().size(); ++i) {
-        if (rocks[i] == Rock::round) {
-            round[i] = true;
-        }
-    }
-    return round;
-}
-
 std::ostream &operator<<(std::ostream &os, const Platform &platform) {
     return platform.rocks.custom_print(
         os, [&os](Rock rock) { os << static_cast<char>(rock); });
 }
 
-Platform read_platform(std::istream &is) {
-    std::vector<std::vector<Rock>> rocks;
-    std::string line;
-    while (std::getline(is, line)) {
-        rocks.emplace_back();
-        for (char ch : line) {
-            rocks.back().push_back(Rock{ch});
-        }
-    }
-    return Platform{std::move(rocks)};
+Platform read_platform(std::string_view text) {
+    return Platform{aoc::ds::Grid<Rock>::from_buffer(
+        text, [](char ch) { return Rock{ch}; })};
 }
 
 } // namespace aoc::day14
@@ -7,13 +7,12 @@
 
 #include "day16.hpp"
 #include "lib.hpp"  // for parse_args, Pos, AbsDirection, DEBUG
-#include <fstream>  // for ifstream
 #include <iostream> // for cout, cerr
 
 int main(int argc, char **argv) {
-    std::ifstream infile = aoc::parse_args(argc, argv).infile;
+    const auto input = aoc::parse_args(argc, argv).map_infile();
 
-    auto laser_grid = aoc::day16::LaserGrid::read(infile);
+    auto laser_grid = aoc::day16::LaserGrid::read(input.view());
 
     if constexpr (aoc::DEBUG) {
         std::cerr << laser_grid << "\n";
@@ -8,7 +8,8 @@
 #ifndef DAY16_HPP_80LYO54U
 #define DAY16_HPP_80LYO54U
 
-#include "ds/grid.hpp" // for Grid
+#include "ds/bit_grid.hpp" // for BitGrid
+#include "ds/grid.hpp"     // for Grid
 #include "graph_traversal.hpp"
 #include "lib.hpp"          // for Pos, AbsDirection, Delta
 #include "util/hash.hpp"    // for make_hash
@@ -16,9 +17,9 @@
 #include <cstddef>          // for size_t
 #include <functional>       // for hash
 #include <initializer_list> // for initializer_list
-#include <iostream>         // for istream, ostream
+#include <iostream>         // for ostream
 #include <set>              // for set
-#include <string>           // for string, getline
+#include <string_view>      // for string_view
 #include <tuple>            // for tie
 #include <unordered_map>    // for unordered_map
 #include <unordered_set>    // for unordered_set
@@ -96,11 +97,10 @@ std::vector<AbsDirection> Tile::get_out_dir(AbsDirection in_dir) const {
 
 class LaserGrid : public aoc::ds::Grid<Tile> {
   public:
-    explicit LaserGrid(std::vector<std::vector<Tile>> &&tiles)
-        : Grid<Tile>(std::move(tiles)) {}
+    explicit LaserGrid(Grid<Tile> &&tiles) : Grid<Tile>(std::move(tiles)) {}
     int count_energized() const;
 
-    static LaserGrid read(std::istream &);
+    static LaserGrid read(std::string_view text);
 
     void print_energized(std::ostream &os) const;
     friend std::ostream &operator<<(std::ostream &, const LaserGrid &);
@@ -111,16 +111,10 @@ int LaserGrid::count_energized() const {
                          [](const Tile &tile) { return tile.energized; });
 }
 
-LaserGrid LaserGrid::read(std::istream &is) {
-    std::vector<std::vector<Tile>> tiles;
-    std::string line;
-    while (std::getline(is, line)) {
-        tiles.emplace_back();
-        for (char ch : line) {
-            tiles.back().push_back(Tile{static_cast<TileType>(ch), false});
-        }
-    }
-    return LaserGrid{std::move(tiles)};
+LaserGrid LaserGrid::read(std::string_view text) {
+    return LaserGrid{Grid<Tile>::from_buffer(text, [](char ch) {
+        return Tile{static_cast<TileType>(ch), false};
+    })};
 }
 
 void LaserGrid::print_energized(std::ostream &os) const {
@@ -227,7 +221,7 @@ std::ostream &operator<<(std::ostream &os, const GraphHelper::Key &key) {
 }
 
 int GraphHelper::count_energized(const GraphHelper::Key &source) const {
-    aoc::ds::Grid<bool> energized(grid, false);
+    aoc::ds::BitGrid energized(grid, false);
     std::vector<bool> visited(components.size(), false);
 
     const auto visit_with_parent = [&energized, &components = components,
@@ -251,7 +245,7 @@ int GraphHelper::count_energized(const GraphHelper::Key &source) const {
         },
         /*is_target*/ {}, visit_with_parent);
 
-    return std::count(energized.data().begin(), energized.data().end(), true);
+    return energized.count();
 }
 
 } // namespace aoc::day16
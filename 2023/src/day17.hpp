@@ -9,20 +9,20 @@
 #define DAY17_HPP_3D5Q7QMY
 
 #include "ds/grid.hpp"         // for Grid
-#include "graph_traversal.hpp" // for dijkstra, a_star
+#include "graph_traversal.hpp" // for dijkstra, a_star, with_max_weight, ...
 #include "lib.hpp"             // for Pos, DEBUG, as_number
 #include "util/hash.hpp"       // for make_hash
 
 #include <algorithm>        // for transform
 #include <compare>          // for strong_ordering
 #include <cstddef>          // for size_t
-#include <functional>       // for function, bind_front, hash
+#include <functional>       // for bind_front, hash
 #include <initializer_list> // for initializer_list
 #include <iostream>         // for cerr, istream, ostream
 #include <iterator>         // for back_inserter
 #include <string>           // for string, getline
 #include <unordered_map>    // for unordered_map
-#include <utility>          // for move, pair
+#include <utility>          // for move, pair, make_pair
 #include <vector>           // for vector
 
 namespace aoc::day17 {
@@ -115,10 +115,9 @@ int CityMap::find_shortest_path() const {
     constexpr bool ultra = part == PART_2;
     Key source{Pos(0, 0), Orientation::horizontal};
     const Pos target(block_costs.width - 1, block_costs.height - 1);
-    std::function<void(const Key &, int)> visit = [](const Key &, int) {};
 #if 0
-    if constexpr (aoc::DEBUG && ultra) {
-        visit = [this](const Key &key, int dist) {
+    const auto visit = [this](const Key &key, int dist) {
+        if constexpr (aoc::DEBUG && ultra) {
             std::cerr << "visiting " << key << ", with distance=" << dist
                       << "\n";
             std::cerr << "neighbors:\n";
@@ -126,19 +125,29 @@ int CityMap::find_shortest_path() const {
                 std::cerr << "  " << neighbor
                           << ", dist=" << get_distance(key, neighbor) << "\n";
             });
-        };
-    }
+        }
+    };
+#else
+    // a plain lambda rather than a std::function, so it inlines away
+    const auto visit = [](const Key &, int) {};
 #endif
     const auto is_target = [&target](const Key &key) -> bool {
         return key.pos == target;
     };
+    const auto indexer = aoc::graph::make_grid_indexer(
+        block_costs, 2,
+        [](const Key &key) { return std::make_pair(key.pos, key.orient); });
 #if 1
     const auto &[distance, path] = aoc::graph::dijkstra(
         source,
         [this](const Key &key, auto &&visit_neighbor) {
             this->process_neighbors(ultra, key, visit_neighbor);
         },
-        std::bind_front(&CityMap::get_distance, this), is_target, visit);
+        // each move crosses at most max_straight_moves blocks, with costs 1-9
+        aoc::graph::with_max_weight(
+            9 * (ultra ? 10 : 3),
+            std::bind_front(&CityMap::get_distance, this)),
+        is_target, visit, indexer);
 #else
     const auto &[distance, path] = aoc::graph::a_star(
         source,
@@ -149,7 +158,7 @@ int CityMap::find_shortest_path() const {
         [&target](const Key &key) -> int {
             return (key.pos - target).manhattan_distance();
         },
-        visit);
+        visit, indexer);
 #endif
     if constexpr (aoc::DEBUG) {
         if (distance >= 0) {
@@ -9,7 +9,8 @@
 #define DAY20_HPP_QRITMDTC
 
 #include "graph_traversal.hpp"
-#include "lib.hpp"   // for DEBUG
+#include "lib.hpp"       // for DEBUG
+#include "util/math.hpp" // for CongruenceSolver
 #include <algorithm> // for all_of, transform, lower_bound, sort, ranges::for_each
 #include <cassert>   // for assert
 #include <cstddef>   // for size_t
@@ -17,7 +18,6 @@
 #include <iostream>         // for istream, ostream, cerr, cout
 #include <iterator>         // for back_inserter, distance
 #include <memory>           // for unique_ptr, make_unique
-#include <numeric>          // for lcm
 #include <queue>            // for queue
 #include <set>              // for set (tarjan_scc)
 #include <sstream>          // for istringstream
@@ -418,13 +418,15 @@ bool MessageBus::check_cycles(long presses) {
 }
 
 long MessageBus::calculate_finish() const {
-    long lcm = 1;
+    // every cycle fires on multiples of its length, so the answer is their
+    // lcm (checked for overflow)
+    aoc::math::CongruenceSolver solver;
     for (auto &[_, info] : cycles) {
         assert(info.low_presses.size() == 1);
         assert(info.low_presses[0] == info.length);
-        lcm = std::lcm(lcm, info.length);
+        solver.add(0, info.length);
     }
-    return lcm;
+    return solver.solution()->modulus;
 }
 
 } // namespace aoc::day20
@@ -9,14 +9,17 @@
 #define DAY21_HPP_2X5T9V1Y
 
 #include "ds/grid.hpp"         // for Grid
-#include "graph_traversal.hpp" // for bfs
+#include "graph_traversal.hpp" // for bfs_parallel, make_grid_indexer
 #include "lib.hpp"             // for Pos, DEBUG
+#include <algorithm>           // for replace
 #include <array>               // for array
 #include <cassert>             // for assert
 #include <compare>             // for strong_ordering
 #include <cstdlib>             // for abs, size_t
+#include <initializer_list>    // for initializer_list
 #include <iostream>            // for istream, noskipws, cerr
 #include <limits>              // for numeric_limits
+#include <utility>             // for move
 #include <vector>              // for vector
 
 namespace aoc::day21 {
@@ -35,32 +38,19 @@ struct Garden {
     }
 
     Grid<int> get_distances(const Key &source) const {
-        Grid<int> distances(stones, std::numeric_limits<int>::max());
-        distances[source] = 0;
-
-        const auto process_neighbors = [this, &distances](const Key &key,
-                                                          auto &&process) {
+        const auto process_neighbors = [this](const Key &key, auto &&process) {
             stones.manhattan_kernel(key, [&](bool open, const Pos &pos) {
-                if (open && distances[pos] == std::numeric_limits<int>::max()) {
+                if (open && pos != key) {
                     process(pos);
                 }
             });
         };
-        const auto visit = [&source, &distances](const Key &key,
-                                                 int distance) -> bool {
-            auto idx = distances.get_index(key);
-            if (key != source &&
-                distances[idx] != std::numeric_limits<int>::max()) {
-                return false;
-            }
-            distances[idx] = distance;
-            return true;
-        };
-
-        aoc::graph::bfs_manual_dedupe(source, process_neighbors,
-                                      /*is_target*/ {}, visit);
 
-        return distances;
+        std::vector<int> distances = aoc::graph::bfs_parallel(
+            std::initializer_list<Key>{source}, process_neighbors,
+            aoc::graph::make_grid_indexer(stones));
+        std::ranges::replace(distances, -1, std::numeric_limits<int>::max());
+        return Grid<int>(stones.width, stones.height, std::move(distances));
     }
 
     bool check_part_2() const;
@@ -8,7 +8,8 @@
 #ifndef DAY23_HPP_VAEIOPZT
 #define DAY23_HPP_VAEIOPZT
 
-#include "ds/grid.hpp" // for Grid
+#include "ds/bit_grid.hpp" // for BitGrid
+#include "ds/grid.hpp"     // for Grid
 #include "graph_traversal.hpp"
 #include "lib.hpp" // for Pos, AbsDirection, Delta, read_lines, DEBUG, DIRECTIONS
 #include <algorithm>        // for ranges::count, ranges::for_each
@@ -168,7 +169,7 @@ void TrailMap::construct_trails(Pos start_pos) {
     std::queue<std::pair<Pos, Pos>> pending;
     pending.emplace(start_pos, start_pos);
 
-    aoc::ds::Grid<bool> seen(grid, false);
+    aoc::ds::BitGrid seen(grid, false);
     seen[start_pos] = true;
     // allocate this once and reuse it, instead of allocating and deallocating
     // inside the loop
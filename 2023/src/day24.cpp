@@ -6,7 +6,7 @@
  *****************************************************************************/
 
 #include "day24.hpp"
-#include "gauss_elim.hpp" // for gauss_elim, solve_upper_triangular, RowPermuter
+#include "gauss_elim.hpp" // for row_echelon, back_substitute, solve_exact, ...
 #include "lib.hpp"        // for parse_args, DEBUG
 #include "unit_test/pretty_print.hpp"
 #include <cmath>    // for llround
@@ -53,6 +53,24 @@ std::int64_t part_2(const std::vector<aoc::day24::Hailstone> &stones) {
         for (std::size_t j = i + 1; j < stones.size(); ++j) {
             for (std::size_t k = 0; k < stones.size(); ++k) {
                 for (std::size_t l = j + 1; l < stones.size(); ++l) {
+                    // solve with exact integer arithmetic if the system is
+                    // small enough, otherwise fall back to floating point
+                    // (real inputs are always too large for __int128)
+                    {
+                        auto [A, b] = aoc::day24::make_system<std::int64_t>(
+                            stones, {i, j}, {k, l});
+                        if (exact_solve_fits<__int128>(A, b)) {
+                            auto x = solve_exact(A, b);
+                            if (!x) {
+                                continue;
+                            }
+                            return (*x)[0] + (*x)[1] + (*x)[2];
+                        }
+                        if constexpr (aoc::DEBUG) {
+                            std::cerr << "system too large for an exact "
+                                         "solve, using floating point\n";
+                        }
+                    }
                     auto [A, b] = aoc::day24::make_system<value_t>(
                         stones, {i, j}, {k, l});
                     if constexpr (aoc::DEBUG) {
@@ -60,20 +78,15 @@ std::int64_t part_2(const std::vector<aoc::day24::Hailstone> &stones) {
                                   << pretty_print::repr(A) << "\n"
                                   << "b: " << pretty_print::repr(b) << "\n";
                     }
-                    std::optional<RowPermuter> rp = gauss_elim(A, b);
+                    const bool ok = row_echelon(A, b);
                     if constexpr (aoc::DEBUG) {
                         std::cerr << "after Gaussian elimination:\n"
                                   << "A:\n"
                                   << pretty_print::repr(A) << "\n"
                                   << "b: " << pretty_print::repr(b) << "\n";
                     }
-                    if (rp) {
-                        if constexpr (aoc::DEBUG) {
-                            std::cerr << "row order: "
-                                      << pretty_print::repr(rp->row_order)
-                                      << "\n";
-                        }
-                        auto x = solve_upper_triangular(A, b, *rp);
+                    if (ok) {
+                        auto x = back_substitute(A, b);
                         if constexpr (aoc::DEBUG) {
                             std::cerr << "x: " << pretty_print::repr(x) << "\n";
                         }
@@ -9,14 +9,13 @@
 #include "lib.hpp"
 #include <algorithm> // for ranges::sort
 #include <cstdlib>   // for abs, size_t
-#include <fstream>   // for ifstream
 #include <iostream>  // for cout
 // IWYU pragma: no_include <functional>  // for identity, less (ranges::sort)
 
 int main(int argc, char **argv) {
-    std::ifstream infile = aoc::parse_args(argc, argv).infile;
+    const auto input = aoc::parse_args(argc, argv).map_infile();
 
-    auto [left, right] = aoc::day01::read_input(infile);
+    auto [left, right] = aoc::day01::read_input(input.view());
     std::ranges::sort(left);
     std::ranges::sort(right);
 
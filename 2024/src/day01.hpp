@@ -8,9 +8,10 @@
 #ifndef DAY01_HPP_PV7TQXOA
 #define DAY01_HPP_PV7TQXOA
 
-#include <iostream> // for istream
-#include <utility>  // for pair
-#include <vector>   // for vector
+#include "lib.hpp"     // for scan_int
+#include <string_view> // for string_view
+#include <utility>     // for pair
+#include <vector>      // for vector
 
 namespace aoc::day01 {
 
@@ -27,11 +28,11 @@ auto count_sorted(const std::vector<int> &vec) {
     return counts;
 }
 
-std::pair<std::vector<int>, std::vector<int>> read_input(std::istream &is) {
-    // read file line-by-line
+std::pair<std::vector<int>, std::vector<int>>
+read_input(std::string_view text) {
     std::vector<int> left, right;
     int l, r;
-    while (is >> l >> r) {
+    while (aoc::scan_int(text, l) && aoc::scan_int(text, r)) {
         left.push_back(l);
         right.push_back(r);
     }
@@ -8,14 +8,13 @@
 #include "day02.hpp"
 #include "lib.hpp"
 #include <algorithm> // for ranges::count_if
-#include <fstream>   // for ifstream
 #include <iostream>  // for cout
 // IWYU pragma: no_include <functional>  // for identity (ranges::count_if)
 
 int main(int argc, char **argv) {
-    std::ifstream infile = aoc::parse_args(argc, argv).infile;
+    const auto input = aoc::parse_args(argc, argv).map_infile();
 
-    auto reports = aoc::day02::read_input(infile);
+    auto reports = aoc::day02::read_input(input.view());
 
     // part 1
     int count = std::ranges::count_if(reports, aoc::day02::is_safe);
@@ -8,13 +8,11 @@
 #ifndef DAY02_HPP_QMMUZCBK
 #define DAY02_HPP_QMMUZCBK
 
-#include "lib.hpp"   // for read_vector
-#include <algorithm> // for copy
-#include <cstdlib>   // for abs, size_t
-#include <iostream>  // for istream
-#include <sstream>   // for istringstream
-#include <string>    // for string, getline
-#include <vector>    // for vector
+#include "lib.hpp"     // for lines, read_vector
+#include <algorithm>   // for copy
+#include <cstdlib>     // for abs, size_t
+#include <string_view> // for string_view
+#include <vector>      // for vector
 
 namespace aoc::day02 {
 
@@ -51,13 +49,11 @@ bool is_safe_with_dampener(const std::vector<int> &levels) {
     return false;
 }
 
-auto read_input(std::istream &is) {
+auto read_input(std::string_view text) {
     // read file line-by-line
-    std::string line;
     std::vector<std::vector<int>> reports;
-    while (std::getline(is, line)) {
-        std::istringstream ss(line);
-        reports.push_back(aoc::read_vector<int>(ss));
+    for (std::string_view line : aoc::lines(text)) {
+        reports.push_back(aoc::read_vector<int>(line));
     }
     return reports;
 }
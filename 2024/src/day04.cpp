@@ -7,13 +7,12 @@
 
 #include "day04.hpp"
 #include "lib.hpp"
-#include <fstream>  // for ifstream
 #include <iostream> // for cout
 
 int main(int argc, char **argv) {
-    std::ifstream infile = aoc::parse_args(argc, argv).infile;
+    const auto input = aoc::parse_args(argc, argv).map_infile();
 
-    auto grid = aoc::day04::read_input(infile);
+    auto grid = aoc::day04::read_input(input.view());
 
     int count_1 = 0, count_2 = 0;
     aoc::Pos pos(0, 0);
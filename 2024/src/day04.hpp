@@ -9,13 +9,11 @@
 #define DAY04_HPP_MZNV9FEE
 
 #include "ds/grid.hpp"      // for Grid
-#include "lib.hpp"          // for Delta, Pos, read_lines
+#include "lib.hpp"          // for Delta, Pos
 #include <array>            // for array
 #include <cstddef>          // for size_t
 #include <initializer_list> // for initializer_list
-#include <iostream>         // for istream
-#include <string>           // for string (read_lines)
-#include <vector>           // for vector (read_lines)
+#include <string_view>      // for string_view
 
 namespace aoc::day04 {
 
@@ -76,8 +74,8 @@ bool check_mas(const Grid<char> &grid, const Pos &p) {
     return found_diag && found_anti;
 }
 
-Grid<char> read_input(std::istream &is) {
-    return Grid<char>{aoc::read_lines(is)};
+Grid<char> read_input(std::string_view text) {
+    return Grid<char>::from_buffer(text);
 }
 
 } // namespace aoc::day04
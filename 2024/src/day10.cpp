@@ -7,13 +7,12 @@
 
 #include "day10.hpp"
 #include "lib.hpp"
-#include <fstream>  // for ifstream
 #include <iostream> // for cout
 
 int main(int argc, char **argv) {
-    std::ifstream infile = aoc::parse_args(argc, argv).infile;
+    const auto input = aoc::parse_args(argc, argv).map_infile();
 
-    auto island = aoc::day10::IslandMap::read(infile);
+    auto island = aoc::day10::IslandMap::read(input.view());
 
     std::cout << island.trailhead_scores<aoc::PART_1>() << "\n";
     std::cout << island.trailhead_scores<aoc::PART_2>() << "\n";
@@ -12,14 +12,12 @@
 #include "graph_traversal.hpp" // for bfs
 #include "lib.hpp"             // for Pos, as_number, DEBUG
 
-#include <algorithm> // for transform
-#include <cstddef>   // for size_t
-#include <cstdint>   // for int8_t
-#include <iostream>  // for istream, ostream, cerr
-#include <iterator>  // for back_inserter
-#include <string>    // for string, getline
-#include <utility>   // for move
-#include <vector>    // for vector
+#include <cstddef>     // for size_t
+#include <cstdint>     // for int8_t
+#include <iostream>    // for ostream, cerr
+#include <string_view> // for string_view
+#include <utility>     // for move
+#include <vector>      // for vector
 
 namespace aoc::day10 {
 
@@ -30,31 +28,24 @@ class IslandMap : public aoc::ds::Grid<height_t> {
     std::vector<Pos> trailheads{};
     std::vector<Pos> peaks{};
 
-    explicit IslandMap(std::vector<std::vector<height_t>> &&height_map);
+    explicit IslandMap(aoc::ds::Grid<height_t> &&height_map);
     void process_neighbors(const Pos &key, auto &&process) const;
     template <aoc::Part part>
     aoc::ds::Grid<int> calc_scores() const;
 
   public:
-    static IslandMap read(std::istream &is);
+    static IslandMap read(std::string_view text);
     template <aoc::Part part>
     int trailhead_scores() const;
 };
 
-IslandMap IslandMap::read(std::istream &is) {
-    std::vector<std::vector<height_t>> height_map;
-    std::string line;
-    while (std::getline(is, line)) {
-        std::vector<height_t> row;
-        std::transform(
-            line.begin(), line.end(), std::back_inserter(row),
-            [](char ch) { return ch == '.' ? IMPASSABLE : ch - '0'; });
-        height_map.push_back(std::move(row));
-    }
-    return IslandMap{std::move(height_map)};
+IslandMap IslandMap::read(std::string_view text) {
+    return IslandMap{aoc::ds::Grid<height_t>::from_buffer(text, [](char ch) {
+        return static_cast<height_t>(ch == '.' ? IMPASSABLE : ch - '0');
+    })};
 }
 
-IslandMap::IslandMap(std::vector<std::vector<height_t>> &&height_map)
+IslandMap::IslandMap(aoc::ds::Grid<height_t> &&height_map)
     : aoc::ds::Grid<height_t>(std::move(height_map)) {
     // identify trailheads and peaks
     for (std::size_t i = 0; i < m_data.size(); ++i) {
@@ -7,13 +7,12 @@
 
 #include "day12.hpp"
 #include "lib.hpp"
-#include <fstream>  // for ifstream
 #include <iostream> // for cout
 
 int main(int argc, char **argv) {
-    std::ifstream infile = aoc::parse_args(argc, argv).infile;
+    const auto input = aoc::parse_args(argc, argv).map_infile();
 
-    auto garden = aoc::day12::Garden::read(infile);
+    auto garden = aoc::day12::Garden::read(input.view());
     std::cout << garden.fence_price<aoc::PART_1>() << "\n";
     std::cout << garden.fence_price<aoc::PART_2>() << "\n";
 
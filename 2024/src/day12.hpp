@@ -10,12 +10,12 @@
 
 #include "ds/grid.hpp"         // for Grid
 #include "graph_traversal.hpp" // for bfs_manual_dedupe
-#include "lib.hpp"             // for Pos, Delta, DIRECTIONS, DEBUG, read_lines
+#include "lib.hpp"             // for Pos, Delta, DIRECTIONS, DEBUG
 #include "unit_test/pretty_print.hpp" // for repr
 #include <functional>                 // for bind_front
 #include <iomanip>                    // for setw
-#include <iostream>                   // for cerr, istream
-#include <string>                     // for string (read_lines)
+#include <iostream>                   // for cerr
+#include <string_view>                // for string_view
 #include <utility>                    // for move
 #include <vector>                     // for vector
 // IWYU pragma: no_include <initializer_list>  // for DIRECTIONS
@@ -59,13 +59,13 @@ class Garden {
     void process_plot(char plant_type, const Pos &pos);
 
   public:
-    static Garden read(std::istream &is);
+    static Garden read(std::string_view text);
     template <aoc::Part part>
     int fence_price() const;
 };
 
-Garden Garden::read(std::istream &is) {
-    Garden garden{aoc::ds::Grid<char>{aoc::read_lines(is)}};
+Garden Garden::read(std::string_view text) {
+    Garden garden{aoc::ds::Grid<char>::from_buffer(text)};
     garden.plots.for_each(std::bind_front(&Garden::process_plot, &garden));
     return garden;
 }
@@ -10,19 +10,20 @@
 #ifndef DAY16_HPP_WM3C4GBV
 #define DAY16_HPP_WM3C4GBV
 
+#include "ds/bit_grid.hpp"     // for BitGrid
+#include "ds/bucket_queue.hpp" // for bucket_queue
 #include "ds/grid.hpp"         // for Grid
-#include "graph_traversal.hpp" // for bfs
+#include "graph_traversal.hpp" // for bfs, make_pos_dir_indexer
 #include "lib.hpp" // for Pos, Delta, AbsDirection, RelDirection, DEBUG, read_lines
 #include "util/hash.hpp" // for make_hash
 
-#include <algorithm>        // for for_each, count
+#include <algorithm>        // for for_each
 #include <cassert>          // for assert
 #include <compare>          // for strong_ordering
 #include <cstddef>          // for size_t
-#include <functional>       // for greater, hash
+#include <functional>       // for hash
 #include <initializer_list> // for initializer_list
 #include <iostream>         // for istream, ostream
-#include <queue>            // for priority_queue
 #include <string>           // for string
 #include <unordered_map>    // for unordered_map
 #include <utility>          // for move, pair
@@ -119,15 +120,15 @@ std::unordered_map<Maze::Key, Maze::DijkstraBackref>
 Maze::dijkstra_multi(const Key &source) const {
     std::unordered_map<Key, DijkstraBackref> distances{};
 
-    using pq_key = std::pair<int, Key>;
-    std::priority_queue<pq_key, std::vector<pq_key>, std::greater<pq_key>>
-        frontier{};
+    // edge weights are either 1 or 1000
+    aoc::ds::bucket_queue<Key> frontier(1000);
 
     distances[source] = {0, source};
     frontier.emplace(0, source);
 
     while (!frontier.empty()) {
-        auto [dist, current] = frontier.top();
+        const int dist = frontier.top_priority();
+        const Key current = frontier.top();
         frontier.pop();
         if (dist != distances.at(current).distance) {
             continue;
@@ -135,8 +136,8 @@ Maze::dijkstra_multi(const Key &source) const {
         if (is_target(current)) {
             break;
         }
-        process_neighbors(current, [this, &distances, &frontier, dist = dist,
-                                    &current = current](const Key &neighbor) {
+        process_neighbors(current, [this, &distances, &frontier, dist,
+                                    &current](const Key &neighbor) {
             int new_distance = dist + get_distance(current, neighbor);
             auto it = distances.find(neighbor);
             if (it == distances.end() || new_distance <= it->second.distance) {
@@ -163,7 +164,7 @@ Maze::dijkstra_multi(const Key &source) const {
 
 // returns {path length, number of tiles visited} (part 1, part 2)
 std::pair<int, int> Maze::find_shortest_paths() const {
-    aoc::ds::Grid<bool> visited_tiles{grid, false};
+    aoc::ds::BitGrid visited_tiles{grid, false};
     const auto distances = dijkstra_multi(Key{start_pos, AbsDirection::east});
 
     // reconstruct all possible paths
@@ -188,11 +189,10 @@ std::pair<int, int> Maze::find_shortest_paths() const {
     }
     aoc::graph::bfs(
         end_keys, process_neighbors_back, [](const Key &) { return false; },
-        visit);
+        visit, aoc::graph::make_pos_dir_indexer(grid));
 
     // count up all the visited tiles
-    int visit_count = std::count(visited_tiles.data().begin(),
-                                 visited_tiles.data().end(), true);
+    int visit_count = visited_tiles.count();
     return {distance, visit_count};
 }
 
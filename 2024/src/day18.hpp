@@ -9,14 +9,14 @@
 #define DAY18_HPP_GLFIEBZT
 
 #include "ds/grid.hpp"
-#include "graph_traversal.hpp" // for dijkstra
-#include "lib.hpp"             // for expect_input, Pos, Delta
+#include "graph_traversal.hpp"  // for bfs_bidirectional, make_grid_indexer
+#include "incremental_path.hpp" // for IncrementalGridPath
+#include "lib.hpp"              // for expect_input, Pos, Delta
 #include <functional>          // for hash (unordered_set)
 #include <iostream>            // for istream
 #include <unordered_set>       // for unordered_set
 #include <utility>             // for pair (unordered_set)
 #include <vector>              // for vector
-// IWYU pragma: no_include <unordered_map>  // for dijkstra in debug mode
 
 namespace aoc::day18 {
 
@@ -29,35 +29,35 @@ std::unordered_set<Pos> shortest_path(const aoc::ds::Grid<bool> &grid) {
         });
     };
 
-    const auto is_target = [](const Pos &pos) {
-        return pos.x == 0 && pos.y == 0;
-    };
-
-    const auto get_distance = [](const Pos &, const Pos &) { return 1; };
-
-    auto path =
-        aoc::graph::dijkstra(Pos{grid.width - 1, grid.height - 1},
-                             process_neighbors, get_distance, is_target, {})
-            .second;
+    // the grid is undirected, so the same neighbors work in both directions
+    auto path = aoc::graph::bfs_bidirectional(
+                    Pos{grid.width - 1, grid.height - 1}, Pos{0, 0},
+                    process_neighbors, process_neighbors,
+                    aoc::graph::make_grid_indexer(grid))
+                    .second;
 
     return std::unordered_set<Pos>(path.begin(), path.end());
 }
 
-Pos find_cutoff_pos(aoc::ds::Grid<bool> &grid, auto begin, auto end) {
-    std::unordered_set<Pos> path = shortest_path(grid);
+Pos find_cutoff_pos(const aoc::ds::Grid<bool> &grid, auto begin, auto end) {
+    aoc::graph::IncrementalGridPath engine(grid, Pos{0, 0},
+                                           Pos{grid.width - 1, grid.height - 1});
+    std::vector<Pos> path = engine.path();
+    std::unordered_set<Pos> on_path(path.begin(), path.end());
 
     for (auto it = begin; it != end; ++it) {
-        if (!grid[*it]) {
+        if (!engine.is_open(*it)) {
             continue;
         }
-        grid[*it] = false;
-        if (path.contains(*it)) {
-            // this byte blocked the current shortest path, so recalculate it
-            path = shortest_path(grid);
+        engine.block(*it);
+        if (on_path.contains(*it)) {
+            // this byte blocked the current shortest path, so repair it
+            path = engine.path();
             if (path.empty()) {
                 // this position cut off the path to the exit
                 return *it;
             }
+            on_path = std::unordered_set<Pos>(path.begin(), path.end());
         }
     }
     return {-1, -1};
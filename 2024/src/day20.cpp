@@ -7,7 +7,6 @@
 
 #include "day20.hpp"
 #include "lib.hpp"
-#include <fstream>  // for ifstream
 #include <iostream> // for cout, cerr
 
 int main(int argc, char **argv) {
@@ -19,7 +18,8 @@ int main(int argc, char **argv) {
         threshold = 100;
     }
 
-    auto track = aoc::day20::Racetrack::read(args.infile);
+    const auto input = args.map_infile();
+    auto track = aoc::day20::Racetrack::read(input.view());
 
     auto [part_1, part_2] = track.count_cheats(2, 20, threshold);
     std::cout << part_1 << "\n" << part_2 << "\n";
@@ -9,14 +9,15 @@
 #define DAY20_HPP_1NZBO0H2
 
 #include "ds/grid.hpp"      // for Grid
-#include "lib.hpp"          // for Pos, Delta, read_lines, DIRECTIONS, DEBUG
+#include "lib.hpp"          // for Pos, Delta, DIRECTIONS, DEBUG
 #include <algorithm>        // for sort
 #include <cassert>          // for assert
 #include <compare>          // for strong_ordering
-#include <cstddef>          // for size_t
+#include <cstdlib>          // for abs
 #include <initializer_list> // for initializer_list (DIRECTIONS)
-#include <iostream>         // for istream, ostream, cerr
-#include <string>           // for string (read_lines)
+#include <iostream>         // for ostream, cerr
+#include <span>             // for span
+#include <string_view>      // for string_view
 #include <utility>          // for pair
 #include <vector>           // for vector
 
@@ -40,9 +41,14 @@ std::ostream &operator<<(std::ostream &os, const Cheat &cheat) {
 
 class Racetrack {
     std::vector<std::pair<Pos, int>> race_path{};
+    // distance along the race path for each tile, or -1 for walls
+    aoc::ds::Grid<int> path_distances;
     Pos start_pos{-1, -1};
     Pos end_pos{-1, -1};
 
+    explicit Racetrack(const aoc::ds::Grid<char> &grid)
+        : path_distances(grid, -1) {}
+
     void trace_path(aoc::ds::Grid<char> &grid);
 
   public:
@@ -50,7 +56,7 @@ class Racetrack {
                                      int cheat_time_limit_2,
                                      int threshold) const;
 
-    static Racetrack read(std::istream &is);
+    static Racetrack read(std::string_view text);
 };
 
 std::pair<int, int> Racetrack::count_cheats(int cheat_time_limit_1,
@@ -65,45 +71,38 @@ std::pair<int, int> Racetrack::count_cheats(int cheat_time_limit_1,
     std::vector<Cheat> part_2_cheats;
 
     int count_1 = 0, count_2 = 0;
-    // check each pair of tiles on the path and see if cheating between them
-    // saves more than the threshold
-    for (std::size_t i = 0; i < race_path.size(); ++i) {
-        const auto &[start, start_dist] = race_path[i];
-        // in order to save more than the threshold, we have to go at least
-        // this far along the race path (see input/day20/example2.txt)
-        for (std::size_t j = i + threshold + cheat_time_limit_1;
-             j < race_path.size(); ++j) {
-            const auto &[end, end_dist] = race_path[j];
-            // distance from cheat end point to the race end point is
-            // (best_uncheated - end_dist)
-            int path_length = (start - end).manhattan_distance();
-            if (path_length - cheat_time_limit_2 > 0) {
-                // We can't reach the cheat end point within the time limit,
-                // and it would have to move directly toward the cheat start
-                // point by (path_length - cheat_time_limit_2) tiles in order
-                // to be within range for part 2, so we can safely skip that
-                // far forward in the race path (minus 1 to account for the ++j
-                // from the for loop).
-                j += path_length - cheat_time_limit_2 - 1;
-                continue;
-            }
-            // this is equivalent to start_dist + path_length + (best_uncheated
-            // - end_dist) < best_uncheated - threshold
-            if (end_dist - start_dist - path_length >= threshold) {
-                if constexpr (aoc::DEBUG) {
-                    part_2_cheats.push_back(
-                        {end_dist - start_dist - path_length, start, end,
-                         path_length});
-                }
-                if (path_length <= cheat_time_limit_1) {
-                    ++count_1;
+    // check every tile within the time limit of each tile on the path, and see
+    // if cheating between them saves at least the threshold
+    for (const auto &[start, start_dist] : race_path) {
+        // distance from cheat end point to the race end point is
+        // (best_uncheated - end_dist), so this is equivalent to
+        // start_dist + length + (best_uncheated - end_dist) <=
+        // best_uncheated - threshold
+        const int min_end_dist = start_dist + threshold;
+        path_distances.manhattan_rows(
+            start, cheat_time_limit_2,
+            [&](const Pos &row_start, std::span<const int> end_dists) {
+                const int dy = std::abs(row_start.y - start.y);
+                const int x_offset = row_start.x - start.x;
+                // walls have a distance of -1, so they never save any time
+                for (int i = 0; i < static_cast<int>(end_dists.size()); ++i) {
+                    const int length = dy + std::abs(x_offset + i);
+                    const bool saves = end_dists[i] - length >= min_end_dist;
+                    count_1 += saves & (length <= cheat_time_limit_1);
+                    count_2 += saves;
                     if constexpr (aoc::DEBUG) {
-                        part_1_cheats.push_back(part_2_cheats.back());
+                        if (saves) {
+                            const Pos end(row_start.x + i, row_start.y);
+                            part_2_cheats.push_back(
+                                {end_dists[i] - start_dist - length, start,
+                                 end, length});
+                            if (length <= cheat_time_limit_1) {
+                                part_1_cheats.push_back(part_2_cheats.back());
+                            }
+                        }
                     }
                 }
-                ++count_2;
-            }
-        }
+            });
     }
     if constexpr (aoc::DEBUG) {
         std::sort(part_1_cheats.begin(), part_1_cheats.end());
@@ -124,10 +123,10 @@ std::pair<int, int> Racetrack::count_cheats(int cheat_time_limit_1,
     return {count_1, count_2};
 }
 
-Racetrack Racetrack::read(std::istream &is) {
-    aoc::ds::Grid<char> grid(aoc::read_lines(is));
+Racetrack Racetrack::read(std::string_view text) {
+    auto grid = aoc::ds::Grid<char>::from_buffer(text);
 
-    Racetrack track{};
+    Racetrack track(grid);
     grid.for_each([&track](char value, const Pos &pos) {
         if (value == 'S') {
             track.start_pos = pos;
@@ -148,6 +147,7 @@ void Racetrack::trace_path(aoc::ds::Grid<char> &grid) {
     int source_distance = 0;
     while (true) {
         race_path.emplace_back(pos, source_distance);
+        path_distances[pos] = source_distance;
         ++source_distance;
         if (pos == end_pos) {
             break;
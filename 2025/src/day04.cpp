@@ -7,23 +7,19 @@
 
 #include "day04.hpp"
 #include "lib.hpp"
-#include <fstream>  // for ifstream
 #include <iostream> // for cout
 
 int main(int argc, char **argv) {
-    std::ifstream infile = aoc::parse_args(argc, argv).infile;
+    const auto input = aoc::parse_args(argc, argv).map_infile();
 
-    auto grid = aoc::day04::read_input(infile);
+    auto grid = aoc::day04::read_input(input.view());
 
-    int part1 = aoc::day04::count_forklift_accessible<aoc::PART_1>(grid);
+    const auto block_counts = aoc::day04::count_blocks(grid);
+
+    int part1 = aoc::day04::count_forklift_accessible(grid, block_counts);
     std::cout << part1 << "\n";
 
-    int part2 = 0;
-    int removed;
-    do {
-        removed = aoc::day04::count_forklift_accessible<aoc::PART_2>(grid);
-        part2 += removed;
-    } while (removed > 0);
+    int part2 = aoc::day04::remove_forklift_accessible(grid, block_counts);
     std::cout << part2 << "\n";
 
     return 0;
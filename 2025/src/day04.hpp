@@ -9,41 +9,74 @@
 #define DAY04_HPP_3PKMNXVL
 
 #include "ds/grid.hpp" // for Grid
-#include "lib.hpp"     // for Delta, Pos
-#include <iostream>    // for istream
-#include <string>      // for string, getline
+#include "lib.hpp"     // for Pos
+#include <cstddef>     // for size_t
+#include <string_view> // for string_view
 #include <vector>      // for vector
 
 namespace aoc::day04 {
 
 using aoc::ds::Grid;
 
-template <aoc::Part PART>
-int count_forklift_accessible(Grid<char> &grid) {
+constexpr bool is_roll(char c) { return c == '@'; }
+
+/// a roll is accessible if fewer than 4 of its 8 neighbors are rolls
+constexpr bool is_accessible(char c, int block_count) {
+    // block_count includes the center roll
+    return is_roll(c) && block_count < 5;
+}
+
+/// Returns the number of rolls in the 3x3 block around each position.
+Grid<int> count_blocks(const Grid<char> &grid) {
+    return grid.chebyshev_counts(is_roll);
+}
+
+int count_forklift_accessible(const Grid<char> &grid,
+                              const Grid<int> &block_counts) {
     int count = 0;
-    grid.for_each([&count, &grid](char &c, const Pos &center) {
-        if (c != '@') {
-            return;
-        }
-        int adj_count = 0;
-        grid.chebyshev_kernel(center, [&adj_count](char adj) {
-            if (adj == '@') {
-                ++adj_count;
-            }
-        });
-        // the 4 in the question doesn't include the center roll
-        if (adj_count < 5) {
-            ++count;
-            if constexpr (PART == aoc::PART_2) {
-                c = '.';
-            }
-        }
+    grid.for_each([&count, &block_counts](char c, const Pos &pos) {
+        count += is_accessible(c, block_counts[pos]);
     });
     return count;
 }
 
-Grid<char> read_input(std::istream &is) {
-    return Grid<char>{aoc::read_lines(is)};
+/**
+ * Repeatedly removes accessible rolls until none are left, and returns the
+ * total number removed.
+ *
+ * Removing a roll can only make its neighbors more accessible, so rather than
+ * rescanning the whole grid after each round, this keeps the block counts up
+ * to date and only rechecks the neighbors of removed rolls.
+ */
+int remove_forklift_accessible(Grid<char> &grid, Grid<int> block_counts) {
+    std::vector<Pos> queue;
+    grid.for_each([&queue, &block_counts](char c, const Pos &pos) {
+        if (is_accessible(c, block_counts[pos])) {
+            queue.push_back(pos);
+        }
+    });
+    // rolls are marked as removed as soon as they're queued
+    for (const Pos &pos : queue) {
+        grid[pos] = '.';
+    }
+    for (std::size_t i = 0; i < queue.size(); ++i) {
+        // copy, since the queue may be reallocated inside the kernel
+        const Pos center = queue[i];
+        grid.chebyshev_kernel(
+            center, [&grid, &block_counts, &queue](char c, const Pos &pos) {
+                int &count = block_counts[pos];
+                --count;
+                if (is_accessible(c, count)) {
+                    grid[pos] = '.';
+                    queue.push_back(pos);
+                }
+            });
+    }
+    return queue.size();
+}
+
+Grid<char> read_input(std::string_view text) {
+    return Grid<char>::from_buffer(text);
 }
 
 } // namespace aoc::day04
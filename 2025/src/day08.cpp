@@ -8,70 +8,45 @@
 #include "day08.hpp"
 #include "ds/bounded_heap.hpp"
 #include "ds/disjoint_set.hpp"
+#include "ds/kd_tree.hpp"
 #include "lib.hpp"
 #include <cassert>    // for assert
 #include <cmath>      // for sqrt
 #include <cstddef>    // for size_t
-#include <fstream>    // for ifstream
 #include <functional> // for multiplies, greater
 #include <iostream>   // for cout, cerr
-#include <map>        // for map
 #include <numeric>    // for reduce
-#include <queue>      // for priority_queue
-#include <set>        // for set
 #include <vector>     // for vector
 
 int main(int argc, char **argv) {
     auto args = aoc::parse_args(argc, argv);
     using namespace aoc::day08;
     using Pos3 = aoc::Pos3;
-    std::vector<Pos3> coords = read_input(args.infile);
+    const auto input = args.map_infile();
+    std::vector<Pos3> coords = read_input(input.view());
 
-    aoc::ds::disjoint_set dset;
-    std::map<Pos3, aoc::ds::disjoint_set::node_t *> ds_nodes{};
-
-    std::priority_queue<JunctionBoxPair, std::vector<JunctionBoxPair>,
-                        std::greater<JunctionBoxPair>>
-        pqueue;
-    for (std::size_t i = 0; i < coords.size(); ++i) {
-        auto ds_node = dset.new_set();
-        ds_nodes[coords[i]] = ds_node;
-        // avoid duplicates by starting at i+1
-        for (std::size_t j = i + 1; j < coords.size(); ++j) {
-            pqueue.push({coords[i], coords[j]});
-        }
-    }
+    aoc::ds::disjoint_set dset(coords.size());
+    aoc::ds::closest_pairs<int> pairs(coords);
 
     const int part_1_count =
         args.input_type == aoc::InputType::EXAMPLE ? 10 : 1000;
 
     // use disjoint-set
-    std::set<aoc::ds::disjoint_set::id_t> merged_ids{};
     for (int i = 0; i < part_1_count; ++i) {
-        const JunctionBoxPair &jbp = pqueue.top();
-        assert(jbp.dist_sq > 0);
+        const auto [dist_sq, id1, id2] = pairs.next().value();
+        assert(dist_sq > 0);
         if constexpr (aoc::DEBUG) {
-            std::cerr << std::sqrt(jbp.dist_sq) << ": " << jbp.box1 << " - "
-                      << jbp.box2 << "\n";
+            std::cerr << std::sqrt(dist_sq) << ": " << coords[id1] << " - "
+                      << coords[id2] << "\n";
         }
-        auto node = ds_nodes.at(jbp.box1);
-        if (dset.merge(node, ds_nodes.at(jbp.box2))) {
-            merged_ids.insert(node->parent->id);
-        }
-        pqueue.pop();
-    }
-    // deduplicate based on root
-    std::map<aoc::ds::disjoint_set::id_t, std::size_t> component_sizes{};
-    for (const auto &pos : coords) {
-        const auto *root = dset.find(ds_nodes.at(pos));
-        component_sizes[root->id] = root->size;
+        dset.merge(id1, id2);
     }
 
     // method from https://stackoverflow.com/a/2935995
     aoc::ds::bounded_heap<std::size_t, std::vector<std::size_t>,
                           std::greater<std::size_t>>
         largest_component_sizes(3);
-    for (const auto &[_, size] : component_sizes) {
+    for (const auto &[_, size] : dset.components()) {
         largest_component_sizes.push(size);
     }
     if constexpr (aoc::DEBUG) {
@@ -94,8 +69,8 @@ int main(int argc, char **argv) {
     long part2 = 0;
     std::size_t prev_count = dset.set_count();
     while (dset.set_count() > 1) {
-        const JunctionBoxPair &jbp = pqueue.top();
-        dset.merge(ds_nodes.at(jbp.box1), ds_nodes.at(jbp.box2));
+        const auto [dist_sq, id1, id2] = pairs.next().value();
+        dset.merge(id1, id2);
         std::size_t new_count = dset.set_count();
         if constexpr (aoc::DEBUG) {
             if (prev_count != new_count) {
@@ -107,9 +82,8 @@ int main(int argc, char **argv) {
             (void)prev_count;
         }
         if (new_count == 1) {
-            part2 = static_cast<long>(jbp.box1.x) * jbp.box2.x;
+            part2 = static_cast<long>(coords[id1].x) * coords[id2].x;
         }
-        pqueue.pop();
     }
     std::cout << part2 << "\n";
 
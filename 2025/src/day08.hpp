@@ -8,43 +8,23 @@
 #ifndef DAY08_HPP_M9FF4PKX
 #define DAY08_HPP_M9FF4PKX
 
-#include "lib.hpp"  // for Delta3, Pos3, expect_input, read_vector
-#include <compare>  // for weak_ordering
-#include <iostream> // for istream
-#include <utility>  // for move
-
-namespace aoc {
-
-std::istream &operator>>(std::istream &is, Pos3 &pos) {
-    Pos3 tmp;
-    is >> tmp.x >> aoc::expect_input(',') >> tmp.y >> aoc::expect_input(',') >>
-        tmp.z;
-    if (is) {
-        pos = std::move(tmp);
-    }
-    return is;
-}
-
-} // namespace aoc
+#include "lib.hpp"     // for Pos3, lines, parse_csv_ints
+#include <string_view> // for string_view
+#include <vector>      // for vector
 
 namespace aoc::day08 {
 
-struct JunctionBoxPair {
-    Pos3 box1;
-    Pos3 box2;
-    long dist_sq;
-
-    JunctionBoxPair(const Pos3 &box1, const Pos3 &box2)
-        : box1(box1), box2(box2) {
-        dist_sq = (box1 - box2).euclidean_distance_sq();
-    }
-
-    std::weak_ordering operator<=>(const JunctionBoxPair &other) const {
-        return dist_sq <=> other.dist_sq;
+std::vector<Pos3> read_input(std::string_view text) {
+    std::vector<Pos3> coords;
+    for (std::string_view line : aoc::lines(text)) {
+        auto values = aoc::parse_csv_ints<int>(line);
+        if (values.size() != 3) {
+            break;
+        }
+        coords.emplace_back(values[0], values[1], values[2]);
     }
-};
-
-auto read_input(std::istream &is) { return aoc::read_vector<Pos3>(is); }
+    return coords;
+}
 
 } // namespace aoc::day08
 
@@ -9,11 +9,12 @@
 #define DAY09_HPP_MBAPIACN
 
 #include "ds/grid.hpp"         // for Grid
-#include "graph_traversal.hpp" // for bfs
+#include "graph_traversal.hpp" // for bfs_parallel, make_grid_indexer
 #include "lib.hpp" // for Pos, Delta, relative_to, expect_input, read_vector, AbsDirection, RelDirection, DEBUG
 
 #include <cassert>  // for assert
 #include <cstdlib>  // for abs, size_t
+#include <initializer_list> // for initializer_list
 #include <iostream> // for ostream, cerr, istream, boolalpha
 #include <iterator> // for distance
 #include <set>      // for set
@@ -148,12 +149,14 @@ long solve_part_2(const std::vector<Pos> &points, const std::set<int> &x_set,
                 }
             });
         };
-        const auto visit = [&](const Pos &p, int /*distance*/) {
-            grid[p].inside = true;
-        };
-        // cppcheck-suppress unreadVariable
-        constexpr bool use_seen = false;
-        aoc::graph::bfs<use_seen>(inside, process_neighbors, {}, visit);
+        const auto indexer = aoc::graph::make_grid_indexer(grid);
+        const std::vector<int> distances = aoc::graph::bfs_parallel(
+            std::initializer_list<Pos>{inside}, process_neighbors, indexer);
+        grid.for_each([&](Tile &tile, const Pos &p) {
+            if (distances[indexer(p)] >= 0) {
+                tile.inside = true;
+            }
+        });
 
         if constexpr (aoc::DEBUG) {
             std::cerr << "right turns: " << right_turn_count << "\n";
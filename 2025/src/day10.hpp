@@ -11,6 +11,7 @@
 #include "ds/grid.hpp"         // for Grid
 #include "gauss_elim.hpp"      // for RowPermuter, gauss_jordan
 #include "graph_traversal.hpp" // for bfs
+#include "ilp.hpp"             // for ilp_min_sum
 #include "lib.hpp"             // for read_vector, expect_input, csv_formatter
 #ifdef DEBUG_MODE
 #include "unit_test/pretty_print.hpp"
@@ -106,6 +107,11 @@ int Machine::min_presses<aoc::PART_1>() const {
                            BfsEntry::is_target, {});
 }
 
+/**
+ * Reference solver for part 2, which brute-forces every free variable after
+ * Gauss-Jordan elimination (exponential in the number of free variables).
+ * Kept for cross-checking aoc::math::ilp_min_sum in test10.
+ */
 struct Part2Solver {
     const Machine &machine;
     aoc::ds::Grid<int> mtx;
@@ -149,11 +155,23 @@ int Machine::min_presses<aoc::PART_2>() const {
     if constexpr (aoc::DEBUG) {
         std::cerr << machine << "\n";
     }
-    auto result = Part2Solver(machine).min_presses();
+    aoc::ds::Grid<int> mtx(machine.buttons.size(),
+                           machine.joltage_requirements.size(), 0);
+    for (std::size_t x = 0; x < machine.buttons.size(); ++x) {
+        for (int y : machine.buttons[x].light_indices) {
+            mtx.at(x, y) = 1;
+        }
+    }
+    const std::vector<int> rhs(machine.joltage_requirements.begin(),
+                               machine.joltage_requirements.end());
+    aoc::math::ilp_stats stats;
+    auto result = aoc::math::ilp_min_sum(mtx, rhs, &stats);
+    assert(result.has_value());
     if constexpr (aoc::DEBUG) {
-        std::cerr << "result: " << result << " presses\n";
+        std::cerr << "result: " << *result << " presses (" << stats.nodes
+                  << " nodes, " << stats.pivots << " pivots)\n";
     }
-    return result;
+    return *result;
 }
 
 void Part2Solver::reduce_matrix() {
@@ -8,6 +8,7 @@
 #include "day10.hpp" // IWYU pragma: associated
 #include <cstdlib>   // for EXIT_FAILURE, EXIT_SUCCESS
 #include <fstream>   // for ifstream
+#include <iostream>  // for cout, cerr
 
 #include <version> // IWYU pragma: keep // for _LIBCPP_VERSION
 #ifndef _LIBCPP_VERSION
@@ -49,7 +50,14 @@ int main() {
             return EXIT_FAILURE;
         }
 #endif
-        std::cout << machine.min_presses<aoc::PART_2>() << "\n";
+        const int presses = machine.min_presses<aoc::PART_2>();
+        const int brute_force_presses = Part2Solver(machine).min_presses();
+        if (presses != brute_force_presses) {
+            std::cerr << "line " << line << ": ilp_min_sum gave " << presses
+                      << ", brute force gave " << brute_force_presses << "\n";
+            return EXIT_FAILURE;
+        }
+        std::cout << presses << "\n";
         ++line;
         if (line > 10) {
             break;
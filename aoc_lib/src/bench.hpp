@@ -0,0 +1,342 @@
+/******************************************************************************
+ * File:        bench.hpp
+ *
+ * Author:      Eric T. Johnson (yut23)
+ * Created:     2026-10-17
+ * Description: In-process benchmarking of the stages of a solution.
+ *****************************************************************************/
+
+#ifndef BENCH_HPP_8RZQ1MXC
+#define BENCH_HPP_8RZQ1MXC
+
+#include "perf.hpp"    // for report
+#include <algorithm>   // for max, min, min_element, max_element, sort
+#include <chrono>      // for steady_clock, duration
+#include <cmath>       // for sqrt
+#include <concepts>    // for invocable
+#include <cstddef>     // for size_t
+#include <cstdlib>     // for getenv, strtol, strtod
+#include <fstream>     // for ofstream
+#include <iomanip>     // for setprecision, setw, fixed
+#include <iostream>    // for cerr, ostream
+#include <limits>      // for numeric_limits
+#include <numeric>     // for accumulate
+#include <optional>    // for optional
+#include <sstream>     // for ostringstream
+#include <string>      // for string
+#include <string_view> // for string_view
+#include <type_traits> // for invoke_result_t, is_void_v, remove_cvref_t
+#include <utility>     // for move, make_pair, in_place
+#include <vector>      // for vector
+
+namespace aoc::bench {
+
+/**
+ * Keeps the compiler from optimizing away the computation of `value`.
+ */
+template <class T>
+inline void do_not_optimize(const T &value) {
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+/**
+ * Runs `func` `repeats` times, and returns the fastest time in ms. This is for
+ * the standalone micro-benchmarks (bench_*.cpp) rather than solution stages.
+ */
+template <std::invocable Func>
+double best_time(int repeats, Func &&func) {
+    double best = std::numeric_limits<double>::infinity();
+    for (int i = 0; i < repeats; ++i) {
+        const auto start = std::chrono::steady_clock::now();
+        const auto result = func();
+        const std::chrono::duration<double, std::milli> elapsed =
+            std::chrono::steady_clock::now() - start;
+        do_not_optimize(result);
+        best = std::min(best, elapsed.count());
+    }
+    return best;
+}
+
+/**
+ * Benchmark settings. By default these are read from the environment:
+ *
+ *   AOC_BENCH=1            enable benchmarking
+ *   AOC_BENCH_JSON=<path>  write the results to a JSON file (implies
+ *                          AOC_BENCH=1)
+ *   AOC_BENCH_WARMUP=<n>   untimed runs of each stage first (default 1)
+ *   AOC_BENCH_RUNS=<n>     exact number of timed runs of each stage
+ *   AOC_BENCH_TIME=<sec>   otherwise, time each stage for at least this long
+ *                          (default 0.5), with between 5 and 1000 runs
+ */
+struct Options {
+    bool enabled = false;
+    std::string json_path{};
+    int warmup = 1;
+    int min_runs = 5;
+    int max_runs = 1000;
+    double min_time = 0.5;
+
+    static Options from_env() {
+        Options options;
+        const auto get = [](const char *name) -> std::string_view {
+            const char *value = std::getenv(name);
+            return value == nullptr ? "" : value;
+        };
+        const std::string_view enabled = get("AOC_BENCH");
+        options.json_path = get("AOC_BENCH_JSON");
+        options.enabled = (!enabled.empty() && enabled != "0") ||
+                          !options.json_path.empty();
+        if (const auto warmup = get("AOC_BENCH_WARMUP"); !warmup.empty()) {
+            options.warmup = std::strtol(warmup.data(), nullptr, 10);
+        }
+        if (const auto runs = get("AOC_BENCH_RUNS"); !runs.empty()) {
+            options.min_runs = options.max_runs =
+                std::max(1L, std::strtol(runs.data(), nullptr, 10));
+        }
+        if (const auto time = get("AOC_BENCH_TIME"); !time.empty()) {
+            options.min_time = std::strtod(time.data(), nullptr);
+        }
+        return options;
+    }
+};
+
+/// Timings for a single stage, in seconds.
+struct StageResult {
+    std::string name;
+    std::vector<double> times{};
+
+    double total() const {
+        return std::accumulate(times.begin(), times.end(), 0.0);
+    }
+    double mean() const { return total() / times.size(); }
+    double stddev() const {
+        if (times.size() < 2) {
+            return 0.0;
+        }
+        const double m = mean();
+        double sum_sq = 0.0;
+        for (double t : times) {
+            sum_sq += (t - m) * (t - m);
+        }
+        return std::sqrt(sum_sq / (times.size() - 1));
+    }
+    double median() const {
+        std::vector<double> sorted = times;
+        std::sort(sorted.begin(), sorted.end());
+        const std::size_t n = sorted.size();
+        return n % 2 == 1 ? sorted[n / 2]
+                          : (sorted[n / 2 - 1] + sorted[n / 2]) / 2;
+    }
+    double min() const { return *std::min_element(times.begin(), times.end()); }
+    double max() const { return *std::max_element(times.begin(), times.end()); }
+};
+
+/**
+ * Times the stages of a solution (usually parse, part1 and part2) inside the
+ * process, so the numbers don't include process startup or reading the input
+ * file.
+ *
+ * When benchmarking is disabled (the default), each stage just runs once.
+ * Otherwise, each stage runs a few times untimed, then repeatedly while being
+ * timed, and the result of the last run is returned. A summary is printed to
+ * stderr when the Benchmark is destroyed, and optionally written as JSON.
+ * In FAST_MODE builds, this is followed by the counters for any aoc::perf
+ * regions (see perf.hpp).
+ *
+ * Since stages may run more than once, they must not modify their inputs.
+ * Solutions that work in place should use the overload that takes a setup
+ * function, which makes a fresh (untimed) copy for every run.
+ */
+class Benchmark {
+    using clock = std::chrono::steady_clock;
+
+    std::string m_label;
+    Options m_options;
+    std::vector<StageResult> m_stages{};
+
+    bool keep_running(const StageResult &stage) const {
+        const int runs = stage.times.size();
+        if (runs < m_options.min_runs) {
+            return true;
+        }
+        return runs < m_options.max_runs && stage.total() < m_options.min_time;
+    }
+
+    template <class Setup, class Func>
+    auto run_stage(std::string_view name, Setup &setup, Func &func) {
+        using Arg = std::invoke_result_t<Setup &>;
+        using R = std::remove_cvref_t<std::invoke_result_t<Func &, Arg &>>;
+        StageResult &stage = m_stages.emplace_back(std::string(name));
+
+        // returns the result of func, and how long it took
+        const auto timed_run = [&setup, &func]() {
+            Arg arg = setup();
+            const auto start = clock::now();
+            if constexpr (std::is_void_v<R>) {
+                func(arg);
+                return std::chrono::duration<double>(clock::now() - start)
+                    .count();
+            } else {
+                std::optional<R> result(std::in_place, func(arg));
+                std::chrono::duration<double> elapsed = clock::now() - start;
+                do_not_optimize(*result);
+                return std::make_pair(std::move(result), elapsed.count());
+            }
+        };
+
+        for (int i = 0; i < m_options.warmup; ++i) {
+            timed_run();
+        }
+        if constexpr (std::is_void_v<R>) {
+            do {
+                stage.times.push_back(timed_run());
+            } while (keep_running(stage));
+        } else {
+            std::optional<R> result;
+            do {
+                auto [run_result, elapsed] = timed_run();
+                stage.times.push_back(elapsed);
+                // emplace rather than assign, since results (like Grids) may
+                // not be assignable
+                result.reset();
+                result.emplace(std::move(*run_result));
+            } while (keep_running(stage));
+            return std::move(*result);
+        }
+    }
+
+  public:
+    explicit Benchmark(std::string label,
+                       Options options = Options::from_env())
+        : m_label(std::move(label)), m_options(std::move(options)) {}
+
+    Benchmark(const Benchmark &) = delete;
+    Benchmark &operator=(const Benchmark &) = delete;
+
+    ~Benchmark() {
+        if (!m_options.enabled || m_stages.empty()) {
+            return;
+        }
+        print_summary(std::cerr);
+        // counters from aoc::perf regions, if enabled (summed over every run)
+        perf::report(std::cerr);
+        if (!m_options.json_path.empty()) {
+            std::ofstream out(m_options.json_path);
+            write_json(out);
+        }
+    }
+
+    bool enabled() const { return m_options.enabled; }
+    const std::vector<StageResult> &results() const { return m_stages; }
+
+    /**
+     * Runs func() as a stage named `name`, and returns its result.
+     */
+    template <std::invocable Func>
+    std::remove_cvref_t<std::invoke_result_t<Func &>>
+    stage(std::string_view name, Func &&func) {
+        if (!enabled()) {
+            return func();
+        }
+        struct Empty {};
+        auto setup = []() { return Empty{}; };
+        auto wrapper = [&func](Empty &) -> std::invoke_result_t<Func &> {
+            return func();
+        };
+        return run_stage(name, setup, wrapper);
+    }
+
+    /**
+     * Runs func(setup()) as a stage named `name`, and returns its result.
+     * Only the call to func is timed.
+     */
+    template <std::invocable Setup, class Func>
+        requires std::invocable<Func &, std::invoke_result_t<Setup &> &>
+    std::remove_cvref_t<
+        std::invoke_result_t<Func &, std::invoke_result_t<Setup &> &>>
+    stage(std::string_view name, Setup &&setup, Func &&func) {
+        if (!enabled()) {
+            auto arg = setup();
+            return func(arg);
+        }
+        return run_stage(name, setup, func);
+    }
+
+    /// Formats a time in seconds with a suitable unit.
+    static std::string format_time(double seconds) {
+        const char *unit = "s";
+        if (seconds < 1e-6) {
+            seconds *= 1e9;
+            unit = "ns";
+        } else if (seconds < 1e-3) {
+            seconds *= 1e6;
+            unit = "us";
+        } else if (seconds < 1) {
+            seconds *= 1e3;
+            unit = "ms";
+        }
+        std::ostringstream ss;
+        ss << std::fixed << std::setprecision(seconds < 100 ? 2 : 1) << seconds
+           << " " << unit;
+        return ss.str();
+    }
+
+    void print_summary(std::ostream &os) const {
+        const auto old_flags = os.flags();
+        os << "benchmark: " << m_label << "\n";
+        double total = 0;
+        for (const StageResult &stage : m_stages) {
+            os << "  " << std::left << std::setw(8) << stage.name << std::right
+               << std::setw(11) << format_time(stage.mean()) << " ± "
+               << std::setw(10) << format_time(stage.stddev()) << "  (min "
+               << format_time(stage.min()) << ", " << stage.times.size()
+               << " runs)\n";
+            total += stage.mean();
+        }
+        os << "  " << std::left << std::setw(8) << "total" << std::right
+           << std::setw(11) << format_time(total) << "\n";
+        os.flags(old_flags);
+    }
+
+    /**
+     * Writes the results as JSON, with times in seconds (like hyperfine).
+     */
+    void write_json(std::ostream &os) const {
+        const auto quote = [](std::string_view str) {
+            std::string result = "\"";
+            for (char ch : str) {
+                if (ch == '"' || ch == '\\') {
+                    result += '\\';
+                }
+                result += ch;
+            }
+            return result + "\"";
+        };
+        const auto old_precision = os.precision();
+        os << std::setprecision(9);
+        os << "{\n  \"label\": " << quote(m_label)
+           << ",\n  \"warmup\": " << m_options.warmup
+           << ",\n  \"stages\": [";
+        for (bool first = true; const StageResult &stage : m_stages) {
+            os << (first ? "\n" : ",\n");
+            first = false;
+            os << "    {\"name\": " << quote(stage.name)
+               << ", \"runs\": " << stage.times.size()
+               << ", \"mean\": " << stage.mean()
+               << ", \"stddev\": " << stage.stddev()
+               << ", \"median\": " << stage.median()
+               << ", \"min\": " << stage.min() << ", \"max\": " << stage.max()
+               << ",\n     \"times\": [";
+            for (std::size_t i = 0; i < stage.times.size(); ++i) {
+                os << (i == 0 ? "" : ", ") << stage.times[i];
+            }
+            os << "]}";
+        }
+        os << "\n  ]\n}\n";
+        os.precision(old_precision);
+    }
+};
+
+} // namespace aoc::bench
+
+#endif /* end of include guard: BENCH_HPP_8RZQ1MXC */
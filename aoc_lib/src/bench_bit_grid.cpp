@@ -0,0 +1,73 @@
+/******************************************************************************
+ * File:        bench_bit_grid.cpp
+ *
+ * Author:      Eric T. Johnson (yut23)
+ * Created:     2026-10-16
+ * Description: Benchmark for counting and flood-fill steps on a packed
+ *              BitGrid, compared to a byte-per-cell Grid<bool>.
+ *****************************************************************************/
+
+#include "bench.hpp"       // for best_time
+#include "ds/bit_grid.hpp" // for BitGrid
+#include "ds/grid.hpp"     // for Grid
+#include "lib.hpp"         // for Pos
+
+#include <algorithm> // for count
+#include <cstddef>   // for size_t
+#include <iostream>  // for cout
+#include <random>    // for mt19937, bernoulli_distribution
+
+namespace aoc::ds::bench {
+
+using aoc::bench::best_time;
+
+constexpr int SIZE = 2000;
+constexpr int REPEATS = 20;
+
+void run() {
+    std::mt19937 gen(SIZE);
+    std::bernoulli_distribution dist(0.3);
+    Grid<bool> bytes(SIZE, SIZE, false);
+    bytes.for_each([&gen, &dist](bool &value) { value = dist(gen); });
+    const BitGrid bits =
+        BitGrid::from_grid(bytes, [](bool value) { return value; });
+
+    double count_bytes = best_time(REPEATS, [&bytes]() {
+        return static_cast<std::size_t>(
+            std::count(bytes.data().begin(), bytes.data().end(), true));
+    });
+    double count_bits = best_time(REPEATS, [&bits]() { return bits.count(); });
+
+    double dilate_bytes = best_time(REPEATS, [&bytes]() {
+        Grid<bool> result(bytes, false);
+        bytes.for_each([&](bool value, const Pos &pos) {
+            if (value) {
+                bytes.manhattan_kernel(pos, [&result](bool, const Pos &p) {
+                    result[p] = true;
+                });
+            }
+        });
+        return static_cast<std::size_t>(result[Pos(0, 0)]);
+    });
+    double dilate_bits = best_time(REPEATS, [&bits]() {
+        BitGrid result = bits;
+        result.dilate_manhattan();
+        return static_cast<std::size_t>(result[Pos(0, 0)]);
+    });
+
+    std::cout << SIZE << "x" << SIZE << " grid, 30% set:\n";
+    std::cout << "  count, Grid<bool>:              " << count_bytes
+              << " ms\n";
+    std::cout << "  count, BitGrid:                 " << count_bits << " ms\n";
+    std::cout << "  4-way dilation, Grid<bool>:     " << dilate_bytes
+              << " ms\n";
+    std::cout << "  4-way dilation, BitGrid:        " << dilate_bits
+              << " ms\n";
+}
+
+} // namespace aoc::ds::bench
+
+int main() {
+    aoc::ds::bench::run();
+    return 0;
+}
@@ -0,0 +1,119 @@
+/******************************************************************************
+ * File:        bench_gauss_elim.cpp
+ *
+ * Author:      Eric T. Johnson (yut23)
+ * Created:     2026-10-17
+ * Description: Benchmark for exact integer solves, comparing the unchecked
+ *              fraction-free elimination, the overflow-checked fast path, and
+ *              the __int128 path.
+ *****************************************************************************/
+
+#include "bench.hpp"      // for best_time, do_not_optimize
+#include "ds/grid.hpp"    // for Grid
+#include "gauss_elim.hpp" // for row_echelon, back_substitute, solve_exact
+
+#include <cstddef>  // for size_t
+#include <iomanip>  // for setw, setprecision, fixed
+#include <iostream> // for cout
+#include <optional> // for optional
+#include <random>   // for mt19937, uniform_int_distribution
+#include <utility>  // for pair
+#include <vector>   // for vector
+
+namespace aoc::math::bench {
+
+using aoc::bench::best_time;
+using aoc::bench::do_not_optimize;
+using system_t = std::pair<aoc::ds::Grid<long>, std::vector<long>>;
+
+constexpr int REPEATS = 10;
+
+std::vector<system_t> random_systems(int n, long max_coeff,
+                                     std::size_t count) {
+    std::mt19937 gen(n * count);
+    std::uniform_int_distribution<long> coeff_dist(-max_coeff, max_coeff);
+    std::uniform_int_distribution<long> x_dist(-100, 100);
+    std::vector<system_t> systems;
+    systems.reserve(count);
+    while (systems.size() < count) {
+        aoc::ds::Grid<long> A(n, n);
+        A.for_each([&](long &value) { value = coeff_dist(gen); });
+        std::vector<long> b(n, 0);
+        for (int c = 0; c < n; ++c) {
+            const long x = x_dist(gen);
+            for (int r = 0; r < n; ++r) {
+                b[r] += A.at(c, r) * x;
+            }
+        }
+        systems.emplace_back(std::move(A), std::move(b));
+    }
+    return systems;
+}
+
+/// Returns the best-of-`REPEATS` time per system in nanoseconds.
+template <class Solve>
+double time_solves(const std::vector<system_t> &systems, Solve &&solve) {
+    const double elapsed_ms = best_time(REPEATS, [&systems, &solve]() {
+        for (const auto &[A, b] : systems) {
+            do_not_optimize(solve(A, b));
+        }
+        return systems.size();
+    });
+    return elapsed_ms * 1e6 / systems.size();
+}
+
+std::optional<std::vector<long>> unchecked(const aoc::ds::Grid<long> &A,
+                                           const std::vector<long> &b) {
+    aoc::ds::Grid<long> A_copy = A;
+    std::vector<long> b_copy = b;
+    if (!row_echelon(A_copy, b_copy)) {
+        return {};
+    }
+    return back_substitute(A_copy, b_copy);
+}
+
+template <class W>
+std::optional<std::vector<long>> solve_as(const aoc::ds::Grid<long> &A,
+                                          const std::vector<long> &b) {
+    std::vector<long> x;
+    if (detail::solve_exact_as<W>(A, b, x) != detail::exact_status::SOLVED) {
+        return {};
+    }
+    return x;
+}
+
+std::optional<std::vector<long>> adaptive(const aoc::ds::Grid<long> &A,
+                                          const std::vector<long> &b) {
+    return solve_exact(A, b);
+}
+
+void run(int n, long max_coeff, bool fits_in_long) {
+    const auto systems = random_systems(n, max_coeff, 20000);
+    std::cout << "  n=" << n << ", |A| <= " << std::setw(6) << max_coeff
+              << ":";
+    if (fits_in_long) {
+        std::cout << "  unchecked " << std::setw(7)
+                  << time_solves(systems, unchecked) << " ns,  checked "
+                  << std::setw(7) << time_solves(systems, solve_as<long>)
+                  << " ns,";
+    }
+    std::cout << "  __int128 " << std::setw(7)
+              << time_solves(systems, solve_as<__int128>)
+              << " ns,  adaptive " << std::setw(7)
+              << time_solves(systems, adaptive) << " ns\n";
+}
+
+} // namespace aoc::math::bench
+
+int main() {
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "exact solves of random systems (time per system):\n";
+    // these all fit in long
+    aoc::math::bench::run(3, 100, true);
+    aoc::math::bench::run(6, 10, true);
+    aoc::math::bench::run(8, 3, true);
+    // these overflow long, so the adaptive solver retries with __int128
+    aoc::math::bench::run(4, 100000, false);
+    aoc::math::bench::run(6, 1000, false);
+    return 0;
+}
@@ -0,0 +1,82 @@
+/******************************************************************************
+ * File:        bench_graph.cpp
+ *
+ * Author:      Eric T. Johnson (yut23)
+ * Created:     2026-10-16
+ * Description: Micro-benchmark for the per-edge cost of the graph traversal
+ *              callbacks, with and without std::function type erasure.
+ *****************************************************************************/
+
+#include "ds/grid.hpp"         // for Grid
+#include "graph_traversal.hpp" // for bfs, make_grid_indexer
+#include "lib.hpp"             // for Pos
+
+#include <algorithm>  // for min
+#include <chrono>     // for steady_clock, duration
+#include <functional> // for function
+#include <iostream>   // for cout
+#include <limits>     // for numeric_limits
+
+namespace aoc::graph::bench {
+
+constexpr int SIZE = 1000;
+constexpr int REPEATS = 5;
+
+/**
+ * Runs a full BFS flood over an open grid `REPEATS` times, and returns the
+ * fastest time per edge in nanoseconds.
+ */
+template <class ProcessNeighbors, class Visit>
+double time_per_edge(const ds::Grid<bool> &grid,
+                     ProcessNeighbors &&process_neighbors, Visit &&visit,
+                     const long &edge_count) {
+    double best = std::numeric_limits<double>::infinity();
+    for (int i = 0; i < REPEATS; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        bfs(Pos{0, 0}, process_neighbors, {}, visit, make_grid_indexer(grid));
+        std::chrono::duration<double, std::nano> elapsed =
+            std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count());
+    }
+    return best / (edge_count / REPEATS);
+}
+
+void run() {
+    const ds::Grid<bool> grid(SIZE, SIZE, true);
+    long edge_count = 0;
+    long visit_count = 0;
+
+    const auto process_neighbors = [&grid, &edge_count](const Pos &pos,
+                                                        auto &&process) {
+        grid.manhattan_kernel(pos, [&](bool open, const Pos &neighbor) {
+            if (open && neighbor != pos) {
+                ++edge_count;
+                process(neighbor);
+            }
+        });
+    };
+    const auto visit = [&visit_count](const Pos &, int) { ++visit_count; };
+
+    double templated = time_per_edge(grid, process_neighbors, visit, edge_count);
+    long templated_edges = edge_count;
+    edge_count = 0;
+
+    // the same callbacks, hidden behind std::function
+    const std::function<void(const Pos &, std::function<void(const Pos &)>)>
+        erased_neighbors = process_neighbors;
+    const std::function<void(const Pos &, int)> erased_visit = visit;
+    double erased =
+        time_per_edge(grid, erased_neighbors, erased_visit, edge_count);
+
+    std::cout << SIZE << "x" << SIZE << " grid, "
+              << templated_edges / REPEATS << " edges per flood\n";
+    std::cout << "  templated callbacks:     " << templated << " ns/edge\n";
+    std::cout << "  std::function callbacks: " << erased << " ns/edge\n";
+}
+
+} // namespace aoc::graph::bench
+
+int main() {
+    aoc::graph::bench::run();
+    return 0;
+}
@@ -0,0 +1,149 @@
+/******************************************************************************
+ * File:        bench_grid_layout.cpp
+ *
+ * Author:      Eric T. Johnson (yut23)
+ * Created:     2026-10-16
+ * Description: Benchmark for neighborhood kernels and a BFS flood on a Grid
+ *              with row-major, tiled and Z-order storage layouts, and for the
+ *              bulk kernel reductions.
+ *****************************************************************************/
+
+#include "bench.hpp"   // for best_time
+#include "ds/grid.hpp" // for Grid, RowMajorLayout, TiledLayout, ZOrderLayout
+#include "lib.hpp"     // for Pos, Delta, DIRECTIONS
+
+#include <cstddef>   // for size_t
+#include <iomanip>   // for setw
+#include <iostream>  // for cout
+#include <random>    // for mt19937, bernoulli_distribution
+#include <string>    // for string
+#include <vector>    // for vector
+
+namespace aoc::ds::bench {
+
+using aoc::bench::best_time;
+
+constexpr int REPEATS = 5;
+
+/// random walls, with the center left open as the BFS source
+Grid<bool> make_walls(int size) {
+    std::mt19937 gen(size);
+    std::bernoulli_distribution dist(0.2);
+    Grid<bool> walls(size, size, false);
+    walls.for_each([&gen, &dist](bool &value) { value = dist(gen); });
+    walls.chebyshev_kernel(Pos(size / 2, size / 2),
+                           [&walls](bool, const Pos &pos) {
+                               walls[pos] = false;
+                           });
+    return walls;
+}
+
+template <class Layout>
+void run_layout(const std::string &name, const Grid<bool> &walls) {
+    const int size = walls.width;
+    Grid<int, Layout> values(size, size, 0);
+    walls.for_each([&values](bool wall, const Pos &pos) {
+        values[pos] = wall ? 1 : pos.x ^ pos.y;
+    });
+    Grid<bool, Layout> open(walls, false);
+    walls.for_each(
+        [&open](bool wall, const Pos &pos) { open[pos] = !wall; });
+
+    double manhattan = best_time(REPEATS, [&values]() {
+        std::size_t total = 0;
+        values.for_each([&values, &total](int, const Pos &pos) {
+            values.manhattan_kernel(
+                pos, 2, [&total](int value) { total += value; });
+        });
+        return total;
+    });
+    double chebyshev = best_time(REPEATS, [&values]() {
+        std::size_t total = 0;
+        values.for_each([&values, &total](int, const Pos &pos) {
+            values.chebyshev_kernel(pos,
+                                    [&total](int value) { total += value; });
+        });
+        return total;
+    });
+    double bfs = best_time(REPEATS, [&open, size]() {
+        const Pos source(size / 2, size / 2);
+        Grid<int, Layout> distance(size, size, -1);
+        std::vector<Pos> queue{source};
+        distance[source] = 0;
+        for (std::size_t i = 0; i < queue.size(); ++i) {
+            const Pos pos = queue[i];
+            const int next = distance[pos] + 1;
+            for (const auto &dir : DIRECTIONS) {
+                const Pos neighbor = pos + Delta(dir, true);
+                if (open.in_bounds(neighbor) && open[neighbor] &&
+                    distance[neighbor] < 0) {
+                    distance[neighbor] = next;
+                    queue.push_back(neighbor);
+                }
+            }
+        }
+        return queue.size();
+    });
+
+    std::cout << "  " << std::left << std::setw(16) << name << std::right
+              << std::setw(10) << manhattan << std::setw(12) << chebyshev
+              << std::setw(10) << bfs << "\n";
+}
+
+/// compares per-cell kernel callbacks to the bulk reductions
+void run_reductions(const Grid<bool> &walls) {
+    const auto is_wall = [](bool wall) { return wall; };
+    double functor = best_time(REPEATS, [&walls]() {
+        std::size_t total = 0;
+        walls.for_each([&walls, &total](bool, const Pos &pos) {
+            walls.manhattan_kernel(pos, 3,
+                                   [&total](bool wall) { total += wall; });
+        });
+        return total;
+    });
+    double count = best_time(REPEATS, [&walls, &is_wall]() {
+        std::size_t total = 0;
+        walls.for_each([&walls, &total, &is_wall](bool, const Pos &pos) {
+            total += walls.manhattan_count(pos, 3, is_wall);
+        });
+        return total;
+    });
+    double neighbors_functor = best_time(REPEATS, [&walls]() {
+        std::size_t total = 0;
+        walls.for_each([&walls, &total](bool, const Pos &pos) {
+            walls.chebyshev_kernel(pos,
+                                   [&total](bool wall) { total += wall; });
+        });
+        return total;
+    });
+    double neighbors_grid = best_time(REPEATS, [&walls, &is_wall]() {
+        const Grid<int> counts = walls.chebyshev_counts(is_wall);
+        return static_cast<std::size_t>(counts[Pos(0, 0)]);
+    });
+    std::cout << "  manhattan(3) count, functor:   " << functor << "\n";
+    std::cout << "  manhattan(3) count, reduction: " << count << "\n";
+    std::cout << "  chebyshev(1) counts, functor:  " << neighbors_functor
+              << "\n";
+    std::cout << "  chebyshev(1) counts, grid:     " << neighbors_grid << "\n";
+}
+
+void run(int size) {
+    const Grid<bool> walls = make_walls(size);
+    std::cout << size << "x" << size
+              << " grid (ms): manhattan(2)  chebyshev(1)  BFS\n";
+    std::cout << std::fixed << std::setprecision(1);
+    run_layout<RowMajorLayout>("row-major", walls);
+    run_layout<TiledLayout<8>>("tiled<8>", walls);
+    run_layout<TiledLayout<16>>("tiled<16>", walls);
+    run_layout<TiledLayout<64>>("tiled<64>", walls);
+    run_layout<ZOrderLayout>("z-order", walls);
+    run_reductions(walls);
+}
+
+} // namespace aoc::ds::bench
+
+int main() {
+    aoc::ds::bench::run(1000);
+    aoc::ds::bench::run(4000);
+    return 0;
+}
@@ -0,0 +1,212 @@
+/******************************************************************************
+ * File:        bench_input.cpp
+ *
+ * Author:      Eric T. Johnson (yut23)
+ * Created:     2026-10-16
+ * Description: Benchmark for parsing a large input file through std::ifstream,
+ *              compared to a memory-mapped std::string_view and the
+ *              vectorized integer scanner, and for loading character grids.
+ *****************************************************************************/
+
+#include "bench.hpp"   // for best_time
+#include "ds/grid.hpp" // for Grid, GridView
+#include "lib.hpp" // for read_lines, read_vector, read_csv, lines, scan_int, parse_ints, parse_csv_ints
+#include "util/mapped_file.hpp" // for MappedFile
+
+#include <cstddef>     // for size_t
+#include <filesystem>  // for temp_directory_path, remove, file_size
+#include <fstream>     // for ifstream, ofstream
+#include <iostream>    // for cout
+#include <random>      // for mt19937, uniform_int_distribution
+#include <sstream>     // for istringstream
+#include <string>      // for string, getline
+#include <string_view> // for string_view
+#include <vector>      // for vector
+
+namespace aoc::bench {
+
+constexpr std::size_t LINES = 1'000'000;
+constexpr int REPEATS = 5;
+
+/**
+ * Writes a file with lines of whitespace-separated integers, with either two
+ * columns (like 2024 day 1) or a variable number (like 2024 day 2).
+ */
+std::string write_input(const std::string &name, bool variable_width) {
+    std::string filename =
+        (std::filesystem::temp_directory_path() / name).string();
+    std::ofstream out(filename);
+    std::mt19937 gen(LINES);
+    std::uniform_int_distribution<int> value_dist(10000, 99999);
+    std::uniform_int_distribution<int> width_dist(5, 8);
+    for (std::size_t i = 0; i < LINES; ++i) {
+        if (variable_width) {
+            int width = width_dist(gen);
+            for (int j = 0; j < width; ++j) {
+                out << (j > 0 ? " " : "") << value_dist(gen) % 100;
+            }
+            out << '\n';
+        } else {
+            out << value_dist(gen) << "   " << value_dist(gen) << '\n';
+        }
+    }
+    return filename;
+}
+
+void run_columns() {
+    const std::string filename = write_input("aoc_bench_columns.txt", false);
+    double stream = best_time(REPEATS, [&filename]() {
+        std::ifstream is(filename);
+        long sum = 0;
+        int l, r;
+        while (is >> l >> r) {
+            sum += l - r;
+        }
+        return sum;
+    });
+    double mapped = best_time(REPEATS, [&filename]() {
+        util::MappedFile input(filename);
+        std::string_view text = input.view();
+        long sum = 0;
+        int l, r;
+        while (scan_int(text, l) && scan_int(text, r)) {
+            sum += l - r;
+        }
+        return sum;
+    });
+    double vectorized = best_time(REPEATS, [&filename]() {
+        util::MappedFile input(filename);
+        std::vector<int> values = read_vector<int>(input.view());
+        long sum = 0;
+        for (std::size_t i = 0; i + 1 < values.size(); i += 2) {
+            sum += values[i] - values[i + 1];
+        }
+        return sum;
+    });
+    std::cout << "two columns, " << std::filesystem::file_size(filename)
+              << " bytes:\n";
+    std::cout << "  ifstream >> int:       " << stream << " ms\n";
+    std::cout << "  mmap + scan_int:       " << mapped << " ms\n";
+    std::cout << "  mmap + read_vector:    " << vectorized << " ms\n";
+    std::filesystem::remove(filename);
+}
+
+void run_reports() {
+    const std::string filename = write_input("aoc_bench_reports.txt", true);
+    double stream = best_time(REPEATS, [&filename]() {
+        std::ifstream is(filename);
+        long sum = 0;
+        for (const std::string &line : read_lines(is)) {
+            std::istringstream ss(line);
+            sum += read_vector<int>(ss).size();
+        }
+        return sum;
+    });
+    double mapped = best_time(REPEATS, [&filename]() {
+        util::MappedFile input(filename);
+        long sum = 0;
+        for (std::string_view line : lines(input.view())) {
+            sum += read_vector<int>(line).size();
+        }
+        return sum;
+    });
+    std::cout << "variable-width lines, "
+              << std::filesystem::file_size(filename) << " bytes:\n";
+    std::cout << "  read_lines(istream&) + read_vector(istream&):    "
+              << stream << " ms\n";
+    std::cout << "  lines(string_view) + read_vector(string_view):   "
+              << mapped << " ms\n";
+    std::filesystem::remove(filename);
+}
+
+void run_csv() {
+    const std::string filename =
+        (std::filesystem::temp_directory_path() / "aoc_bench_csv.txt").string();
+    {
+        std::ofstream out(filename);
+        std::mt19937 gen(LINES);
+        std::uniform_int_distribution<int> value_dist(-99999, 99999);
+        for (std::size_t i = 0; i < 2 * LINES; ++i) {
+            out << (i > 0 ? "," : "") << value_dist(gen);
+        }
+        out << '\n';
+    }
+    double stream = best_time(REPEATS, [&filename]() {
+        std::ifstream is(filename);
+        return static_cast<long>(read_csv<int>(is).size());
+    });
+    double mapped = best_time(REPEATS, [&filename]() {
+        util::MappedFile input(filename);
+        return static_cast<long>(parse_csv_ints<int>(input.view()).size());
+    });
+    double all_ints = best_time(REPEATS, [&filename]() {
+        util::MappedFile input(filename);
+        return static_cast<long>(parse_ints<int>(input.view()).size());
+    });
+    std::cout << "one comma-separated line, "
+              << std::filesystem::file_size(filename) << " bytes:\n";
+    std::cout << "  read_csv(ifstream&):   " << stream << " ms\n";
+    std::cout << "  mmap + parse_csv_ints: " << mapped << " ms\n";
+    std::cout << "  mmap + parse_ints:     " << all_ints << " ms\n";
+    std::filesystem::remove(filename);
+}
+
+void run_grid() {
+    constexpr int SIZE = 3000;
+    const std::string filename =
+        (std::filesystem::temp_directory_path() / "aoc_bench_grid.txt")
+            .string();
+    {
+        std::ofstream out(filename);
+        std::mt19937 gen(SIZE);
+        std::uniform_int_distribution<int> dist(0, 9);
+        for (int y = 0; y < SIZE; ++y) {
+            for (int x = 0; x < SIZE; ++x) {
+                out << static_cast<char>(dist(gen) == 0 ? '#' : '.');
+            }
+            out << '\n';
+        }
+    }
+    const auto count_walls = [](const auto &grid) {
+        long count = 0;
+        for (int x = 0; x < grid.width; ++x) {
+            count += grid[Pos(x, grid.height / 2)] == '#';
+        }
+        return count;
+    };
+    double stream = best_time(REPEATS, [&]() {
+        std::ifstream is(filename);
+        return count_walls(ds::Grid<char>{read_lines(is)});
+    });
+    double mapped = best_time(REPEATS, [&]() {
+        util::MappedFile input(filename);
+        return count_walls(ds::Grid<char>::from_buffer(input.view()));
+    });
+    double transformed = best_time(REPEATS, [&filename]() {
+        util::MappedFile input(filename);
+        auto grid = ds::Grid<bool>::from_buffer(
+            input.view(), [](char ch) { return ch == '#'; });
+        return static_cast<long>(grid[Pos(0, 0)]);
+    });
+    double view = best_time(REPEATS, [&]() {
+        util::MappedFile input(filename);
+        return count_walls(ds::GridView(input.view()));
+    });
+    std::cout << SIZE << "x" << SIZE << " character grid:\n";
+    std::cout << "  Grid<char>{read_lines(ifstream&)}: " << stream << " ms\n";
+    std::cout << "  mmap + Grid<char>::from_buffer:    " << mapped << " ms\n";
+    std::cout << "  mmap + Grid<bool>::from_buffer:    " << transformed
+              << " ms\n";
+    std::cout << "  mmap + GridView:                   " << view << " ms\n";
+    std::filesystem::remove(filename);
+}
+
+} // namespace aoc::bench
+
+int main() {
+    aoc::bench::run_columns();
+    aoc::bench::run_reports();
+    aoc::bench::run_csv();
+    aoc::bench::run_grid();
+    return 0;
+}
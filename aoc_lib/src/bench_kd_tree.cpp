@@ -0,0 +1,111 @@
+/******************************************************************************
+ * File:        bench_kd_tree.cpp
+ *
+ * Author:      Eric T. Johnson (yut23)
+ * Created:     2026-10-16
+ * Description: Benchmark for streaming closest pairs from a kd_tree, compared
+ *              to sorting every pair up front.
+ *****************************************************************************/
+
+#include "bench.hpp"           // for best_time
+#include "ds/disjoint_set.hpp" // for disjoint_set
+#include "ds/kd_tree.hpp"      // for closest_pairs
+#include "lib.hpp"             // for Pos3
+
+#include <algorithm>  // for sort
+#include <cstddef>    // for size_t
+#include <functional> // for greater
+#include <iostream>   // for cout
+#include <queue>      // for priority_queue
+#include <random>     // for mt19937, uniform_int_distribution
+#include <tuple>      // for tuple
+#include <vector>     // for vector
+
+namespace aoc::ds::bench {
+
+using aoc::bench::best_time;
+
+constexpr int REPEATS = 3;
+
+std::vector<Pos3> random_points(std::size_t count) {
+    std::mt19937 gen(count);
+    std::uniform_int_distribution<int> dist(0, 99999);
+    std::vector<Pos3> points;
+    points.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        int x = dist(gen);
+        int y = dist(gen);
+        int z = dist(gen);
+        points.emplace_back(x, y, z);
+    }
+    return points;
+}
+
+/**
+ * Merges the closest 1000 pairs, then keeps going until everything is
+ * connected (like 2025 day 8), and returns the number of pairs used.
+ */
+template <class NextPair>
+std::size_t connect_all(std::size_t count, NextPair &&next_pair) {
+    disjoint_set dset(count);
+    std::size_t pair_count = 0;
+    for (; pair_count < 1000 || dset.set_count() > 1; ++pair_count) {
+        const auto [dist_sq, id1, id2] = next_pair();
+        dset.merge(id1, id2);
+    }
+    return pair_count;
+}
+
+void run_streaming(std::size_t count) {
+    const std::vector<Pos3> points = random_points(count);
+    double build_time =
+        best_time(REPEATS, [&points]() { return closest_pairs<int>(points); });
+    std::size_t pair_count = 0;
+    double total_time = best_time(REPEATS, [&points, &pair_count, count]() {
+        closest_pairs<int> pairs(points);
+        pair_count =
+            connect_all(count, [&pairs]() { return pairs.next().value(); });
+        return pair_count;
+    });
+    std::cout << "  kd_tree stream, n=" << count << ": " << total_time
+              << " ms (" << build_time << " ms setup, " << pair_count
+              << " pairs)\n";
+}
+
+void run_all_pairs(std::size_t count) {
+    using pair_t = std::tuple<long, std::size_t, std::size_t>;
+    const std::vector<Pos3> points = random_points(count);
+    std::size_t pair_count = 0;
+    double total_time = best_time(REPEATS, [&points, &pair_count, count]() {
+        std::priority_queue<pair_t, std::vector<pair_t>, std::greater<pair_t>>
+            pqueue;
+        for (std::size_t i = 0; i < count; ++i) {
+            for (std::size_t j = i + 1; j < count; ++j) {
+                pqueue.emplace(
+                    (points[i] - points[j]).euclidean_distance_sq(), i, j);
+            }
+        }
+        pair_count = connect_all(count, [&pqueue]() {
+            pair_t top = pqueue.top();
+            pqueue.pop();
+            return top;
+        });
+        return pair_count;
+    });
+    std::cout << "  all pairs,      n=" << count << ": " << total_time
+              << " ms (" << pair_count << " pairs)\n";
+}
+
+} // namespace aoc::ds::bench
+
+int main() {
+    std::cout << "connecting random points in a 100000^3 box:\n";
+    for (std::size_t count : {1000, 2000, 5000}) {
+        aoc::ds::bench::run_all_pairs(count);
+        aoc::ds::bench::run_streaming(count);
+    }
+    for (std::size_t count : {10000, 30000, 100000}) {
+        aoc::ds::bench::run_streaming(count);
+    }
+    return 0;
+}
@@ -0,0 +1,198 @@
+/******************************************************************************
+ * File:        cycle.hpp
+ *
+ * Author:      Eric T. Johnson (yut23)
+ * Created:     2026-10-17
+ * Description: Cycle detection for iterated functions, for skipping ahead in
+ *              simulations that eventually repeat.
+ *****************************************************************************/
+
+#ifndef CYCLE_HPP_R4WX9K2D
+#define CYCLE_HPP_R4WX9K2D
+
+#include <cassert>       // for assert
+#include <concepts>      // for copyable, copy_constructible, ...
+#include <cstdint>       // for uint64_t
+#include <limits>        // for numeric_limits
+#include <optional>      // for optional
+#include <unordered_map> // for unordered_map
+
+namespace aoc::cycle {
+
+/**
+ * Describes the sequence x_0, x_1 = step(x_0), x_2 = step(x_1), ... once it
+ * starts repeating: x_n == x_{n + length} for every n >= start.
+ */
+struct cycle_info {
+    // index of the first state on the cycle (mu)
+    long start;
+    // period of the cycle (lambda)
+    long length;
+    // index of the state the detector left behind
+    long position;
+
+    /// Returns the smallest index whose state is the same as x_n (see the
+    /// caveats on find_cycle).
+    long reduce(long n) const {
+        if (n < start) {
+            return n;
+        }
+        return start + (n - start) % length;
+    }
+};
+
+using fingerprint_t = std::uint64_t;
+
+template <class Func, class State>
+concept Step = requires(Func step, State &state) { step(state); };
+
+template <class Func, class State>
+concept Fingerprint = requires(Func fingerprint, const State &state) {
+    { fingerprint(state) } -> std::convertible_to<fingerprint_t>;
+};
+
+template <class State>
+concept CycleState =
+    std::copy_constructible<State> && std::equality_comparable<State>;
+
+/**
+ * Steps `state` until it repeats, keeping only a fingerprint of each state
+ * (not a copy). A fingerprint match is verified by saving the matching state
+ * and checking that it comes back after the candidate period; if it doesn't,
+ * the match was a collision and the search carries on.
+ *
+ * On success, `state` is left at index `position` of the returned
+ * cycle_info. Returns {} if no cycle is found within `max_steps` steps, in
+ * which case `state` is x_{max_steps}.
+ *
+ * N.B. a fingerprint collision can make `start` too small, if the colliding
+ * state happens to be on the cycle, or make `length` a multiple of the period,
+ * if it hides a real match while it is being checked. The cycle is still
+ * real, so skipping ahead from `position` is safe either way.
+ */
+template <CycleState State, Step<State> StepFunc,
+          Fingerprint<State> FingerprintFunc>
+std::optional<cycle_info>
+find_cycle(State &state, StepFunc &&step, FingerprintFunc &&fingerprint,
+           long max_steps = std::numeric_limits<long>::max()) {
+    std::unordered_map<fingerprint_t, long> seen;
+    // the state at the first fingerprint match, waiting to be verified
+    std::optional<State> candidate{};
+    cycle_info info{0, 0, 0};
+    for (long &i = info.position;; ++i) {
+        if (candidate.has_value() && i == info.start + 2 * info.length) {
+            if (state == *candidate) {
+                return info;
+            }
+            candidate.reset();
+        }
+        if (i == max_steps) {
+            return {};
+        }
+        // keep recording while a candidate is pending, so a rejected
+        // candidate doesn't leave a gap that hides the real start of the cycle
+        const auto [it, inserted] = seen.try_emplace(fingerprint(state), i);
+        if (!inserted && !candidate.has_value()) {
+            info.start = it->second;
+            info.length = i - it->second;
+            candidate.emplace(state);
+        }
+        step(state);
+    }
+}
+
+/**
+ * Brent's algorithm: finds the cycle with a constant number of state copies
+ * and no table, at the cost of stepping about three times as far as
+ * find_cycle. The fingerprint is only used to skip most of the full state
+ * comparisons.
+ *
+ * On success, `state` is left at index `position` of the returned
+ * cycle_info. Returns {} if the first phase takes more than `max_steps`
+ * steps.
+ */
+template <CycleState State, Step<State> StepFunc,
+          Fingerprint<State> FingerprintFunc>
+    requires std::copyable<State>
+std::optional<cycle_info>
+brent(State &state, StepFunc &&step, FingerprintFunc &&fingerprint,
+      long max_steps = std::numeric_limits<long>::max()) {
+    const auto same = [&fingerprint](const State &a, fingerprint_t a_fp,
+                                     const State &b) {
+        return a_fp == static_cast<fingerprint_t>(fingerprint(b)) && a == b;
+    };
+
+    // phase 1: the tortoise teleports to the hare at each power of two, so
+    // the hare catches it within one period once both are on the cycle
+    const State initial = state;
+    State tortoise = state;
+    fingerprint_t tortoise_fp = fingerprint(tortoise);
+    long power = 1;
+    long length = 1;
+    long position = 1;
+    step(state);
+    while (!same(tortoise, tortoise_fp, state)) {
+        if (position >= max_steps) {
+            return {};
+        }
+        if (power == length) {
+            tortoise = state;
+            tortoise_fp = fingerprint(tortoise);
+            power *= 2;
+            length = 0;
+        }
+        step(state);
+        ++position;
+        ++length;
+    }
+
+    // phase 2: start the hare one period ahead, then advance both until they
+    // meet at the start of the cycle
+    tortoise = initial;
+    state = initial;
+    for (long i = 0; i < length; ++i) {
+        step(state);
+    }
+    long start = 0;
+    while (!same(state, fingerprint(state), tortoise)) {
+        step(tortoise);
+        step(state);
+        ++start;
+    }
+    return cycle_info{start, length, start + length};
+}
+
+/**
+ * Advances `state` from x_{info.position} to x_n, skipping whole cycles.
+ */
+template <class State, Step<State> StepFunc>
+void fast_forward(State &state, const cycle_info &info, long n,
+                  StepFunc &&step) {
+    assert(n >= info.start);
+    long remaining = (n - info.position) % info.length;
+    if (remaining < 0) {
+        remaining += info.length;
+    }
+    for (; remaining > 0; --remaining) {
+        step(state);
+    }
+}
+
+/**
+ * Advances `state` from x_0 to x_n, using find_cycle to skip ahead once the
+ * sequence repeats. Returns the cycle, if one was found before x_n.
+ */
+template <CycleState State, Step<State> StepFunc,
+          Fingerprint<State> FingerprintFunc>
+std::optional<cycle_info> fast_forward(State &state, long n, StepFunc &&step,
+                                       FingerprintFunc &&fingerprint) {
+    auto info = find_cycle(state, step, fingerprint, n);
+    if (info.has_value()) {
+        fast_forward(state, *info, n, step);
+    }
+    return info;
+}
+
+} // namespace aoc::cycle
+
+#endif /* end of include guard: CYCLE_HPP_R4WX9K2D */
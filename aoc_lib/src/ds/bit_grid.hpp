@@ -0,0 +1,360 @@
+#ifndef BIT_GRID_HPP_5QK2VHJN
+#define BIT_GRID_HPP_5QK2VHJN
+
+#include "ds/grid.hpp" // for Grid
+#include "lib.hpp"     // for Pos, Delta
+
+#include <algorithm>  // for copy, fill, max, min
+#include <bit>        // for popcount, countr_zero
+#include <cassert>    // for assert
+#include <concepts>   // for invocable, predicate
+#include <cstddef>    // for size_t
+#include <cstdint>    // for uint64_t
+#include <cstdlib>    // for abs
+#include <functional> // for bit_and, bit_or, bit_xor
+#include <limits>     // for numeric_limits
+#include <span>       // for span
+#include <stdexcept>  // for out_of_range
+#include <utility>    // for move, swap
+#include <vector>     // for vector
+
+namespace aoc::ds {
+
+/**
+ * Two-dimensional grid of bits, indexable by aoc::Pos.
+ *
+ * Each row is packed into 64-bit words (column x is bit x % 64 of word
+ * x / 64), so counting, bitwise combination, shifting and dilation all work on
+ * 64 cells at a time. The padding bits past the end of each row are always
+ * zero.
+ */
+class BitGrid {
+  public:
+    using size_type = int;
+    using word_type = std::uint64_t;
+    static constexpr int WORD_BITS = std::numeric_limits<word_type>::digits;
+
+    const size_type height;
+    const size_type width;
+
+  private:
+    std::size_t m_row_words;
+    std::vector<word_type> m_words;
+
+    static constexpr word_type ALL_ONES = ~word_type{0};
+
+    /// mask for the valid bits in the last word of each row
+    word_type last_word_mask() const {
+        const int used = width % WORD_BITS;
+        return used == 0 ? ALL_ONES : (word_type{1} << used) - 1;
+    }
+
+    void clear_padding() {
+        const word_type mask = last_word_mask();
+        if (mask == ALL_ONES) {
+            return;
+        }
+        for (std::size_t i = m_row_words - 1; i < m_words.size();
+             i += m_row_words) {
+            m_words[i] &= mask;
+        }
+    }
+
+    std::size_t word_index(const Pos &pos) const {
+        return pos.y * m_row_words + pos.x / WORD_BITS;
+    }
+    static word_type bit_mask(const Pos &pos) {
+        return word_type{1} << (pos.x % WORD_BITS);
+    }
+
+    /// copies `src` into `dst`, moved dx columns to the right (filling with 0)
+    void shift_row(const word_type *src, word_type *dst, int dx) const {
+        const std::size_t n = m_row_words;
+        const std::size_t word_shift = std::abs(dx) / WORD_BITS;
+        const int bit_shift = std::abs(dx) % WORD_BITS;
+        std::fill(dst, dst + n, 0);
+        if (word_shift >= n) {
+            return;
+        }
+        if (dx >= 0) {
+            for (std::size_t i = word_shift; i < n; ++i) {
+                const std::size_t j = i - word_shift;
+                word_type value = src[j] << bit_shift;
+                if (bit_shift != 0 && j > 0) {
+                    value |= src[j - 1] >> (WORD_BITS - bit_shift);
+                }
+                dst[i] = value;
+            }
+        } else {
+            for (std::size_t i = 0; i + word_shift < n; ++i) {
+                const std::size_t j = i + word_shift;
+                word_type value = src[j] >> bit_shift;
+                if (bit_shift != 0 && j + 1 < n) {
+                    value |= src[j + 1] << (WORD_BITS - bit_shift);
+                }
+                dst[i] = value;
+            }
+        }
+    }
+
+    /// ORs each cell of `src` into its left and right neighbors in `dst`
+    void dilate_row_into(const word_type *src, word_type *dst) const {
+        const std::size_t n = m_row_words;
+        for (std::size_t i = 0; i < n; ++i) {
+            word_type value = src[i] | (src[i] << 1) | (src[i] >> 1);
+            if (i > 0) {
+                value |= src[i - 1] >> (WORD_BITS - 1);
+            }
+            if (i + 1 < n) {
+                value |= src[i + 1] << (WORD_BITS - 1);
+            }
+            dst[i] |= value;
+        }
+    }
+
+    template <class Op>
+    BitGrid &combine(const BitGrid &other, Op op) {
+        assert(width == other.width && height == other.height);
+        for (std::size_t i = 0; i < m_words.size(); ++i) {
+            m_words[i] = op(m_words[i], other.m_words[i]);
+        }
+        return *this;
+    }
+
+  public:
+    /// Proxy for a single mutable cell.
+    class reference {
+        word_type *m_word;
+        word_type m_mask;
+
+      public:
+        reference(word_type *word, word_type mask)
+            : m_word(word), m_mask(mask) {}
+
+        operator bool() const { return (*m_word & m_mask) != 0; }
+        reference &operator=(bool value) {
+            if (value) {
+                *m_word |= m_mask;
+            } else {
+                *m_word &= ~m_mask;
+            }
+            return *this;
+        }
+        reference &operator=(const reference &other) {
+            return *this = static_cast<bool>(other);
+        }
+    };
+
+    // construct with the same value everywhere
+    BitGrid(size_type width, size_type height, bool value = false)
+        : height(height), width(width),
+          m_row_words((width + WORD_BITS - 1) / WORD_BITS),
+          m_words(m_row_words * height, value ? ALL_ONES : 0) {
+        clear_padding();
+    }
+
+    // construct a grid with the same dimensions as another grid
+    template <class U, class L>
+    BitGrid(const Grid<U, L> &other_grid, bool value)
+        : BitGrid(other_grid.width, other_grid.height, value) {}
+    BitGrid(const BitGrid &other_grid, bool value)
+        : BitGrid(other_grid.width, other_grid.height, value) {}
+
+    /// sets the cells of another grid where `pred(value)` is true
+    template <class U, class L, std::predicate<const U &> Pred>
+    static BitGrid from_grid(const Grid<U, L> &grid, Pred &&pred) {
+        BitGrid result(grid, false);
+        grid.for_each([&result, &pred](const U &value, const Pos &pos) {
+            if (pred(value)) {
+                result.set(pos);
+            }
+        });
+        return result;
+    }
+
+    BitGrid(const BitGrid &other) = default;
+    BitGrid(BitGrid &&other) noexcept = default;
+
+    bool operator==(const BitGrid &other) const {
+        return width == other.width && height == other.height &&
+               m_words == other.m_words;
+    }
+
+    constexpr bool in_bounds(size_type x, size_type y) const noexcept {
+        return y >= 0 && x >= 0 && y < height && x < width;
+    }
+    constexpr bool in_bounds(const Pos &pos) const noexcept {
+        return in_bounds(pos.x, pos.y);
+    }
+
+    // indexing by Pos
+    bool operator[](const Pos &pos) const {
+        return (m_words[word_index(pos)] & bit_mask(pos)) != 0;
+    }
+    reference operator[](const Pos &pos) {
+        return reference(&m_words[word_index(pos)], bit_mask(pos));
+    }
+    bool at(const Pos &pos) const {
+        if (!in_bounds(pos)) {
+            throw std::out_of_range("BitGrid::at");
+        }
+        return (*this)[pos];
+    }
+    void set(const Pos &pos) { m_words[word_index(pos)] |= bit_mask(pos); }
+    void reset(const Pos &pos) { m_words[word_index(pos)] &= ~bit_mask(pos); }
+
+    /// the packed words of row y
+    std::span<const word_type> row_words(size_type y) const {
+        return {m_words.data() + y * m_row_words, m_row_words};
+    }
+
+    /// number of set cells
+    std::size_t count() const {
+        std::size_t total = 0;
+        for (word_type word : m_words) {
+            total += std::popcount(word);
+        }
+        return total;
+    }
+    bool any() const {
+        for (word_type word : m_words) {
+            if (word != 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+    bool none() const { return !any(); }
+
+    BitGrid &operator&=(const BitGrid &other) {
+        return combine(other, std::bit_and<word_type>{});
+    }
+    BitGrid &operator|=(const BitGrid &other) {
+        return combine(other, std::bit_or<word_type>{});
+    }
+    BitGrid &operator^=(const BitGrid &other) {
+        return combine(other, std::bit_xor<word_type>{});
+    }
+    /// clears every cell that is set in `other`
+    BitGrid &and_not(const BitGrid &other) {
+        return combine(other, [](word_type a, word_type b) { return a & ~b; });
+    }
+    /// inverts every cell
+    BitGrid &flip() {
+        for (word_type &word : m_words) {
+            word = ~word;
+        }
+        clear_padding();
+        return *this;
+    }
+
+    /**
+     * Moves every cell by `delta`, dropping cells that leave the grid and
+     * clearing the cells left behind.
+     */
+    BitGrid &shift(const Delta &delta) {
+        std::vector<word_type> result(m_words.size(), 0);
+        for (size_type y = std::max(0, delta.dy);
+             y < std::min(height, height + delta.dy); ++y) {
+            shift_row(&m_words[(y - delta.dy) * m_row_words],
+                      &result[y * m_row_words], delta.dx);
+        }
+        m_words = std::move(result);
+        clear_padding();
+        return *this;
+    }
+
+    /**
+     * Sets every cell within Manhattan distance 1 of a set cell, i.e. one
+     * step of a 4-way flood fill.
+     */
+    BitGrid &dilate_manhattan() {
+        // unmodified copies of the previous and current rows
+        std::vector<word_type> prev(m_row_words, 0), curr(m_row_words);
+        for (size_type y = 0; y < height; ++y) {
+            word_type *row = &m_words[y * m_row_words];
+            std::copy(row, row + m_row_words, curr.begin());
+            dilate_row_into(curr.data(), row);
+            for (std::size_t i = 0; i < m_row_words; ++i) {
+                row[i] |= prev[i];
+                if (y + 1 < height) {
+                    row[i] |= row[i + m_row_words];
+                }
+            }
+            std::swap(prev, curr);
+        }
+        clear_padding();
+        return *this;
+    }
+
+    /**
+     * Sets every cell within Chebyshev distance 1 of a set cell, i.e. one
+     * step of an 8-way flood fill.
+     */
+    BitGrid &dilate_chebyshev() {
+        std::vector<word_type> curr(m_row_words);
+        // horizontal pass
+        for (size_type y = 0; y < height; ++y) {
+            word_type *row = &m_words[y * m_row_words];
+            std::copy(row, row + m_row_words, curr.begin());
+            dilate_row_into(curr.data(), row);
+        }
+        // vertical pass
+        std::vector<word_type> prev(m_row_words, 0);
+        for (size_type y = 0; y < height; ++y) {
+            word_type *row = &m_words[y * m_row_words];
+            std::copy(row, row + m_row_words, curr.begin());
+            for (std::size_t i = 0; i < m_row_words; ++i) {
+                row[i] |= prev[i];
+                if (y + 1 < height) {
+                    row[i] |= row[i + m_row_words];
+                }
+            }
+            std::swap(prev, curr);
+        }
+        clear_padding();
+        return *this;
+    }
+
+    /**
+     * Calls func(value[, pos]) for each position in the grid.
+     */
+    template <typename Func>
+        requires std::invocable<Func, bool, const Pos &> ||
+                 std::invocable<Func, bool>
+    void for_each(Func &&func) const {
+        Pos p;
+        for (p.y = 0; p.y < height; ++p.y) {
+            for (p.x = 0; p.x < width; ++p.x) {
+                if constexpr (std::invocable<Func, bool, const Pos &>) {
+                    func((*this)[p], p);
+                } else {
+                    func((*this)[p]);
+                }
+            }
+        }
+    }
+
+    /**
+     * Calls func(pos) for each set cell, in row-major order, skipping empty
+     * words entirely.
+     */
+    template <std::invocable<const Pos &> Func>
+    void for_each_set(Func &&func) const {
+        for (size_type y = 0; y < height; ++y) {
+            for (std::size_t i = 0; i < m_row_words; ++i) {
+                word_type word = m_words[y * m_row_words + i];
+                while (word != 0) {
+                    func(Pos(static_cast<int>(i * WORD_BITS) +
+                                 std::countr_zero(word),
+                             y));
+                    word &= word - 1;
+                }
+            }
+        }
+    }
+};
+
+} // namespace aoc::ds
+
+#endif /* end of include guard: BIT_GRID_HPP_5QK2VHJN */
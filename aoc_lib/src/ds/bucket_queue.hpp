@@ -0,0 +1,139 @@
+#ifndef BUCKET_QUEUE_HPP_Q3N8VKDZ
+#define BUCKET_QUEUE_HPP_Q3N8VKDZ
+
+#include <cassert> // for assert
+#include <cstddef> // for size_t
+#include <utility> // for move, forward
+#include <vector>  // for vector
+
+namespace aoc::ds {
+
+/**
+ * Monotone min-priority queue for small non-negative integer priorities
+ * (Dial's algorithm).
+ *
+ * While the queue is non-empty, every pushed priority must lie in
+ * [p, p + max_step], where p is the priority of the most recently popped
+ * element. This always holds for Dijkstra's algorithm when all edge weights
+ * are at most max_step. Pushing and popping are amortized O(1), plus a scan
+ * over empty buckets that totals O(largest priority) over the lifetime of the
+ * queue.
+ *
+ * Elements with the same priority are popped in LIFO order.
+ */
+template <class T>
+class bucket_queue {
+  public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using reference = value_type &;
+    using const_reference = const value_type &;
+
+  private:
+    // circular array of buckets, indexed by priority % m_buckets.size()
+    std::vector<std::vector<value_type>> m_buckets;
+    int m_max_step;
+    // lower bound on the priorities in the queue; only advanced lazily when
+    // the top is requested, since pushes are relative to the last popped
+    // priority
+    mutable int m_curr_priority = 0;
+    mutable size_type m_curr_bucket = 0;
+    size_type m_size = 0;
+
+    std::vector<value_type> &bucket_for(int priority) {
+        assert(priority >= 0);
+        if (m_size == 0) {
+            m_curr_priority = priority;
+            m_curr_bucket = priority % m_buckets.size();
+        }
+        assert(priority >= m_curr_priority &&
+               priority <= m_curr_priority + m_max_step);
+        ++m_size;
+        return m_buckets[priority % m_buckets.size()];
+    }
+
+    // move to the next non-empty bucket
+    void advance() const {
+        while (m_buckets[m_curr_bucket].empty()) {
+            ++m_curr_priority;
+            if (++m_curr_bucket == m_buckets.size()) {
+                m_curr_bucket = 0;
+            }
+        }
+    }
+
+  public:
+    explicit bucket_queue(int max_step)
+        : m_buckets(max_step + 1), m_max_step(max_step) {
+        assert(max_step >= 0);
+    }
+
+    /// Returns a reference to an element with the smallest priority.
+    const_reference top() const {
+        assert(m_size > 0);
+        advance();
+        return m_buckets[m_curr_bucket].back();
+    }
+
+    /// Returns the smallest priority in the queue.
+    int top_priority() const {
+        assert(m_size > 0);
+        advance();
+        return m_curr_priority;
+    }
+
+    /// Checks whether the queue is empty.
+    [[nodiscard]] bool empty() const { return m_size == 0; }
+
+    /// Returns the number of elements in the queue.
+    size_type size() const { return m_size; }
+
+    /// Returns the largest priority step supported by this queue.
+    int max_step() const { return m_max_step; }
+
+    /**
+     * Inserts an element into the queue.
+     */
+    void push(int priority, const value_type &value) {
+        bucket_for(priority).push_back(value);
+    }
+
+    /**
+     * Moves an element into the queue.
+     */
+    void push(int priority, value_type &&value) {
+        bucket_for(priority).push_back(std::move(value));
+    }
+
+    /**
+     * Constructs an element in-place and inserts it into the queue.
+     */
+    template <class... Args>
+    void emplace(int priority, Args &&...args) {
+        bucket_for(priority).emplace_back(std::forward<Args>(args)...);
+    }
+
+    /**
+     * Removes the top element from the queue.
+     */
+    void pop() {
+        assert(m_size > 0);
+        advance();
+        m_buckets[m_curr_bucket].pop_back();
+        --m_size;
+    }
+
+    /**
+     * Removes all elements, keeping the allocated bucket storage.
+     */
+    void clear() {
+        for (auto &bucket : m_buckets) {
+            bucket.clear();
+        }
+        m_size = 0;
+    }
+};
+
+} // namespace aoc::ds
+
+#endif /* end of include guard: BUCKET_QUEUE_HPP_Q3N8VKDZ */
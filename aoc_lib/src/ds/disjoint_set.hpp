@@ -2,61 +2,86 @@
 #define DISJOINT_SET_HPP_M2XYFQAC
 
 #include <cstddef> // for size_t
-#include <map>     // for map
-#include <utility> // for swap
+#include <span>    // for span
+#include <utility> // for pair, swap
+#include <vector>  // for vector
 
 namespace aoc::ds {
 
 /**
+ * Disjoint-set forest over the integer ids [0, size()), stored in flat
+ * parent and size arrays.
+ *
  * Implementation: union-by-size with path halving
  */
 class disjoint_set {
   public:
     using id_t = std::size_t;
-    struct node_t {
-        node_t *parent;
-        std::size_t size;
-        id_t id;
 
-        explicit node_t(id_t id) : parent(this), size(1), id(id) {}
-    };
+    disjoint_set() = default;
+    /// creates `count` singleton sets, with ids [0, count)
+    explicit disjoint_set(std::size_t count);
 
-    [[nodiscard]] node_t *new_set();
-    node_t *find(node_t *node);
-    node_t *find(id_t id);
+    void reserve(std::size_t count);
+    /// adds a new singleton set, and returns its id
+    [[nodiscard]] id_t new_set();
+    /// returns the id of the root of the set containing `id`
+    id_t find(id_t id);
+    /// returns the number of elements in the set containing `id`
+    std::size_t set_size(id_t id) { return m_sizes[find(id)]; }
     /// returns true if two distinct sets were merged
-    bool merge(node_t *x, node_t *y);
     bool merge(id_t x, id_t y);
+    /// merges each pair of sets, and returns the number of merges that
+    /// joined two distinct sets
+    std::size_t merge_many(std::span<const std::pair<id_t, id_t>> pairs);
 
+    /**
+     * Returns (root id, size) for each set, in order of root id. Takes O(n)
+     * time.
+     */
+    std::vector<std::pair<id_t, std::size_t>> components() const;
+
+    std::size_t size() const { return m_parents.size(); }
     std::size_t set_count() const { return m_set_count; }
 
   private:
-    std::map<std::size_t, node_t> m_nodes;
-    id_t m_next_id = 0;
+    std::vector<id_t> m_parents{};
+    // only meaningful for roots
+    std::vector<std::size_t> m_sizes{};
     std::size_t m_set_count = 0;
 };
 
-disjoint_set::node_t *disjoint_set::new_set() {
-    auto it = m_nodes.emplace_hint(m_nodes.end(), m_next_id, m_next_id);
-    ++m_next_id;
+disjoint_set::disjoint_set(std::size_t count)
+    : m_parents(count), m_sizes(count, 1), m_set_count(count) {
+    for (id_t id = 0; id < count; ++id) {
+        m_parents[id] = id;
+    }
+}
+
+void disjoint_set::reserve(std::size_t count) {
+    m_parents.reserve(count);
+    m_sizes.reserve(count);
+}
+
+disjoint_set::id_t disjoint_set::new_set() {
+    id_t id = m_parents.size();
+    m_parents.push_back(id);
+    m_sizes.push_back(1);
     ++m_set_count;
-    return &it->second;
+    return id;
 }
 
 // path halving
-disjoint_set::node_t *disjoint_set::find(node_t *node) {
-    while (node->parent != node) {
-        node->parent = node->parent->parent;
-        node = node->parent;
+disjoint_set::id_t disjoint_set::find(id_t id) {
+    while (m_parents[id] != id) {
+        m_parents[id] = m_parents[m_parents[id]];
+        id = m_parents[id];
     }
-    return node;
-}
-disjoint_set::node_t *disjoint_set::find(id_t id) {
-    return find(&m_nodes.at(id));
+    return id;
 }
 
 // union-by-size
-bool disjoint_set::merge(node_t *x, node_t *y) {
+bool disjoint_set::merge(id_t x, id_t y) {
     // replace nodes by roots
     x = find(x);
     y = find(y);
@@ -68,19 +93,37 @@ bool disjoint_set::merge(node_t *x, node_t *y) {
 
     // if necessary, swap variables to ensure that x has at least as many
     // descendants as y
-    if (x->size < y->size) {
+    if (m_sizes[x] < m_sizes[y]) {
         std::swap(x, y);
     }
 
     // make x the new root
-    y->parent = x;
+    m_parents[y] = x;
     // update the size of x
-    x->size += y->size;
+    m_sizes[x] += m_sizes[y];
     --m_set_count;
     return true;
 }
-bool disjoint_set::merge(id_t x, id_t y) {
-    return merge(&m_nodes.at(x), &m_nodes.at(y));
+
+std::size_t
+disjoint_set::merge_many(std::span<const std::pair<id_t, id_t>> pairs) {
+    std::size_t merged = 0;
+    for (const auto &[x, y] : pairs) {
+        merged += merge(x, y);
+    }
+    return merged;
+}
+
+std::vector<std::pair<disjoint_set::id_t, std::size_t>>
+disjoint_set::components() const {
+    std::vector<std::pair<id_t, std::size_t>> result;
+    result.reserve(m_set_count);
+    for (id_t id = 0; id < m_parents.size(); ++id) {
+        if (m_parents[id] == id) {
+            result.emplace_back(id, m_sizes[id]);
+        }
+    }
+    return result;
 }
 
 } // namespace aoc::ds
@@ -5,22 +5,30 @@
 #include "unit_test/pretty_print.hpp"
 #include "util/concepts.hpp" // for any_convertible_range
 
-#include <algorithm> // for copy, move
+#include <algorithm> // for copy, fill, max, min, move, transform
 #include <array>     // for array
+#include <bit>       // for bit_width, has_single_bit
 #include <cassert>   // for assert
 #include <compare>   // for partial_ordering
-#include <concepts>  // for same_as, convertible_to
+#include <concepts>  // for same_as, convertible_to, default_initializable
+#include <cstdint>   // for uint64_t
 #include <cstdlib>   // for abs, size_t, ptrdiff_t
 #include <iomanip>   // for setw
 #include <iostream>  // for ostream
 #include <iterator>  // for begin, end, back_inserter, misc concepts
 #include <ranges>    // for range, range_value_t
 #include <span>      // for span, dynamic_extent // IWYU pragma: export
+#include <stdexcept> // for out_of_range
 #include <string>    // for string, basic_string
-#include <type_traits> // for conditional_t, is_rvalue_reference_v // IWYU pragma: export
+#include <string_view> // for string_view
+#include <type_traits> // for conditional_t, is_rvalue_reference_v, invoke_result_t // IWYU pragma: export
 #include <utility> // for move, pair, make_pair
 #include <vector>  // for vector, __cpp_lib_constexpr_vector
 
+#ifdef __BMI2__
+#include <immintrin.h> // IWYU pragma: keep
+#endif
+
 namespace aoc::ds {
 
 /*
@@ -178,10 +186,206 @@ concept KernelFunc = std::invocable<Func, const T &, const Pos &, int> ||
                      std::invocable<Func, const T &, const Pos &> ||
                      std::invocable<Func, const T &>;
 
+/*
+ * Storage layouts for Grid. Each one maps in-bounds coordinates to an index in
+ * the underlying container (which may include padding), and back again, and
+ * can visit every cell in storage order.
+ */
+template <class L>
+concept GridLayout =
+    std::constructible_from<L, int, int> &&
+    requires(const L &layout, int x, std::size_t index) {
+        { layout.size() } -> std::convertible_to<std::size_t>;
+        { layout.index(x, x) } -> std::convertible_to<std::size_t>;
+        { layout.pos(index) } -> std::same_as<Pos>;
+    };
+
+/// Rows stored one after another, with no padding (the default).
+struct RowMajorLayout {
+    int width;
+    int height;
+
+    constexpr RowMajorLayout(int width, int height)
+        : width(width), height(height) {}
+
+    constexpr std::size_t size() const {
+        return static_cast<std::size_t>(width) * height;
+    }
+    constexpr std::size_t index(int x, int y) const { return y * width + x; }
+    constexpr Pos pos(std::size_t index) const {
+        return Pos(index % width, index / width);
+    }
+
+    /// Calls func(x, y, index) for each cell, in storage order.
+    template <class Func>
+    constexpr void visit(Func &&func) const {
+        std::size_t index = 0;
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x, ++index) {
+                func(x, y, index);
+            }
+        }
+    }
+};
+
+/**
+ * Square tiles of TILE x TILE cells, each stored row-major, with the tiles
+ * themselves in row-major order. Every neighbor of a cell is either in the
+ * same tile or an adjacent one, so kernels and floods touch far fewer cache
+ * lines than with long rows. The grid is padded up to a whole number of tiles.
+ */
+template <int TILE = 16>
+struct TiledLayout {
+    static_assert(TILE > 0 && std::has_single_bit(static_cast<unsigned>(TILE)),
+                  "tile size must be a power of 2");
+    static constexpr std::size_t TILE_AREA = TILE * TILE;
+
+    int width;
+    int height;
+    int tiles_x;
+    int tiles_y;
+
+    constexpr TiledLayout(int width, int height)
+        : width(width), height(height), tiles_x((width + TILE - 1) / TILE),
+          tiles_y((height + TILE - 1) / TILE) {}
+
+    constexpr std::size_t size() const {
+        return static_cast<std::size_t>(tiles_x) * tiles_y * TILE_AREA;
+    }
+    constexpr std::size_t index(int x, int y) const {
+        // unsigned, so the divisions compile down to shifts
+        const unsigned ux = x, uy = y;
+        const std::size_t tile = uy / TILE * tiles_x + ux / TILE;
+        return tile * TILE_AREA + uy % TILE * TILE + ux % TILE;
+    }
+    constexpr Pos pos(std::size_t index) const {
+        const std::size_t tile = index / TILE_AREA;
+        const std::size_t offset = index % TILE_AREA;
+        return Pos(tile % tiles_x * TILE + offset % TILE,
+                   tile / tiles_x * TILE + offset / TILE);
+    }
+
+    /// Calls func(x, y, index) for each cell, in storage order.
+    template <class Func>
+    constexpr void visit(Func &&func) const {
+        for (int ty = 0; ty < tiles_y; ++ty) {
+            const int y_end = std::min(height, (ty + 1) * TILE);
+            for (int tx = 0; tx < tiles_x; ++tx) {
+                const int x_end = std::min(width, (tx + 1) * TILE);
+                for (int y = ty * TILE; y < y_end; ++y) {
+                    std::size_t index = index_of_row_start(tx, y);
+                    for (int x = tx * TILE; x < x_end; ++x, ++index) {
+                        func(x, y, index);
+                    }
+                }
+            }
+        }
+    }
+
+  private:
+    constexpr std::size_t index_of_row_start(int tx, int y) const {
+        return (static_cast<std::size_t>(y / TILE) * tiles_x + tx) *
+                   TILE_AREA +
+               y % TILE * TILE;
+    }
+};
+
+/**
+ * Z-order (Morton) curve: the bits of x and y are interleaved, so cells that
+ * are close in both directions stay close in memory at every scale. Each
+ * dimension is padded to a power of 2; for non-square grids, the extra high
+ * bits of the longer dimension select between square Z-ordered blocks.
+ */
+struct ZOrderLayout {
+    int width;
+    int height;
+    int x_bits;
+    int y_bits;
+    // number of interleaved bits from each coordinate
+    int low_bits;
+
+    constexpr ZOrderLayout(int width, int height)
+        : width(width), height(height), x_bits(bits_for(width)),
+          y_bits(bits_for(height)), low_bits(std::min(x_bits, y_bits)) {}
+
+    constexpr std::size_t size() const {
+        return std::size_t{1} << (x_bits + y_bits);
+    }
+    constexpr std::size_t index(int x, int y) const {
+        const std::uint64_t low_mask = (std::uint64_t{1} << low_bits) - 1;
+        // at most one of x and y has bits above low_bits
+        return spread_bits(x & low_mask) | spread_bits(y & low_mask) << 1 |
+               std::uint64_t((x | y) >> low_bits) << (2 * low_bits);
+    }
+    constexpr Pos pos(std::size_t index) const {
+        const std::uint64_t low =
+            index & ((std::uint64_t{1} << 2 * low_bits) - 1);
+        const auto high = static_cast<int>(index >> (2 * low_bits));
+        return Pos(static_cast<int>(compact_bits(low)) |
+                       (x_bits > low_bits ? high << low_bits : 0),
+                   static_cast<int>(compact_bits(low >> 1)) |
+                       (y_bits > low_bits ? high << low_bits : 0));
+    }
+
+    /// Calls func(x, y, index) for each cell, in storage order.
+    template <class Func>
+    constexpr void visit(Func &&func) const {
+        const std::size_t n = size();
+        for (std::size_t index = 0; index < n; ++index) {
+            const Pos p = pos(index);
+            if (p.x < width && p.y < height) {
+                func(p.x, p.y, index);
+            }
+        }
+    }
+
+  private:
+    static constexpr int bits_for(int length) {
+        return length <= 1
+                   ? 0
+                   : std::bit_width(static_cast<unsigned>(length - 1));
+    }
+
+    /// moves bit i of the low 32 bits of v to bit 2*i
+    static constexpr std::uint64_t spread_bits(std::uint64_t v) {
+#ifdef __BMI2__
+        if (!std::is_constant_evaluated()) {
+            return _pdep_u64(v, 0x5555555555555555ull);
+        }
+#endif
+        v &= 0xffffffffull;
+        v = (v | v << 16) & 0x0000ffff0000ffffull;
+        v = (v | v << 8) & 0x00ff00ff00ff00ffull;
+        v = (v | v << 4) & 0x0f0f0f0f0f0f0f0full;
+        v = (v | v << 2) & 0x3333333333333333ull;
+        v = (v | v << 1) & 0x5555555555555555ull;
+        return v;
+    }
+    /// inverse of spread_bits (ignores the odd bits of v)
+    static constexpr std::uint64_t compact_bits(std::uint64_t v) {
+#ifdef __BMI2__
+        if (!std::is_constant_evaluated()) {
+            return _pext_u64(v, 0x5555555555555555ull);
+        }
+#endif
+        v &= 0x5555555555555555ull;
+        v = (v | v >> 1) & 0x3333333333333333ull;
+        v = (v | v >> 2) & 0x0f0f0f0f0f0f0f0full;
+        v = (v | v >> 4) & 0x00ff00ff00ff00ffull;
+        v = (v | v >> 8) & 0x0000ffff0000ffffull;
+        v = (v | v >> 16) & 0x00000000ffffffffull;
+        return v;
+    }
+};
+
 /**
  * Two-dimensional grid of values, indexable by aoc::Pos.
+ *
+ * The storage order is set by Layout. Everything except row iteration works
+ * the same for every layout; constructors that take flat data always expect it
+ * in row-major order.
  */
-template <class T>
+template <class T, GridLayout Layout = RowMajorLayout>
 struct Grid {
     using value_type = T;
     using size_type = int;
@@ -199,39 +403,60 @@ struct Grid {
                                               std::basic_string<value_type>,
                                               std::vector<value_type>>;
 
+    using layout_type = Layout;
+    static constexpr bool is_row_major = std::same_as<Layout, RowMajorLayout>;
+
     const size_type height;
     const size_type width;
 
   protected:
+    layout_type m_layout;
     container_type m_data;
 
+  private:
+    /// rearranges row-major data into the storage order of this grid
+    constexpr container_type from_row_major(container_type &&data) const {
+        assert(static_cast<size_type>(data.size()) == height * width);
+        if constexpr (is_row_major) {
+            return std::move(data);
+        } else {
+            container_type result(m_layout.size(), value_type());
+            RowMajorLayout(width, height).visit(
+                [&](int x, int y, std::size_t index) {
+                    result[m_layout.index(x, y)] = std::move(data[index]);
+                });
+            return result;
+        }
+    }
+
   public:
     // construct with the same value everywhere
     constexpr Grid(size_type width, size_type height,
                    const value_type &value = value_type())
-        : height(height), width(width), m_data(height * width, value) {}
-    // construct from a flat range (note: not compatible with CTAD)
+        : height(height), width(width), m_layout(width, height),
+          m_data(m_layout.size(), value) {}
+    // construct from a flat range in row-major order (note: not compatible
+    // with CTAD)
     template <util::concepts::any_convertible_range<value_type> R>
     constexpr Grid(size_type width, size_type height, R &&range)
-        : height(height), width(width),
-          m_data(std::begin(range), std::end(range)) {
-        assert(static_cast<size_type>(m_data.size()) == height * width);
-    }
-    // move-construct from a flat data container (note: not compatible with
-    // CTAD)
+        : height(height), width(width), m_layout(width, height),
+          m_data(from_row_major(
+              container_type(std::begin(range), std::end(range)))) {}
+    // move-construct from a flat data container in row-major order (note: not
+    // compatible with CTAD)
     constexpr Grid(size_type width, size_type height, container_type &&data)
-        : height(height), width(width), m_data(std::move(data)) {
-        assert(static_cast<size_type>(m_data.size()) == height * width);
-    }
+        : height(height), width(width), m_layout(width, height),
+          m_data(from_row_major(std::move(data))) {}
     // construct from nested ranges
     template <std::ranges::range V>
         requires std::ranges::range<std::ranges::range_value_t<V>> &&
                      std::same_as<std::ranges::range_value_t<
                                       std::ranges::range_value_t<V>>,
                                   value_type> &&
-                     (!std::same_as<std::remove_cvref_t<V>, Grid<value_type>>)
+                     (!std::same_as<std::remove_cvref_t<V>, Grid>)
     explicit Grid(V &&grid)
-        : height(grid.size()), width(grid[0].size()), m_data() {
+        : height(grid.size()), width(grid[0].size()), m_layout(width, height),
+          m_data() {
         assert(!grid.empty());
         m_data.reserve(height * width);
         auto data_it = std::back_inserter(m_data);
@@ -243,44 +468,128 @@ struct Grid {
                 data_it = std::copy(row.begin(), row.end(), data_it);
             }
         }
+        if constexpr (!is_row_major) {
+            m_data = from_row_major(std::move(m_data));
+        }
     }
 
     // construct a grid with the same dimensions as another grid
-    template <class U>
-    Grid(const Grid<U> &other_grid, const value_type &value)
+    template <class U, class L>
+    Grid(const Grid<U, L> &other_grid, const value_type &value)
         : Grid(other_grid.width, other_grid.height, value) {}
 
     constexpr Grid(const Grid &other) = default;
     constexpr Grid(Grid &&other) noexcept = default;
 
+    /**
+     * Builds a grid from the lines of a text buffer, converting each character
+     * with `transform(ch)`, without copying the lines into strings first.
+     *
+     * The width is taken from the first line, and the grid ends at the first
+     * empty line or the end of the buffer. All rows must be the same width.
+     */
+    template <class Func>
+        requires std::convertible_to<std::invoke_result_t<Func &, char>,
+                                     value_type>
+    static Grid from_buffer(std::span<const char> buffer, Func &&transform,
+                            char newline = '\n') {
+        return from_buffer_impl(
+            buffer, newline,
+            [&transform](container_type &data, const char *row, size_type n) {
+                if constexpr (std::default_initializable<value_type>) {
+                    // avoid the capacity check in push_back
+                    const std::size_t offset = data.size();
+                    data.resize(offset + n);
+                    std::transform(row, row + n, data.begin() + offset,
+                                   transform);
+                } else {
+                    for (size_type x = 0; x < n; ++x) {
+                        data.push_back(transform(row[x]));
+                    }
+                }
+            });
+    }
+
+    /// Builds a character grid from the lines of a text buffer.
+    static Grid from_buffer(std::span<const char> buffer, char newline = '\n')
+        requires std::same_as<value_type, char>
+    {
+        return from_buffer_impl(
+            buffer, newline,
+            [](container_type &data, const char *row, size_type n) {
+                data.insert(data.end(), row, row + n);
+            });
+    }
+
+  private:
+    template <class AppendRow>
+    static Grid from_buffer_impl(std::span<const char> buffer, char newline,
+                                 AppendRow &&append_row) {
+        const std::string_view text(buffer.data(), buffer.size());
+        const std::size_t width = std::min(text.find(newline), text.size());
+        assert(width > 0);
+        container_type data;
+        // one extra row, in case the last line has no newline
+        data.reserve((text.size() / (width + 1) + 1) * width);
+        size_type height = 0;
+        for (std::size_t start = 0;
+             start < text.size() && text[start] != newline;
+             start += width + 1) {
+            assert(start + width <= text.size());
+            assert(start + width == text.size() ||
+                   text[start + width] == newline);
+            append_row(data, text.data() + start,
+                       static_cast<size_type>(width));
+            ++height;
+        }
+        return Grid(static_cast<size_type>(width), height, std::move(data));
+    }
+
+  public:
+
     constexpr Grid &operator=(const Grid &other) = default;
     constexpr Grid &operator=(Grid &&other) noexcept = default;
 
     constexpr inline std::size_t get_index(size_type x, size_type y) const {
-        return y * width + x;
+        return m_layout.index(x, y);
     }
     constexpr inline std::size_t get_index(const Pos &pos) const {
         return get_index(pos.x, pos.y);
     }
     constexpr Pos index_to_pos(std::size_t index) const {
-        return Pos(index % width, index / width);
+        return m_layout.pos(index);
     }
 
-    constexpr iterator begin() noexcept { return iterator(m_data, width); }
-    constexpr const_iterator begin() const noexcept {
+    // row iteration is only possible when rows are contiguous
+    constexpr iterator begin() noexcept
+        requires is_row_major
+    {
+        return iterator(m_data, width);
+    }
+    constexpr const_iterator begin() const noexcept
+        requires is_row_major
+    {
         return const_iterator(m_data, width);
     }
-    constexpr const_iterator cbegin() const noexcept {
+    constexpr const_iterator cbegin() const noexcept
+        requires is_row_major
+    {
         return const_iterator(m_data, width);
     }
 
-    constexpr iterator end() noexcept {
+    constexpr iterator end() noexcept
+        requires is_row_major
+    {
         return iterator(m_data, width, height);
     }
-    constexpr const_iterator end() const noexcept {
+    constexpr const_iterator end() const noexcept
+        requires is_row_major
+    {
         return const_iterator(m_data, width, height);
     }
-    constexpr const_iterator cend() const noexcept {
+    constexpr const_iterator cend() const noexcept
+        requires is_row_major
+    {
         return const_iterator(m_data, width, height);
     }
 
@@ -317,7 +626,8 @@ struct Grid {
         return m_data[get_index(pos.x, pos.y)];
     }
 
-    // raw indexing into data
+    // raw indexing into data (in storage order, which includes padding for
+    // layouts other than RowMajorLayout)
     constexpr reference at(std::size_t index) { return m_data.at(index); }
     constexpr const_reference at(std::size_t index) const {
         return m_data.at(index);
@@ -331,43 +641,38 @@ struct Grid {
     constexpr const container_type &data() const { return m_data; }
 
     /**
-     * Calls func(value[, pos]) for each position in the grid.
+     * Calls func(value[, pos]) for each position in the grid, in storage order
+     * (row-major for the default layout).
      */
     template <typename Func>
         requires std::invocable<Func, const value_type &, const Pos &> ||
                  std::invocable<Func, const value_type &>
     constexpr void for_each(Func &&func) const {
-        Pos p;
-        for (p.y = 0; p.y < height; ++p.y) {
-            for (p.x = 0; p.x < width; ++p.x) {
-                if constexpr (std::invocable<Func, const value_type &,
-                                             const Pos &>) {
-                    func((*this)[p], p);
-                } else {
-                    func((*this)[p]);
-                }
+        m_layout.visit([this, &func](int x, int y, std::size_t index) {
+            if constexpr (std::invocable<Func, const value_type &,
+                                         const Pos &>) {
+                func(m_data[index], Pos(x, y));
+            } else {
+                func(m_data[index]);
             }
-        }
+        });
     }
 
     /**
-     * Calls func(value[, pos]) for each position in the grid. Allows in-place
-     * modification of the value.
+     * Calls func(value[, pos]) for each position in the grid, in storage
+     * order. Allows in-place modification of the value.
      */
     template <typename Func>
         requires std::invocable<Func, value_type &, const Pos &> ||
                  std::invocable<Func, value_type &>
     constexpr void for_each(Func &&func) {
-        Pos p;
-        for (p.y = 0; p.y < height; ++p.y) {
-            for (p.x = 0; p.x < width; ++p.x) {
-                if constexpr (std::invocable<Func, value_type &, const Pos &>) {
-                    func((*this)[p], p);
-                } else {
-                    func((*this)[p]);
-                }
+        m_layout.visit([this, &func](int x, int y, std::size_t index) {
+            if constexpr (std::invocable<Func, value_type &, const Pos &>) {
+                func(m_data[index], Pos(x, y));
+            } else {
+                func(m_data[index]);
             }
-        }
+        });
     }
 
     /**
@@ -394,33 +699,106 @@ struct Grid {
         return os;
     }
 
+  private:
     /**
-     * Calls func(value[, pos]) for each position within the given Chebyshev
-     * (8-way) distance from center.
+     * Calls func(y, x_begin, x_end) for each row of a kernel around center,
+     * where [x_begin, x_end) is the in-bounds part of the row and
+     * half_width(dy) gives the row's extent on either side of center.x.
+     */
+    template <class HalfWidth, class Func>
+    constexpr void for_each_kernel_row(const Pos &center, int distance,
+                                       HalfWidth &&half_width,
+                                       Func &&func) const {
+        if (center.x >= distance && center.y >= distance &&
+            center.x + distance < width && center.y + distance < height) {
+            // the whole kernel is in bounds, so the loop bounds only depend
+            // on distance (which lets small kernels be fully unrolled)
+            for (int dy = -distance; dy <= distance; ++dy) {
+                const int x_extent = half_width(std::abs(dy));
+                func(center.y + dy, center.x - x_extent,
+                     center.x + x_extent + 1);
+            }
+            return;
+        }
+        const int y_end = std::min(height, center.y + distance + 1);
+        for (int y = std::max(0, center.y - distance); y < y_end; ++y) {
+            const int x_extent = half_width(std::abs(y - center.y));
+            const int x_begin = std::max(0, center.x - x_extent);
+            const int x_end = std::min(width, center.x + x_extent + 1);
+            if (x_begin < x_end) {
+                func(y, x_begin, x_end);
+            }
+        }
+    }
+
+    /// calls func(value[, pos[, metric(dx, dy)]]) for each cell of a kernel
+    template <class HalfWidth, class Metric, class Func>
+    constexpr void kernel_visit(const Pos &center, int distance,
+                                HalfWidth &&half_width, Metric &&metric,
+                                Func &&func) const {
+        const auto visit_row = [this, &center, &metric, &func](
+                                   int y, int x_begin, int x_end) {
+            const int dy = std::abs(y - center.y);
+            for (Pos pos(x_begin, y); pos.x < x_end; ++pos.x) {
+                if constexpr (std::invocable<Func, const value_type &,
+                                             const Pos &, int>) {
+                    func((*this)[pos], pos,
+                         metric(std::abs(pos.x - center.x), dy));
+                } else if constexpr (std::invocable<Func, const value_type &,
+                                                    const Pos &>) {
+                    func((*this)[pos], pos);
+                } else {
+                    func((*this)[pos]);
+                }
+            }
+        };
+        for_each_kernel_row(center, distance, half_width, visit_row);
+    }
+
+    /// accumulates proj(value) over a kernel, one contiguous run at a time
+    template <class R, class HalfWidth, class Proj>
+    constexpr R kernel_reduce(const Pos &center, int distance,
+                              HalfWidth &&half_width, Proj &&proj) const {
+        R total{};
+        for_each_kernel_row(
+            center, distance, half_width,
+            [this, &total, &proj](int y, int x_begin, int x_end) {
+                if constexpr (is_row_major) {
+                    // plain loop over contiguous memory, so this vectorizes
+                    const value_type *row = m_data.data() + get_index(0, y);
+                    R row_total{};
+                    for (int x = x_begin; x < x_end; ++x) {
+                        row_total += proj(row[x]);
+                    }
+                    total += row_total;
+                } else {
+                    for (int x = x_begin; x < x_end; ++x) {
+                        total += proj((*this)[Pos(x, y)]);
+                    }
+                }
+            });
+        return total;
+    }
+
+    static constexpr auto manhattan_extent(int distance) {
+        return [distance](int dy) { return distance - dy; };
+    }
+    static constexpr auto chebyshev_extent(int distance) {
+        return [distance](int) { return distance; };
+    }
+
+  public:
+    /**
+     * Calls func(value[, pos[, distance]]) for each position within the given
+     * Chebyshev (8-way) distance from center.
      */
     template <KernelFunc<value_type> Func>
     constexpr void chebyshev_kernel(const Pos &center, int distance,
                                     Func &&func) const {
-        Pos pos;
-        for (pos.y = center.y - distance; pos.y <= center.y + distance;
-             ++pos.y) {
-            for (pos.x = center.x - distance; pos.x <= center.x + distance;
-                 ++pos.x) {
-                if (in_bounds(pos)) {
-                    if constexpr (std::invocable<Func, const value_type &,
-                                                 const Pos &, int>) {
-                        func((*this)[pos], pos,
-                             (pos - center).chebyshev_distance());
-                    } else if constexpr (std::invocable<Func,
-                                                        const value_type &,
-                                                        const Pos &>) {
-                        func((*this)[pos], pos);
-                    } else {
-                        func((*this)[pos]);
-                    }
-                }
-            }
-        }
+        kernel_visit(
+            center, distance, chebyshev_extent(distance),
+            [](int dx, int dy) { return std::max(dx, dy); },
+            std::forward<Func>(func));
     }
 
     template <KernelFunc<value_type> Func>
@@ -435,31 +813,151 @@ struct Grid {
     template <KernelFunc<value_type> Func>
     constexpr void manhattan_kernel(const Pos &center, int distance,
                                     Func &&func) const {
-        Delta offset{0, 0};
-        for (offset.dy = -distance; offset.dy <= distance; ++offset.dy) {
-            int x_max = distance - std::abs(offset.dy);
-            for (offset.dx = -x_max; offset.dx <= x_max; ++offset.dx) {
-                Pos pos = center + offset;
-                if (in_bounds(pos)) {
-                    if constexpr (std::invocable<Func, const value_type &,
-                                                 const Pos &, int>) {
-                        func((*this)[pos], pos, offset.manhattan_distance());
-                    } else if constexpr (std::invocable<Func,
-                                                        const value_type &,
-                                                        const Pos &>) {
-                        func((*this)[pos], pos);
-                    } else {
-                        func((*this)[pos]);
-                    }
-                }
-            }
-        }
+        kernel_visit(
+            center, distance, manhattan_extent(distance),
+            [](int dx, int dy) { return dx + dy; }, std::forward<Func>(func));
     }
 
     template <KernelFunc<value_type> Func>
     constexpr void manhattan_kernel(const Pos &center, Func &&func) const {
         manhattan_kernel(center, 1, std::forward<Func>(func));
     }
+
+    /**
+     * Calls func(row_start, values) for each row of the given Chebyshev
+     * distance around center, where values is the in-bounds part of the row
+     * and row_start is the position of values[0].
+     */
+    template <std::invocable<const Pos &, std::span<const value_type>> Func>
+        requires is_row_major
+    constexpr void chebyshev_rows(const Pos &center, int distance,
+                                  Func &&func) const {
+        for_each_kernel_row(
+            center, distance, chebyshev_extent(distance),
+            [this, &func](int y, int x_begin, int x_end) {
+                func(Pos(x_begin, y),
+                     std::span<const value_type>(
+                         m_data.data() + get_index(x_begin, y),
+                         x_end - x_begin));
+            });
+    }
+
+    /**
+     * Calls func(row_start, values) for each row of the given Manhattan
+     * distance around center, where values is the in-bounds part of the row
+     * and row_start is the position of values[0].
+     */
+    template <std::invocable<const Pos &, std::span<const value_type>> Func>
+        requires is_row_major
+    constexpr void manhattan_rows(const Pos &center, int distance,
+                                  Func &&func) const {
+        for_each_kernel_row(
+            center, distance, manhattan_extent(distance),
+            [this, &func](int y, int x_begin, int x_end) {
+                func(Pos(x_begin, y),
+                     std::span<const value_type>(
+                         m_data.data() + get_index(x_begin, y),
+                         x_end - x_begin));
+            });
+    }
+
+    /**
+     * Returns the sum of proj(value) over every position within the given
+     * Chebyshev distance from center (including center itself).
+     */
+    template <class Proj>
+        requires std::invocable<Proj &, const value_type &>
+    constexpr auto chebyshev_sum(const Pos &center, int distance,
+                                 Proj &&proj) const {
+        using R = std::invoke_result_t<Proj &, const value_type &>;
+        return kernel_reduce<R>(center, distance, chebyshev_extent(distance),
+                                proj);
+    }
+
+    /**
+     * Returns the sum of proj(value) over every position within the given
+     * Manhattan distance from center (including center itself).
+     */
+    template <class Proj>
+        requires std::invocable<Proj &, const value_type &>
+    constexpr auto manhattan_sum(const Pos &center, int distance,
+                                 Proj &&proj) const {
+        using R = std::invoke_result_t<Proj &, const value_type &>;
+        return kernel_reduce<R>(center, distance, manhattan_extent(distance),
+                                proj);
+    }
+
+    /**
+     * Counts the positions within the given Chebyshev distance from center
+     * (including center itself) where pred(value) is true.
+     */
+    template <std::predicate<const value_type &> Pred>
+    constexpr int chebyshev_count(const Pos &center, int distance,
+                                  Pred &&pred) const {
+        return kernel_reduce<int>(
+            center, distance, chebyshev_extent(distance),
+            [&pred](const value_type &value) -> int { return pred(value); });
+    }
+
+    /**
+     * Counts the positions within the given Manhattan distance from center
+     * (including center itself) where pred(value) is true.
+     */
+    template <std::predicate<const value_type &> Pred>
+    constexpr int manhattan_count(const Pos &center, int distance,
+                                  Pred &&pred) const {
+        return kernel_reduce<int>(
+            center, distance, manhattan_extent(distance),
+            [&pred](const value_type &value) -> int { return pred(value); });
+    }
+
+    /**
+     * Returns a grid of the same size, where each position holds the number of
+     * positions within the given Chebyshev distance of it (including itself)
+     * where pred(value) is true.
+     *
+     * This is a box filter applied separably, first along each row with
+     * prefix sums and then down the columns with a running sum, so the cost
+     * doesn't depend on distance.
+     */
+    template <std::predicate<const value_type &> Pred>
+    Grid<int> chebyshev_counts(Pred &&pred, int distance = 1) const {
+        Grid<int> result(width, height, 0);
+        const int window_rows = 2 * distance + 1;
+        // horizontal counts for the last window_rows rows, as a ring buffer
+        std::vector<int> row_counts(window_rows * width, 0);
+        // running sum of the rows in row_counts
+        std::vector<int> window(width, 0);
+        std::vector<int> prefix(width + 1, 0);
+        for (int y_in = 0; y_in < height + distance; ++y_in) {
+            int *row = &row_counts[y_in % window_rows * width];
+            // remove the row that's leaving the window before overwriting it
+            if (y_in >= window_rows) {
+                for (int x = 0; x < width; ++x) {
+                    window[x] -= row[x];
+                }
+            }
+            if (y_in < height) {
+                // horizontal pass, using prefix sums
+                for (int x = 0; x < width; ++x) {
+                    prefix[x + 1] =
+                        prefix[x] + (pred((*this)[Pos(x, y_in)]) ? 1 : 0);
+                }
+                for (int x = 0; x < width; ++x) {
+                    row[x] = prefix[std::min(width, x + distance + 1)] -
+                             prefix[std::max(0, x - distance)];
+                    window[x] += row[x];
+                }
+            } else {
+                std::fill(row, row + width, 0);
+            }
+            if (y_in >= distance) {
+                std::copy(window.begin(), window.end(),
+                          &result[Pos(0, y_in - distance)]);
+            }
+        }
+        return result;
+    }
 };
 
 template <class T>
@@ -467,24 +965,110 @@ Grid(const std::vector<std::vector<T>> &) -> Grid<T>;
 template <class T>
 Grid(std::vector<std::vector<T>> &&) -> Grid<T>;
 
-template <class T>
-std::ostream &print_repr(std::ostream &os, const aoc::ds::Grid<T> &grid,
+/**
+ * Read-only character grid over the lines of an existing buffer, such as a
+ * memory-mapped input file. Nothing is copied, so the buffer must outlive the
+ * view.
+ */
+class GridView {
+    std::string_view m_text;
+    // distance between the starts of consecutive rows, including the newline
+    std::size_t m_stride;
+
+  public:
+    using value_type = char;
+    using size_type = int;
+
+    const size_type height;
+    const size_type width;
+
+    /**
+     * The width is taken from the first line, and the grid ends at the first
+     * empty line or the end of the buffer. All rows must be the same width.
+     */
+    explicit GridView(std::string_view text, char newline = '\n')
+        : m_text(text), m_stride(std::min(text.find(newline), text.size()) + 1),
+          height(count_rows(text, m_stride, newline)),
+          width(static_cast<size_type>(m_stride - 1)) {}
+
+  private:
+    static size_type count_rows(std::string_view text, std::size_t stride,
+                                char newline) {
+        size_type rows = 0;
+        for (std::size_t start = 0;
+             start < text.size() && text[start] != newline; start += stride) {
+            assert(start + stride - 1 <= text.size());
+            ++rows;
+        }
+        return rows;
+    }
+
+  public:
+    constexpr bool in_bounds(size_type x, size_type y) const noexcept {
+        return y >= 0 && x >= 0 && y < height && x < width;
+    }
+    constexpr bool in_bounds(const Pos &pos) const noexcept {
+        return in_bounds(pos.x, pos.y);
+    }
+
+    char operator[](const Pos &pos) const {
+        return m_text[pos.y * m_stride + pos.x];
+    }
+    char at(const Pos &pos) const {
+        if (!in_bounds(pos)) {
+            throw std::out_of_range("GridView::at");
+        }
+        return (*this)[pos];
+    }
+
+    std::string_view row(size_type y) const {
+        return m_text.substr(y * m_stride, width);
+    }
+
+    /// Copies the view into an owning grid.
+    Grid<char> to_grid() const {
+        return Grid<char>::from_buffer(m_text.substr(0, height * m_stride));
+    }
+
+    /**
+     * Calls func(value[, pos]) for each position in the grid.
+     */
+    template <typename Func>
+        requires std::invocable<Func, char, const Pos &> ||
+                 std::invocable<Func, char>
+    void for_each(Func &&func) const {
+        Pos p;
+        for (p.y = 0; p.y < height; ++p.y) {
+            for (p.x = 0; p.x < width; ++p.x) {
+                if constexpr (std::invocable<Func, char, const Pos &>) {
+                    func((*this)[p], p);
+                } else {
+                    func((*this)[p]);
+                }
+            }
+        }
+    }
+};
+
+template <class T, class Layout>
+std::ostream &print_repr(std::ostream &os,
+                         const aoc::ds::Grid<T, Layout> &grid,
                          const pretty_print::repr_state state) {
     // Get the current field width (from std::setw()) which we will use for the
     // individual values. Also set it to 0, as it shouldn't apply to the
     // initial '['.
     auto field_width = os.width(0);
-    for (int i = 0; const auto &row : grid) {
-        os << (i == 0 ? '[' : ' ') << '[';
-        for (int j = 0; const auto &value : row) {
-            if (j != 0) {
+    Pos pos;
+    for (pos.y = 0; pos.y < grid.height; ++pos.y) {
+        os << (pos.y == 0 ? '[' : ' ') << '[';
+        for (pos.x = 0; pos.x < grid.width; ++pos.x) {
+            if (pos.x != 0) {
                 os << " ";
             }
-            os << std::setw(field_width) << pretty_print::repr(value, state);
-            ++j;
+            os << std::setw(field_width)
+               << pretty_print::repr(grid[pos], state);
         }
-        ++i;
-        os << ']' << (i == grid.height ? "]" : ",\n");
+        os << ']' << (pos.y + 1 == grid.height ? "]" : ",\n");
     }
     return os;
 }
@@ -596,6 +1180,19 @@ constexpr bool _grid_lint_helper_constexpr() {
         grid.for_each([](int, Pos) {});
     }
 
+    // other storage layouts
+    {
+        static_assert(ZOrderLayout(4, 4).index(3, 1) == 0b0111);
+        static_assert(ZOrderLayout(8, 2).index(5, 1) == 0b1011);
+        static_assert(TiledLayout<4>(10, 7).index(5, 6) == 4 * 16 + 9);
+        Grid<int, TiledLayout<4>> tiled(10, 7, 1);
+        Grid<int, ZOrderLayout> z_order(tiled, 2);
+        static_assert(!std::ranges::range<decltype(tiled)>);
+        Pos pos(9, 6);
+        assert(tiled.index_to_pos(tiled.get_index(pos)) == pos);
+        assert(z_order.index_to_pos(z_order.get_index(pos)) == pos);
+    }
+
     // TODO: add checks for kernel functions
 
     // an iterator should be assignable to a const_iterator
@@ -612,8 +1209,8 @@ constexpr bool _grid_lint_helper_constexpr() {
 
 } // namespace aoc::ds
 
-template <class T>
-struct pretty_print::has_custom_print_repr<aoc::ds::Grid<T>>
+template <class T, class Layout>
+struct pretty_print::has_custom_print_repr<aoc::ds::Grid<T, Layout>>
     : pretty_print::has_any_print_repr<T> {};
 
 #endif /* end of include guard: GRID_HPP_EF9V6ZF8 */
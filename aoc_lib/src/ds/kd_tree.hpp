@@ -0,0 +1,224 @@
+#ifndef KD_TREE_HPP_J6WQ3RNB
+#define KD_TREE_HPP_J6WQ3RNB
+
+#include "lib.hpp"    // for GenericPos3
+#include <algorithm>  // for nth_element, min, max
+#include <concepts>   // for integral, predicate
+#include <cstddef>    // for size_t
+#include <functional> // for greater
+#include <optional>   // for optional
+#include <queue>      // for priority_queue
+#include <span>       // for span
+#include <tuple>      // for tuple
+#include <utility>    // for pair
+#include <vector>     // for vector
+
+namespace aoc::ds {
+
+/**
+ * Static 3-d tree over a set of points, for nearest-neighbor queries by
+ * squared Euclidean distance.
+ *
+ * Points are identified by their index in the input span. The tree is stored
+ * implicitly: each range of `m_nodes` is split around its middle element,
+ * cycling through the x, y and z axes with depth, down to small leaves.
+ */
+template <std::integral T>
+class kd_tree {
+  public:
+    using point_type = GenericPos3<T>;
+    using id_t = std::size_t;
+    /// (squared distance, id)
+    using neighbor_type = std::pair<long, id_t>;
+
+  private:
+    // ranges at most this long are scanned linearly instead of split further
+    static constexpr std::size_t LEAF_SIZE = 8;
+
+    std::vector<point_type> m_points;
+    // the points and their ids, in tree order
+    std::vector<std::pair<point_type, id_t>> m_nodes;
+
+    static T coord(const point_type &p, int axis) {
+        return axis == 0 ? p.x : axis == 1 ? p.y : p.z;
+    }
+
+    void build(std::size_t lo, std::size_t hi, int axis) {
+        if (hi - lo <= LEAF_SIZE) {
+            return;
+        }
+        std::size_t mid = lo + (hi - lo) / 2;
+        std::nth_element(m_nodes.begin() + lo, m_nodes.begin() + mid,
+                         m_nodes.begin() + hi,
+                         [axis](const auto &a, const auto &b) {
+                             return coord(a.first, axis) <
+                                    coord(b.first, axis);
+                         });
+        build(lo, mid, (axis + 1) % 3);
+        build(mid + 1, hi, (axis + 1) % 3);
+    }
+
+    // max-heap of the best k candidates found so far
+    using result_heap = std::priority_queue<neighbor_type>;
+
+    template <class Pred>
+    static void add_candidate(const point_type &query, std::size_t k,
+                              Pred &pred,
+                              const std::pair<point_type, id_t> &node,
+                              result_heap &best) {
+        if (!pred(node.second)) {
+            return;
+        }
+        neighbor_type candidate{(node.first - query).euclidean_distance_sq(),
+                                node.second};
+        if (best.size() < k) {
+            best.push(candidate);
+        } else if (candidate < best.top()) {
+            best.pop();
+            best.push(candidate);
+        }
+    }
+
+    template <class Pred>
+    void search(const point_type &query, std::size_t k, Pred &pred,
+                std::size_t lo, std::size_t hi, int axis,
+                result_heap &best) const {
+        if (hi - lo <= LEAF_SIZE) {
+            for (std::size_t i = lo; i < hi; ++i) {
+                add_candidate(query, k, pred, m_nodes[i], best);
+            }
+            return;
+        }
+        std::size_t mid = lo + (hi - lo) / 2;
+        add_candidate(query, k, pred, m_nodes[mid], best);
+        const long diff = static_cast<long>(coord(query, axis)) -
+                          coord(m_nodes[mid].first, axis);
+        const int next_axis = (axis + 1) % 3;
+        // search the side containing the query first, so the other side is
+        // more likely to be pruned
+        if (diff < 0) {
+            search(query, k, pred, lo, mid, next_axis, best);
+        } else {
+            search(query, k, pred, mid + 1, hi, next_axis, best);
+        }
+        if (best.size() < k || diff * diff <= best.top().first) {
+            if (diff < 0) {
+                search(query, k, pred, mid + 1, hi, next_axis, best);
+            } else {
+                search(query, k, pred, lo, mid, next_axis, best);
+            }
+        }
+    }
+
+  public:
+    explicit kd_tree(std::span<const point_type> points)
+        : m_points(points.begin(), points.end()) {
+        m_nodes.reserve(points.size());
+        for (id_t id = 0; id < points.size(); ++id) {
+            m_nodes.emplace_back(points[id], id);
+        }
+        build(0, m_nodes.size(), 0);
+    }
+
+    std::size_t size() const { return m_points.size(); }
+    const point_type &operator[](id_t id) const { return m_points[id]; }
+
+    /**
+     * Returns the (up to) k nearest points to `query` for which `pred(id)` is
+     * true, sorted by distance, then id.
+     */
+    template <std::predicate<id_t> Pred>
+    std::vector<neighbor_type> k_nearest(const point_type &query,
+                                         std::size_t k, Pred &&pred) const {
+        result_heap best;
+        if (k > 0) {
+            search(query, k, pred, 0, m_nodes.size(), 0, best);
+        }
+        std::vector<neighbor_type> result(best.size());
+        for (auto it = result.rbegin(); it != result.rend(); ++it) {
+            *it = best.top();
+            best.pop();
+        }
+        return result;
+    }
+
+    std::vector<neighbor_type> k_nearest(const point_type &query,
+                                         std::size_t k) const {
+        return k_nearest(query, k, [](id_t) { return true; });
+    }
+};
+
+/**
+ * Streams all pairs of points in order of increasing squared distance,
+ * without materializing all O(n^2) of them.
+ *
+ * Each point keeps a cached list of its nearest neighbors from a kd_tree,
+ * which is re-queried with twice as many neighbors when it runs out, and a
+ * heap holds the next unseen neighbor of every point. Taking the first m
+ * pairs costs roughly O((n + m) log n).
+ */
+template <std::integral T>
+class closest_pairs {
+  public:
+    using point_type = GenericPos3<T>;
+    using id_t = std::size_t;
+    /// (squared distance, id1, id2), with id1 < id2
+    using value_type = std::tuple<long, id_t, id_t>;
+
+  private:
+    kd_tree<T> m_tree;
+    std::vector<std::vector<typename kd_tree<T>::neighbor_type>> m_neighbors;
+    // index of the next neighbor of each point to push onto the heap
+    std::vector<std::size_t> m_next;
+    std::priority_queue<value_type, std::vector<value_type>,
+                        std::greater<value_type>>
+        m_heap{};
+
+    /// pushes the next nearest neighbor of a point, if there are any left
+    void push_next(id_t id) {
+        auto &neighbors = m_neighbors[id];
+        if (m_next[id] == neighbors.size()) {
+            const std::size_t max_k = m_tree.size() - 1;
+            if (neighbors.size() == max_k) {
+                return;
+            }
+            neighbors = m_tree.k_nearest(
+                m_tree[id],
+                std::min(max_k, std::max<std::size_t>(1, 2 * neighbors.size())),
+                [id](id_t other) { return other != id; });
+        }
+        const auto &[dist_sq, other] = neighbors[m_next[id]++];
+        m_heap.emplace(dist_sq, id, other);
+    }
+
+  public:
+    explicit closest_pairs(std::span<const point_type> points,
+                           std::size_t initial_k = 4)
+        : m_tree(points), m_neighbors(points.size()), m_next(points.size()) {
+        for (id_t id = 0; id < points.size(); ++id) {
+            m_neighbors[id] = m_tree.k_nearest(
+                m_tree[id], initial_k,
+                [id](id_t other) { return other != id; });
+            push_next(id);
+        }
+    }
+
+    /// returns the next closest pair, or nothing once all have been returned
+    std::optional<value_type> next() {
+        while (!m_heap.empty()) {
+            value_type top = m_heap.top();
+            m_heap.pop();
+            const auto &[dist_sq, id1, id2] = top;
+            push_next(id1);
+            // each pair comes up once from each end, so only keep one
+            if (id1 < id2) {
+                return top;
+            }
+        }
+        return std::nullopt;
+    }
+};
+
+} // namespace aoc::ds
+
+#endif /* end of include guard: KD_TREE_HPP_J6WQ3RNB */
@@ -5,14 +5,17 @@
 #include <cassert>          // for assert
 #include <concepts>         // for predicate
 #include <cstddef>          // for size_t
+#include <cstdint>          // for uint32_t
 #include <functional>       // for less, greater
 #include <initializer_list> // for initializer_list
 #include <iterator>         // for next, advance, iterator_traits
+#include <limits>           // for numeric_limits
 #include <list>             // for list
 #include <memory> // for shared_ptr, weak_ptr, make_shared, enable_shared_from_this
 #include <string>      // for string
 #include <type_traits> // for is_same_v
 #include <utility>     // for move, swap, forward, pair
+#include <vector>      // for vector
 
 namespace aoc::ds {
 
@@ -290,6 +293,241 @@ pairing_heap(InputIt, InputIt, const Compare & = Compare())
     -> pairing_heap<typename std::iterator_traits<InputIt>::value_type,
                     Compare>;
 
+/**
+ * Pairing heap with the same interface as pairing_heap, but with all the nodes
+ * stored in a contiguous pool and referred to by 32-bit indices.
+ *
+ * Nodes are never freed individually: popped nodes stay in the pool until
+ * clear() is called, which makes it O(1) and keeps the pool's memory around
+ * for reuse (e.g. across multiple searches). Handles are invalidated by
+ * clear(), and a handle must not be passed to update() after its element has
+ * been popped.
+ */
+template <class T, std::predicate<T, T> Compare = std::less<T>>
+class pooled_pairing_heap {
+  public:
+    using value_compare = Compare;
+    using value_type = T;
+    using size_type = std::size_t;
+    using reference = value_type &;
+    using const_reference = const value_type &;
+    using handle_type = std::uint32_t;
+
+  private:
+    static constexpr handle_type NIL = std::numeric_limits<handle_type>::max();
+
+    struct pair_node {
+        value_type element;
+        handle_type first_child = NIL;
+        handle_type next_sibling = NIL;
+        // parent if this is the leftmost child, otherwise the left sibling
+        handle_type prev = NIL;
+
+        template <class... Args>
+        explicit pair_node(Args &&...args)
+            : element(std::forward<Args>(args)...) {}
+    };
+
+    value_compare _m_comp;
+    size_type _m_size;
+    handle_type root;
+    // number of slots in m_nodes that are in use; slots past this are left
+    // over from before the last clear() and get reused by new_node()
+    size_type m_node_count;
+    std::vector<pair_node> m_nodes;
+    // scratch space for pop()
+    std::vector<handle_type> m_children;
+
+    template <class... Args>
+    handle_type new_node(Args &&...args) {
+        assert(m_node_count < NIL);
+        handle_type index = m_node_count++;
+        if (index < m_nodes.size()) {
+            m_nodes[index] = pair_node(std::forward<Args>(args)...);
+        } else {
+            m_nodes.emplace_back(std::forward<Args>(args)...);
+        }
+        return index;
+    }
+
+    /**
+     * Links two detached trees, and returns the new root.
+     */
+    handle_type link(handle_type a, handle_type b) {
+        if (_m_comp(m_nodes[a].element, m_nodes[b].element)) {
+            std::swap(a, b);
+        }
+        // insert b as the leftmost child of a
+        pair_node &parent = m_nodes[a];
+        pair_node &child = m_nodes[b];
+        assert(child.next_sibling == NIL && child.prev == NIL);
+        child.next_sibling = parent.first_child;
+        if (parent.first_child != NIL) {
+            m_nodes[parent.first_child].prev = b;
+        }
+        child.prev = a;
+        parent.first_child = b;
+        return a;
+    }
+
+    /**
+     * Detaches a non-root node (and its subtree) from the tree.
+     */
+    void extract(handle_type index) {
+        pair_node &node = m_nodes[index];
+        assert(node.prev != NIL);
+        pair_node &previous = m_nodes[node.prev];
+        if (previous.first_child == index) {
+            // we're the leftmost child of our parent
+            previous.first_child = node.next_sibling;
+        } else {
+            previous.next_sibling = node.next_sibling;
+        }
+        if (node.next_sibling != NIL) {
+            m_nodes[node.next_sibling].prev = node.prev;
+        }
+        node.next_sibling = NIL;
+        node.prev = NIL;
+    }
+
+    void meld(handle_type other_root) {
+        root = root == NIL ? other_root : link(root, other_root);
+    }
+
+    /**
+     * Removes the root node from the tree, without touching the size.
+     */
+    void remove_root() {
+        // detach all the children of the root node
+        m_children.clear();
+        for (handle_type child = m_nodes[root].first_child; child != NIL;) {
+            pair_node &node = m_nodes[child];
+            m_children.push_back(child);
+            child = node.next_sibling;
+            node.next_sibling = NIL;
+            node.prev = NIL;
+        }
+        m_nodes[root].first_child = NIL;
+        root = NIL;
+        // left-to-right pass, meld consecutive pairs of child nodes
+        std::size_t paired_count = 0;
+        for (std::size_t i = 0; i + 1 < m_children.size(); i += 2) {
+            m_children[paired_count++] =
+                link(m_children[i], m_children[i + 1]);
+        }
+        if (m_children.size() % 2 == 1) {
+            m_children[paired_count++] = m_children.back();
+        }
+        // right-to-left pass, meld all the nodes together
+        while (paired_count > 0) {
+            meld(m_children[--paired_count]);
+        }
+    }
+
+  public:
+    // default constructor
+    pooled_pairing_heap() : pooled_pairing_heap(value_compare()) {}
+    explicit pooled_pairing_heap(const value_compare &compare)
+        : _m_comp(compare), _m_size(0), root(NIL), m_node_count(0),
+          m_nodes(), m_children() {}
+
+    /// Constructs a heap with the contents of the range [`first`, `last`).
+    template <class InputIt>
+    pooled_pairing_heap(InputIt first, InputIt last,
+                        const value_compare &compare = value_compare())
+        : pooled_pairing_heap(compare) {
+        for (; first != last; ++first) {
+            emplace(*first);
+        }
+    }
+
+    /// Constructs a heap from an initializer list.
+    pooled_pairing_heap(std::initializer_list<value_type> init,
+                        const value_compare &compare = value_compare())
+        : pooled_pairing_heap(init.begin(), init.end(), compare) {}
+
+    /// Returns a reference to the top element in the heap.
+    const_reference top() const { return m_nodes[root].element; }
+
+    /// Returns the element held by `handle`.
+    const_reference value(handle_type handle) const {
+        return m_nodes[handle].element;
+    }
+
+    /// Checks whether the heap is empty.
+    [[nodiscard]] bool empty() const { return _m_size == 0; }
+
+    /// Returns the number of elements in the heap.
+    size_type size() const { return _m_size; }
+
+    /// Reserves space in the pool for at least `new_cap` pushes.
+    void reserve(size_type new_cap) { m_nodes.reserve(new_cap); }
+
+    /**
+     * Removes all the elements from the heap in O(1), invalidating all
+     * handles. The pool's storage is kept for reuse.
+     */
+    void clear() {
+        _m_size = 0;
+        root = NIL;
+        m_node_count = 0;
+    }
+
+    /**
+     * Inserts an element into the heap.
+     */
+    handle_type push(const value_type &value) { return emplace(value); }
+
+    /**
+     * Moves an element into the heap.
+     */
+    handle_type push(value_type &&value) { return emplace(std::move(value)); }
+
+    /**
+     * Constructs an element in-place and inserts it into the heap.
+     */
+    template <class... Args>
+    handle_type emplace(Args &&...args) {
+        handle_type node = new_node(std::forward<Args>(args)...);
+        meld(node);
+        ++_m_size;
+        return node;
+    }
+
+    /**
+     * Removes the top element from the heap.
+     */
+    void pop() {
+        assert(root != NIL);
+        remove_root();
+        --_m_size;
+    }
+
+    /**
+     * Assigns v to the element handled by `handle` and updates the heap.
+     */
+    void update(handle_type handle, const value_type &value) {
+        assert(handle < m_node_count);
+        if (handle == root) {
+            // to update the root node, we need to remove it like in pop
+            remove_root();
+        } else {
+            // remove the node from the tree
+            extract(handle);
+        }
+        // update the element contained in the node
+        m_nodes[handle].element = value;
+        meld(handle);
+    }
+};
+
+template <class InputIt,
+          class Compare =
+              std::less<typename std::iterator_traits<InputIt>::value_type>>
+pooled_pairing_heap(InputIt, InputIt, const Compare & = Compare())
+    -> pooled_pairing_heap<typename std::iterator_traits<InputIt>::value_type,
+                           Compare>;
+
 // instantiate templates in a non-templated helper function, so static
 // analyzers will check these functions
 namespace test {
@@ -311,6 +549,18 @@ namespace test {
     static_assert(std::is_same_v<decltype(h3a), decltype(h3b)>);
 
     pairing_heap<std::pair<int, int *>, std::greater<std::pair<int, int *>>> h4;
+
+    pooled_pairing_heap<int> h5a;
+    pooled_pairing_heap h5b{1, 2, 3, 4};
+    static_assert(std::is_same_v<decltype(h5a), decltype(h5b)>);
+    pooled_pairing_heap h5c(lst.begin(), lst.end());
+    static_assert(
+        std::is_same_v<decltype(h5c),
+                       pooled_pairing_heap<std::pair<int, std::string>>>);
+    h5b.reserve(10);
+    h5b.update(h5b.push(5), 0);
+    h5b.pop();
+    h5b.clear();
 }
 } // namespace test
 
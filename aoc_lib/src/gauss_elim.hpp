@@ -10,16 +10,23 @@
 
 #include "ds/grid.hpp"   // for Grid
 #include "lib.hpp"       // for DEBUG
+#include "util/math.hpp" // for signed_integer, gcd
 #include "util/util.hpp" // for always_false // IWYU pragma: keep
+#include <algorithm>     // for swap_ranges, copy
 #include <cassert>       // for assert
-#include <concepts>      // for signed_integral, floating_point
+#include <climits>       // for CHAR_BIT
+#include <cmath>         // for log2
+#include <concepts>      // for signed_integral, floating_point, same_as
 #include <cstdlib>       // for size_t, abs
+#include <iomanip>       // for setw
 #include <iostream>      // for ostream, cerr
-#include <numeric>       // for gcd
+#include <limits>        // for numeric_limits
+#include <numeric>       // for lcm
 #include <optional>      // for optional
+#include <span>          // for span
+#include <stdexcept>     // for overflow_error
 #include <utility>       // for swap
 #include <vector>        // for vector
-// IWYU pragma: no_include <algorithm>  // for fill_n
 
 namespace aoc::math {
 struct RowPermuter {
@@ -125,6 +132,161 @@ struct RowPermuter {
 };
 
 namespace detail {
+
+/**
+ * A linear system A x = b stored with each row of A contiguous (`stride`
+ * elements apart), and the entries of b `rhs_stride` elements apart. This
+ * covers both a Grid and a separate vector (rhs_stride = 1), and the augmented
+ * rows [A | b] of a SystemBatch.
+ *
+ * Rows are swapped by moving their contents, rather than through a
+ * RowPermuter, so the row update loops below work on plain spans and can be
+ * vectorized.
+ */
+template <class T>
+struct SystemView {
+    T *data;
+    int rows;
+    int cols;
+    std::size_t stride;
+    T *rhs;
+    std::size_t rhs_stride;
+
+    SystemView(aoc::ds::Grid<T> &A, std::vector<T> &b)
+        : data(A.data().data()), rows(A.height), cols(A.width),
+          stride(A.width), rhs(b.data()), rhs_stride(1) {
+        assert(b.size() == static_cast<std::size_t>(rows));
+    }
+    SystemView(T *data, int rows, int cols)
+        : data(data), rows(rows), cols(cols), stride(cols + 1),
+          rhs(data + cols), rhs_stride(cols + 1) {}
+
+    std::span<T> row(int r) const {
+        return {data + r * stride, static_cast<std::size_t>(cols)};
+    }
+    T &operator()(int r, int c) const { return data[r * stride + c]; }
+    T &b(int r) const { return rhs[r * rhs_stride]; }
+
+    void swap_rows(int i, int j) const {
+        if (i != j) {
+            if constexpr (aoc::DEBUG) {
+                std::cerr << "swapping rows " << i << " and " << j << "\n";
+            }
+            std::ranges::swap_ranges(row(i), row(j));
+            std::swap(b(i), b(j));
+        }
+    }
+
+    void pretty_print(std::ostream &os) const {
+        auto field_width = os.width(0);
+        for (int r = 0; r < rows; ++r) {
+            os << (r == 0 ? '[' : ' ') << '[';
+            for (int c = 0; c < cols; ++c) {
+                if (c != 0) {
+                    os << " ";
+                }
+                os << std::setw(field_width)
+                   << pretty_print::repr((*this)(r, c));
+            }
+            os << " | " << std::setw(field_width) << pretty_print::repr(b(r));
+            os << ']' << (r == rows - 1 ? "]" : ",\n");
+        }
+        os << "\n";
+    }
+};
+
+// Row update kernels. The rows passed in never overlap, which __restrict
+// tells the compiler so it can vectorize without a runtime aliasing check.
+
+/// dst -= m * src
+template <class T>
+void row_sub_scaled(std::span<T> dst, std::span<const T> src, T m) {
+    assert(dst.size() == src.size());
+    T *__restrict d = dst.data();
+    const T *__restrict s = src.data();
+    const std::size_t n = dst.size();
+    for (std::size_t k = 0; k < n; ++k) {
+        d[k] -= m * s[k];
+    }
+}
+
+/**
+ * Returns a * x - c * y. If CHECKED is set, any overflow sets `overflow`
+ * (and the result is meaningless) instead of being undefined behavior.
+ */
+template <bool CHECKED, class T>
+T cross_sub(T a, T x, T c, T y, bool &overflow) {
+    if constexpr (CHECKED) {
+        T ax, cy, result;
+        overflow |= __builtin_mul_overflow(a, x, &ax);
+        overflow |= __builtin_mul_overflow(c, y, &cy);
+        overflow |= __builtin_sub_overflow(ax, cy, &result);
+        return result;
+    } else {
+        return a * x - c * y;
+    }
+}
+
+/**
+ * dst = a * dst - c * src. Returns true if anything overflowed, which is
+ * only checked if CHECKED is set.
+ */
+template <bool CHECKED = false, class T>
+bool row_cross_sub(std::span<T> dst, T a, std::span<const T> src, T c) {
+    assert(dst.size() == src.size());
+    T *__restrict d = dst.data();
+    const T *__restrict s = src.data();
+    const std::size_t n = dst.size();
+    // accumulate the flag rather than exiting early, to keep the loop simple
+    bool overflow = false;
+    for (std::size_t k = 0; k < n; ++k) {
+        d[k] = cross_sub<CHECKED>(a, d[k], c, s[k], overflow);
+    }
+    return overflow;
+}
+
+/// row /= divisor, which must divide every entry exactly for integers
+template <class T>
+void row_div(std::span<T> row, T divisor) {
+    for (T &x : row) {
+        if constexpr (signed_integer<T>) {
+            assert(x % divisor == 0);
+        }
+        x /= divisor;
+    }
+}
+
+/// Returns the dot product of two rows.
+template <class T>
+T row_dot(std::span<const T> lhs, std::span<const T> rhs) {
+    assert(lhs.size() == rhs.size());
+    T sum = 0;
+    for (std::size_t k = 0; k < lhs.size(); ++k) {
+        sum += lhs[k] * rhs[k];
+    }
+    return sum;
+}
+
+/**
+ * Returns the GCD of row r (from column `col` on) and b[r], stopping early
+ * once it reaches 1.
+ */
+template <signed_integer T>
+T row_content(const SystemView<T> &s, int r, int col = 0) {
+    T factor = s.b(r);
+    for (int j = col; j < s.cols && factor != 1; ++j) {
+        factor = aoc::math::gcd(factor, s(r, j));
+    }
+    return factor;
+}
+
+template <signed_integer T>
+void scale_row(const SystemView<T> &s, int r, T factor) {
+    assert(s.b(r) % factor == 0);
+    s.b(r) /= factor;
+    row_div(s.row(r), factor);
+}
+
 /**
  * Partial pivot at row i, swapping with the row with the maximum absolute value
  * in that column.
@@ -132,12 +294,11 @@ namespace detail {
  * Returns false if no non-zero pivot was found.
  */
 template <class T>
-bool partial_pivot_max(const aoc::ds::Grid<T> &A, RowPermuter &rp,
-                       std::size_t i) {
-    std::size_t pivot = i;
-    T max_value = std::abs(rp(A, i, i));
-    for (std::size_t j = i; j < rp.size(); ++j) {
-        T curr_value = std::abs(rp(A, j, i));
+bool partial_pivot_max(const SystemView<T> &s, int i) {
+    int pivot = i;
+    T max_value = std::abs(s(i, i));
+    for (int j = i + 1; j < s.rows; ++j) {
+        T curr_value = std::abs(s(j, i));
         if (curr_value > max_value) {
             max_value = curr_value;
             pivot = j;
@@ -146,141 +307,104 @@ bool partial_pivot_max(const aoc::ds::Grid<T> &A, RowPermuter &rp,
     if (max_value == 0) {
         return false;
     }
-    rp.swap_rows(i, pivot);
+    s.swap_rows(i, pivot);
     return true;
 }
 
 /**
  * Partial pivot at column `col`, swapping with the first row with a non-zero
- * value past `row`.
+ * value starting at `row`.
  *
  * Returns false if no non-zero pivot was found.
  */
 template <class T>
-bool partial_pivot_first(const aoc::ds::Grid<T> &A, RowPermuter &rp,
-                         std::size_t col, long row = -1) {
-    if (row == -1) {
-        row = col;
-    }
-    std::size_t pivot;
-    for (pivot = row; pivot < rp.size(); ++pivot) {
-        if (rp(A, pivot, col) != 0) {
+bool partial_pivot_first(const SystemView<T> &s, int col, int row) {
+    int pivot;
+    for (pivot = row; pivot < s.rows; ++pivot) {
+        if (s(pivot, col) != 0) {
             break;
         }
     }
-    if (pivot == rp.size()) {
+    if (pivot == s.rows) {
         return false;
     }
-    rp.swap_rows(row, pivot);
-    if constexpr (aoc::DEBUG) {
-        if (col != pivot) {
-            std::cerr << std::setw(2);
-            rp.pretty_print(std::cerr, A);
-        }
-    }
+    s.swap_rows(row, pivot);
     return true;
 }
 
-} // namespace detail
-
-/**
- * Standard Gaussian elimination on floating-point numbers.
- */
 template <std::floating_point T>
-std::optional<RowPermuter> gauss_elim_floating_point(aoc::ds::Grid<T> &A,
-                                                     std::vector<T> &b) {
-    std::size_t n = A.height;
-    assert(b.size() == n);
-    assert(A.width == static_cast<int>(n));
-    RowPermuter rp(n);
+bool row_echelon(const SystemView<T> &s) {
+    const int n = s.rows;
+    assert(s.cols == n);
 
-    for (std::size_t i = 0; i < n - 1; ++i) {
-        if (!detail::partial_pivot_max(A, rp, i)) {
-            return {};
+    for (int i = 0; i < n - 1; ++i) {
+        if (!partial_pivot_max(s, i)) {
+            return false;
         }
-        for (std::size_t j = i + 1; j < n; ++j) {
-            T m = rp(A, j, i) / rp(A, i, i);
-            rp(A, j, i) = 0;
-            rp(b, j) -= m * rp(b, i);
-            for (std::size_t k = i + 1; k < n; ++k) {
-                rp(A, j, k) -= m * rp(A, i, k);
-            }
+        const std::span<const T> pivot_row = s.row(i).subspan(i + 1);
+        for (int j = i + 1; j < n; ++j) {
+            T m = s(j, i) / s(i, i);
+            s(j, i) = 0;
+            s.b(j) -= m * s.b(i);
+            row_sub_scaled(s.row(j).subspan(i + 1), pivot_row, m);
         }
     }
-
-    return rp;
+    return n == 0 || s(n - 1, n - 1) != 0;
 }
 
 /**
  * Fraction-free Gaussian elimination with partial pivoting, following Turner
  * 1995, "A simplified fraction-free integer Gauss elimination algorithm"
  * (https://apps.dtic.mil/sti/citations/ADA313755)
+ *
+ * If CHECKED is set and any intermediate value doesn't fit in T, sets
+ * `*overflow` and returns false.
  */
-template <std::signed_integral T>
-std::optional<RowPermuter> gauss_elim_fraction_free(aoc::ds::Grid<T> &A,
-                                                    std::vector<T> &b) {
-    std::size_t n = A.height;
-    assert(b.size() == n);
-    assert(A.width == static_cast<int>(n));
-    RowPermuter rp(n);
-
-    for (std::size_t i = 0; i < n; ++i) {
-        if (!detail::partial_pivot_first(A, rp, i)) {
-            return {};
-        }
-        const T &Aii = rp(A, i, i);
-        for (std::size_t j = i + 1; j < n; ++j) {
-            T &Aji = rp(A, j, i);
-            rp(b, j) = Aii * rp(b, j) - Aji * rp(b, i);
-            for (std::size_t k = i + 1; k < n; ++k) {
-                rp(A, j, k) = Aii * rp(A, j, k) - Aji * rp(A, i, k);
+template <bool CHECKED = false, signed_integer T>
+bool row_echelon(const SystemView<T> &s, bool *overflow_out = nullptr) {
+    const int n = s.rows;
+    assert(s.cols == n);
+    assert(!CHECKED || overflow_out != nullptr);
+
+    // the previous pivot, before its row was reduced, which divides every
+    // entry below it after the next elimination step
+    T prev_pivot = 1;
+    for (int i = 0; i < n; ++i) {
+        if (!partial_pivot_first(s, i, i)) {
+            return false;
+        }
+        const T Aii = s(i, i);
+        const std::span<const T> pivot_row = s.row(i).subspan(i + 1);
+        bool overflow = false;
+        for (int j = i + 1; j < n; ++j) {
+            const T Aji = s(j, i);
+            s.b(j) = cross_sub<CHECKED>(Aii, s.b(j), Aji, s.b(i), overflow);
+            overflow |= row_cross_sub<CHECKED>(s.row(j).subspan(i + 1), Aii,
+                                               pivot_row, Aji);
+            if (CHECKED && overflow) {
+                *overflow_out = true;
+                return false;
             }
-            Aji = 0;
-        }
-        // remove known common factor: previous diagonal
-        if (i >= 1) {
-            const T &denom = rp(A, i - 1, i - 1);
-            for (std::size_t j = i + 1; j < n; ++j) {
-                rp(b, j) /= denom;
-                for (std::size_t k = i + 1; k < n; ++k) {
-                    rp(A, j, k) /= denom;
-                }
+            s(j, i) = 0;
+            // remove known common factor: previous pivot
+            if (prev_pivot != 1) {
+                s.b(j) /= prev_pivot;
+                row_div(s.row(j).subspan(i + 1), prev_pivot);
             }
         }
+        prev_pivot = Aii;
         // remove all common factors from row i
-        T factor = rp(b, i);
-        for (std::size_t j = i; j < n; ++j) {
-            if (factor == 1) {
-                // exit early if there are no common factors
-                break;
-            }
-            factor = std::gcd(factor, rp(A, i, j));
-        }
+        T factor = row_content(s, i, i);
         if (factor > 1) {
-            rp(b, i) /= factor;
-            for (std::size_t j = 1; j < n; ++j) {
-                rp(A, i, j) /= factor;
-            }
-            if constexpr (aoc::DEBUG) {
+            scale_row(s, i, factor);
+            // (iostreams can't print __int128)
+            if constexpr (aoc::DEBUG && std::signed_integral<T>) {
                 std::cerr << "reduced row " << i << " by a common factor of "
                           << factor << "\n";
             }
         }
     }
-
-    return rp;
-}
-
-template <class T>
-std::optional<RowPermuter> gauss_elim(aoc::ds::Grid<T> &A, std::vector<T> &b) {
-    if constexpr (std::signed_integral<T>) {
-        return gauss_elim_fraction_free(A, b);
-    } else if constexpr (std::floating_point<T>) {
-        return gauss_elim_floating_point(A, b);
-    } else {
-        static_assert(util::always_false<T>,
-                      "data type must be signed integral or floating-point");
-    }
+    return true;
 }
 
 /**
@@ -289,222 +413,347 @@ std::optional<RowPermuter> gauss_elim(aoc::ds::Grid<T> &A, std::vector<T> &b) {
  * Based on https://www.statlect.com/matrix-algebra/Gauss-Jordan-elimination.
  */
 template <std::floating_point T>
-std::optional<RowPermuter> gauss_jordan_floating_point(aoc::ds::Grid<T> &A,
-                                                       std::vector<T> &b) {
-    int rows = A.height;
-    int cols = A.width;
-    assert(b.size() == static_cast<std::size_t>(rows));
-    RowPermuter rp(rows);
-
-    for (int row = 0, col = 0; row < rows && col < cols; ++row, ++col) {
-        while (rp(A, row, col) == 0 &&
-               !detail::partial_pivot_first(A, rp, col, row)) {
+int reduced_row_echelon(const SystemView<T> &s) {
+    int row = 0;
+    for (int col = 0; row < s.rows && col < s.cols; ++row, ++col) {
+        while (s(row, col) == 0 && !partial_pivot_first(s, col, row)) {
             if constexpr (aoc::DEBUG) {
                 std::cerr << "skipping column " << col << "\n";
             }
             ++col;
-            if (col >= cols) {
-                return rp;
+            if (col >= s.cols) {
+                return row;
             }
         }
         // normalize diagonal element to 1
-        assert(rp(A, row, col) != 0);
-        T f = rp(A, row, col);
-        if (rp(b, row) != 0) {
-            rp(b, row) /= f;
-        }
-        for (int tmp = col; tmp < cols; ++tmp) {
-            auto &x = rp(A, row, tmp);
-            if (x != 0) {
-                x /= f;
-            }
-        }
-        assert(rp(A, row, col) == 1);
-        for (int r = 0; r < rows; ++r) {
-            if (r == row) {
-                // skip current row
+        assert(s(row, col) != 0);
+        T f = s(row, col);
+        if (s.b(row) != 0) {
+            s.b(row) /= f;
+        }
+        for (T &x : s.row(row).subspan(col)) {
+            x /= f;
+        }
+        assert(s(row, col) == 1);
+        const std::span<const T> pivot_row = s.row(row).subspan(col + 1);
+        for (int r = 0; r < s.rows; ++r) {
+            f = s(r, col);
+            if (r == row || f == 0) {
                 continue;
             }
-            f = rp(A, r, col);
-            rp(A, r, col) = 0;
-            rp(b, r) -= f * rp(b, row);
-            for (int tmp = col + 1; tmp < cols; ++tmp) {
-                rp(A, r, tmp) -= f * rp(A, row, tmp);
-            }
+            s(r, col) = 0;
+            s.b(r) -= f * s.b(row);
+            row_sub_scaled(s.row(r).subspan(col + 1), pivot_row, f);
         }
         if constexpr (aoc::DEBUG) {
             std::cerr << "row " << row << " done (col=" << col << ")\n"
                       << std::setw(2);
-            rp.pretty_print(std::cerr, A, b);
+            s.pretty_print(std::cerr);
         }
     }
-
-    return rp;
+    return row;
 }
 
 /**
- * Fraction-free Gaussian elimination with partial pivoting, following Turner
- * 1995, "A simplified fraction-free integer Gauss elimination algorithm"
- * (https://apps.dtic.mil/sti/citations/ADA313755)
+ * Fraction-free Gauss-Jordan elimination. Each pivot row is divided by the
+ * GCD of its entries, and its pivot is made positive.
  */
 template <std::signed_integral T>
-std::optional<RowPermuter> gauss_jordan_fraction_free(aoc::ds::Grid<T> &A,
-                                                      std::vector<T> &b) {
-    int rows = A.height;
-    int cols = A.width;
-    assert(b.size() == static_cast<std::size_t>(rows));
-    // assert(A.width == static_cast<int>(rows));
-    RowPermuter rp(rows);
+int reduced_row_echelon(const SystemView<T> &s) {
     std::vector<int> diag_cols;
 
-    const auto scale_row = [&rp, &A, &b, cols](int r, T factor) {
-        assert(rp(b, r) % factor == 0);
-        rp(b, r) /= factor;
-        for (int j = 0; j < cols; ++j) {
-            assert(rp(A, r, j) % factor == 0);
-            rp(A, r, j) /= factor;
+    // remove all common factors from row r, and make A[r][col] positive
+    const auto reduce_row = [&s](int r, int col, const char *when) {
+        T factor = row_content(s, r);
+        if (s(r, col) < 0) {
+            factor *= -1;
+        }
+        if (factor != 1) {
+            scale_row(s, r, factor);
+            if constexpr (aoc::DEBUG) {
+                std::cerr << "reduced row " << r << " by a common factor of "
+                          << factor << when << "\n";
+            }
         }
     };
 
-    for (int row = 0, col = 0; row < rows && col < cols; ++row, ++col) {
-        while (rp(A, row, col) == 0 &&
-               !detail::partial_pivot_first(A, rp, col, row)) {
+    for (int row = 0, col = 0; row < s.rows && col < s.cols; ++row, ++col) {
+        while (s(row, col) == 0 && !partial_pivot_first(s, col, row)) {
             if constexpr (aoc::DEBUG) {
                 std::cerr << "skipping column " << col << "\n";
             }
             ++col;
-            if (col >= cols) {
+            if (col >= s.cols) {
                 break;
             }
         }
-        if (col >= cols) {
+        if (col >= s.cols) {
             break;
         }
         diag_cols.push_back(col);
 
-        // remove all common factors from row
-        T factor = rp(b, row);
-        for (int j = 0; j < cols; ++j) {
-            if (factor == 1) {
-                // exit early if there are no common factors
-                break;
-            }
-            factor = std::gcd(factor, rp(A, row, j));
-        }
-        // make the diagonal entry positive
-        if (rp(A, row, col) < 0) {
-            factor *= -1;
-        }
-        if (factor != 1) {
-            rp(b, row) /= factor;
-            for (int j = 0; j < cols; ++j) {
-                rp(A, row, j) /= factor;
-            }
-            if constexpr (aoc::DEBUG) {
-                std::cerr << "reduced row " << row << " by a common factor of "
-                          << factor << " at start\n";
-            }
-        }
+        reduce_row(row, col, " at start");
 
-        const T &Arc = rp(A, row, col);
-        for (int j = 0; j < rows; ++j) {
-            if (j == row) {
-                continue;
-            }
-            assert(Arc != 0);
-            T &Ajc = rp(A, j, col);
-            if (Ajc == 0) {
+        const T Arc = s(row, col);
+        assert(Arc != 0);
+        const std::span<const T> pivot_row = s.row(row);
+        for (int j = 0; j < s.rows; ++j) {
+            const T Ajc = s(j, col);
+            if (j == row || Ajc == 0) {
                 continue;
             }
             T lcm = std::lcm(Ajc, Arc);
-            T r_factor = Ajc, j_factor = Arc;
-            if (Arc != 0) {
-                r_factor = lcm / Arc;
-            }
-            if (Ajc != 0) {
-                j_factor = lcm / Ajc;
-            }
-            rp(b, j) = j_factor * rp(b, j) - r_factor * rp(b, row);
-            for (int k = 0; k < cols; ++k) {
-                if (k == col) {
-                    continue;
-                }
-                rp(A, j, k) = j_factor * rp(A, j, k) - r_factor * rp(A, row, k);
-            }
-            Ajc = 0;
-        }
-        // remove all common factors from row
-        factor = rp(b, row);
-        for (int j = col; j < cols; ++j) {
-            if (factor == 1) {
-                // exit early if there are no common factors
-                break;
-            }
-            factor = std::gcd(factor, rp(A, row, j));
-        }
-        // make the diagonal entry positive
-        if (rp(A, row, col) < 0) {
-            factor *= -1;
-        }
-        if (factor != 1) {
-            assert(rp(b, row) % factor == 0);
-            rp(b, row) /= factor;
-            for (int j = 0; j < cols; ++j) {
-                assert(rp(A, row, j) % factor == 0);
-                rp(A, row, j) /= factor;
-            }
-            if constexpr (aoc::DEBUG) {
-                std::cerr << "reduced row " << row << " by a common factor of "
-                          << factor << " at end\n";
-            }
-        }
+            T r_factor = lcm / Arc;
+            T j_factor = lcm / Ajc;
+            s.b(j) = j_factor * s.b(j) - r_factor * s.b(row);
+            // this also zeroes out A[j][col]
+            row_cross_sub(s.row(j), j_factor, pivot_row, r_factor);
+            assert(s(j, col) == 0);
+        }
+        reduce_row(row, col, " at end");
         if constexpr (aoc::DEBUG) {
             std::cerr << "row " << row << " done (col=" << col << ")\n"
                       << std::setw(3);
-            rp.pretty_print(std::cerr, A, b);
+            s.pretty_print(std::cerr);
         }
     }
 
     // re-reduce all rows
     for (int row = 0; row < static_cast<int>(diag_cols.size()); ++row) {
-        // remove all common factors from row
-        T factor = rp(b, row);
-        for (int j = 0; j < cols; ++j) {
-            if (factor == 1) {
-                // exit early if there are no common factors
-                break;
-            }
-            factor = std::gcd(factor, rp(A, row, j));
+        reduce_row(row, diag_cols[row], " (final)");
+    }
+
+    return diag_cols.size();
+}
+
+/// Solves an upper-triangular system from row_echelon(), overwriting b.
+template <class T>
+std::vector<T> back_substitute(const SystemView<T> &s) {
+    const int n = s.rows;
+    assert(s.cols == n);
+    std::vector<T> x(n, 0);
+    for (int i = n; i-- > 0;) {
+        const std::span<const T> x_tail = std::span<const T>(x).subspan(i + 1);
+        s.b(i) -= row_dot<T>(s.row(i).subspan(i + 1), x_tail);
+        if constexpr (std::signed_integral<T>) {
+            assert(s.b(i) % s(i, i) == 0);
         }
-        // make the diagonal entry positive
-        if (rp(A, row, diag_cols.at(row)) < 0) {
-            factor *= -1;
+        x[i] = s.b(i) / s(i, i);
+    }
+    return x;
+}
+
+enum class exact_status { SOLVED, NO_SOLUTION, OVERFLOW };
+
+/**
+ * Solves A x = b exactly into `result`, with every operation carried out in W
+ * and checked for overflow. Returns NO_SOLUTION if A is singular or x isn't
+ * integral, and OVERFLOW if anything (including x) doesn't fit.
+ *
+ * Overflow is reported by status rather than by exception, since
+ * solve_exact expects it whenever the fast path fails, and throwing costs
+ * more than the whole solve on small systems.
+ */
+template <signed_integer W, std::signed_integral T>
+exact_status solve_exact_as(const aoc::ds::Grid<T> &A, const std::vector<T> &b,
+                            std::vector<T> &result) {
+    const int n = A.height;
+    aoc::ds::Grid<W> wide_A(A.width, A.height);
+    std::ranges::copy(A.data(), wide_A.data().begin());
+    std::vector<W> wide_b(b.begin(), b.end());
+    const SystemView<W> s(wide_A, wide_b);
+    bool overflow = false;
+    if (!row_echelon<true>(s, &overflow)) {
+        return overflow ? exact_status::OVERFLOW : exact_status::NO_SOLUTION;
+    }
+
+    std::vector<W> x(n, 0);
+    for (int i = n; i-- > 0;) {
+        W rhs = s.b(i);
+        for (int j = i + 1; j < n; ++j) {
+            W term;
+            overflow |= __builtin_mul_overflow(s(i, j), x[j], &term);
+            overflow |= __builtin_sub_overflow(rhs, term, &rhs);
         }
-        if (factor != 1) {
-            scale_row(row, factor);
-            if constexpr (aoc::DEBUG) {
-                std::cerr << "reduced row " << row << " by a common factor of "
-                          << factor << " (final)\n";
+        if (overflow) {
+            return exact_status::OVERFLOW;
+        }
+        if (rhs % s(i, i) != 0) {
+            return exact_status::NO_SOLUTION;
+        }
+        x[i] = rhs / s(i, i);
+    }
+
+    result.resize(n);
+    for (int i = 0; i < n; ++i) {
+        if constexpr (!std::same_as<W, T>) {
+            if (x[i] < std::numeric_limits<T>::min() ||
+                x[i] > std::numeric_limits<T>::max()) {
+                return exact_status::OVERFLOW;
             }
         }
+        result[i] = static_cast<T>(x[i]);
+    }
+    return exact_status::SOLVED;
+}
+
+} // namespace detail
+
+/**
+ * Solves the square integer system A x = b exactly, using fraction-free
+ * elimination with every step checked for overflow. This runs in T first,
+ * and if anything overflows, starts over in __int128.
+ *
+ * Returns {} if A is singular or the solution isn't integral. Throws
+ * std::overflow_error if it overflows __int128 too, or the solution doesn't
+ * fit in T.
+ */
+template <std::signed_integral T>
+std::optional<std::vector<T>> solve_exact(const aoc::ds::Grid<T> &A,
+                                          const std::vector<T> &b) {
+    using detail::exact_status;
+    assert(A.width == A.height);
+    assert(b.size() == static_cast<std::size_t>(A.height));
+    std::vector<T> x;
+    exact_status status = detail::solve_exact_as<T>(A, b, x);
+    if (status == exact_status::OVERFLOW) {
+        if constexpr (aoc::DEBUG) {
+            std::cerr << "solve_exact: overflow, retrying with __int128\n";
+        }
+        status = detail::solve_exact_as<__int128>(A, b, x);
+    }
+    switch (status) {
+    case exact_status::SOLVED:
+        return x;
+    case exact_status::NO_SOLUTION:
+        return {};
+    case exact_status::OVERFLOW:
+        break;
+    }
+    throw std::overflow_error("overflow in aoc::math::solve_exact");
+}
+
+/**
+ * Returns true if Hadamard's bound guarantees that solving A x = b exactly in
+ * W can't overflow. This is much cheaper than the solve, so callers with a
+ * floating-point fallback can skip solve_exact on systems that are far too
+ * large, instead of catching its std::overflow_error.
+ *
+ * Every value in the fraction-free elimination is a minor of [A | b] (so at
+ * most H, the product of its row norms), or a difference of two products of
+ * them before the exact division. Back substitution sums n such products. The
+ * bound is loose, so a false result doesn't mean the solve would overflow.
+ */
+template <signed_integer W, std::signed_integral T>
+bool exact_solve_fits(const aoc::ds::Grid<T> &A, const std::vector<T> &b) {
+    long double log2_H = 0;
+    for (int i = 0; i < A.height; ++i) {
+        long double norm_sq = static_cast<long double>(b[i]) * b[i];
+        for (int j = 0; j < A.width; ++j) {
+            const long double value = A.at(j, i);
+            norm_sq += value * value;
+        }
+        // all-zero rows make A singular, which is caught by the solve
+        if (norm_sq > 1) {
+            log2_H += std::log2(norm_sq) / 2;
+        }
     }
+    const long double log2_max = 2 * log2_H + std::log2(A.height + 1.0L);
+    return log2_max < sizeof(W) * CHAR_BIT - 1;
+}
 
-    return rp;
+/**
+ * Reduces the square system A x = b to upper-triangular form, in place.
+ * Floating-point systems use standard Gaussian elimination, and integer
+ * systems use fraction-free elimination.
+ *
+ * Rows are swapped in A and b directly. Returns false if A is singular.
+ */
+template <class T>
+bool row_echelon(aoc::ds::Grid<T> &A, std::vector<T> &b) {
+    if constexpr (std::signed_integral<T> || std::floating_point<T>) {
+        return detail::row_echelon(detail::SystemView<T>(A, b));
+    } else {
+        static_assert(util::always_false<T>,
+                      "data type must be signed integral or floating-point");
+    }
 }
 
+/**
+ * Reduces A x = b to reduced row echelon form, in place. For floating-point
+ * systems, every pivot is 1. For integer systems, every pivot is positive and
+ * each row is divided by its common factor.
+ *
+ * Rows are swapped in A and b directly, so the first `rank` rows hold the
+ * pivots. Returns the rank of A.
+ */
 template <class T>
-std::optional<RowPermuter> gauss_jordan(aoc::ds::Grid<T> &A,
-                                        std::vector<T> &b) {
-    if constexpr (std::signed_integral<T>) {
-        return gauss_jordan_fraction_free(A, b);
-    } else if constexpr (std::floating_point<T>) {
-        return gauss_jordan_floating_point(A, b);
+int reduced_row_echelon(aoc::ds::Grid<T> &A, std::vector<T> &b) {
+    if constexpr (std::signed_integral<T> || std::floating_point<T>) {
+        return detail::reduced_row_echelon(detail::SystemView<T>(A, b));
     } else {
         static_assert(util::always_false<T>,
                       "data type must be signed integral or floating-point");
     }
 }
 
+/// Solves an upper-triangular system from row_echelon(), overwriting b.
+template <class T>
+std::vector<T> back_substitute(aoc::ds::Grid<T> &A, std::vector<T> &b) {
+    return detail::back_substitute(detail::SystemView<T>(A, b));
+}
+
+// The functions below take and return a RowPermuter for compatibility. Rows
+// are now swapped in place, so the returned permutation is always the
+// identity.
+
+template <std::floating_point T>
+std::optional<RowPermuter> gauss_elim_floating_point(aoc::ds::Grid<T> &A,
+                                                     std::vector<T> &b) {
+    if (!detail::row_echelon(detail::SystemView<T>(A, b))) {
+        return {};
+    }
+    return RowPermuter(A.height);
+}
+
+template <std::signed_integral T>
+std::optional<RowPermuter> gauss_elim_fraction_free(aoc::ds::Grid<T> &A,
+                                                    std::vector<T> &b) {
+    if (!detail::row_echelon(detail::SystemView<T>(A, b))) {
+        return {};
+    }
+    return RowPermuter(A.height);
+}
+
+template <class T>
+std::optional<RowPermuter> gauss_elim(aoc::ds::Grid<T> &A, std::vector<T> &b) {
+    if (!row_echelon(A, b)) {
+        return {};
+    }
+    return RowPermuter(A.height);
+}
+
+template <std::floating_point T>
+std::optional<RowPermuter> gauss_jordan_floating_point(aoc::ds::Grid<T> &A,
+                                                       std::vector<T> &b) {
+    detail::reduced_row_echelon(detail::SystemView<T>(A, b));
+    return RowPermuter(A.height);
+}
+
+template <std::signed_integral T>
+std::optional<RowPermuter> gauss_jordan_fraction_free(aoc::ds::Grid<T> &A,
+                                                      std::vector<T> &b) {
+    detail::reduced_row_echelon(detail::SystemView<T>(A, b));
+    return RowPermuter(A.height);
+}
+
+template <class T>
+std::optional<RowPermuter> gauss_jordan(aoc::ds::Grid<T> &A,
+                                        std::vector<T> &b) {
+    reduced_row_echelon(A, b);
+    return RowPermuter(A.height);
+}
+
 template <class T>
 std::vector<T> solve_upper_triangular(const aoc::ds::Grid<T> &A,
                                       std::vector<T> &b,
@@ -526,6 +775,89 @@ std::vector<T> solve_upper_triangular(const aoc::ds::Grid<T> &A,
     return x;
 }
 
+/**
+ * Many linear systems A x = b of the same shape, stored back to back as
+ * augmented rows [A | b] in a single buffer, so they can be built and reduced
+ * without an allocation per system, and each system stays contiguous in
+ * memory.
+ */
+template <class T>
+class SystemBatch {
+    int m_rows;
+    int m_cols;
+    std::vector<T> m_data{};
+
+    std::size_t system_size() const {
+        return static_cast<std::size_t>(m_rows) * (m_cols + 1);
+    }
+
+  public:
+    SystemBatch(int rows, int cols) : m_rows(rows), m_cols(cols) {}
+
+    int rows() const { return m_rows; }
+    int cols() const { return m_cols; }
+    std::size_t size() const { return m_data.size() / system_size(); }
+    void reserve(std::size_t count) { m_data.reserve(count * system_size()); }
+
+    /// Adds a system, and returns its index.
+    std::size_t add(const aoc::ds::Grid<T> &A, const std::vector<T> &b) {
+        assert(A.height == m_rows && A.width == m_cols);
+        assert(b.size() == static_cast<std::size_t>(m_rows));
+        const std::size_t index = size();
+        auto row_it = A.begin();
+        for (int r = 0; r < m_rows; ++r, ++row_it) {
+            m_data.insert(m_data.end(), row_it->begin(), row_it->end());
+            m_data.push_back(b[r]);
+        }
+        return index;
+    }
+
+    T &a(std::size_t i, int r, int c) { return view(i)(r, c); }
+    const T &a(std::size_t i, int r, int c) const {
+        return m_data[i * system_size() + r * (m_cols + 1) + c];
+    }
+    T &b(std::size_t i, int r) { return view(i).b(r); }
+    const T &b(std::size_t i, int r) const { return a(i, r, m_cols); }
+
+    detail::SystemView<T> view(std::size_t i) {
+        assert(i < size());
+        return detail::SystemView<T>(m_data.data() + i * system_size(),
+                                     m_rows, m_cols);
+    }
+};
+
+/**
+ * Runs row_echelon() on every system in the batch. Returns whether each one
+ * was non-singular.
+ */
+template <class T>
+std::vector<bool> row_echelon(SystemBatch<T> &batch) {
+    std::vector<bool> ok(batch.size());
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+        ok[i] = detail::row_echelon(batch.view(i));
+    }
+    return ok;
+}
+
+/**
+ * Runs reduced_row_echelon() on every system in the batch, and returns their
+ * ranks.
+ */
+template <class T>
+std::vector<int> reduced_row_echelon(SystemBatch<T> &batch) {
+    std::vector<int> ranks(batch.size());
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+        ranks[i] = detail::reduced_row_echelon(batch.view(i));
+    }
+    return ranks;
+}
+
+/// Solves system i of the batch after row_echelon(), overwriting its b.
+template <class T>
+std::vector<T> back_substitute(SystemBatch<T> &batch, std::size_t i) {
+    return detail::back_substitute(batch.view(i));
+}
+
 // instantiate templates in an anonymous namespace, so static analyzers will
 // check these functions
 namespace {
@@ -537,6 +869,18 @@ void _lint_helper_template() {
     if (rp) {
         solve_upper_triangular(A, b, *rp);
     }
+    gauss_jordan(A, b);
+    SystemBatch<T> batch(5, 5);
+    batch.add(A, b);
+    if (row_echelon(batch)[0]) {
+        back_substitute(batch, 0);
+    }
+    reduced_row_echelon(batch);
+    if constexpr (std::signed_integral<T>) {
+        if (exact_solve_fits<__int128>(A, b)) {
+            solve_exact(A, b);
+        }
+    }
 }
 [[maybe_unused]] void _lint_helper() {
     _lint_helper_template<int>();
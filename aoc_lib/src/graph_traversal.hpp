@@ -10,21 +10,31 @@
 #ifndef GRAPH_TRAVERSAL_HPP_56T9ZURK
 #define GRAPH_TRAVERSAL_HPP_56T9ZURK
 
-#include "lib.hpp"           // for DEBUG
-#include "util/concepts.hpp" // for Hashable, any_iterable_collection, same_as_any
-#include "util/hash.hpp"     // for unordered_map_badness
-#include <algorithm>         // for min, reverse
-#include <cassert>           // for assert
-#include <concepts>          // for same_as, integral
-#include <functional>        // for function, greater
-#include <initializer_list> // for initializer_list
-#include <iostream>         // for cerr
+#include "ds/bucket_queue.hpp" // for bucket_queue
+#include "ds/pairing_heap.hpp" // for pooled_pairing_heap
+#include "lib.hpp"             // for DEBUG
+#include "perf.hpp"            // for Scope
+#include "util/concepts.hpp"   // for Hashable, any_iterable_collection, same_as_any
+#include "util/hash.hpp"       // for unordered_map_badness
+#include <algorithm>           // for min, max, reverse
+#include <atomic>              // for atomic
+#include <barrier>             // for barrier
+#include <cassert>             // for assert
+#include <concepts>            // for same_as, integral, convertible_to
+#include <cstddef>             // for size_t
+#include <cstdint>             // for uint64_t
+#include <functional>          // for function, greater
+#include <initializer_list>    // for initializer_list
+#include <iostream>            // for cerr
 #include <iterator>         // for begin, end
+#include <limits>           // for numeric_limits
 #include <map>              // for map
+#include <optional>         // for optional
 #include <queue>            // for priority_queue
 #include <set>              // for set
 #include <stack>            // for stack
 #include <stdexcept>        // for invalid_argument
+#include <thread>           // for jthread, hardware_concurrency
 #include <tuple>            // for tuple
 #include <type_traits> // for conditional_t, invoke_result_t // IWYU pragma: export
 #include <unordered_map> // for unordered_map
@@ -65,10 +75,32 @@ using maybe_unordered_map =
     std::conditional_t<util::concepts::Hashable<Key>,
                        std::unordered_map<Key, T>, std::map<Key, T>>;
 
+/**
+ * An indexer maps each key to a unique integer in [0, indexer.size()), which
+ * lets the traversal algorithms store their bookkeeping in flat arrays instead
+ * of hash tables.
+ */
+template <class Indexer, class Key>
+concept KeyIndexer = requires(const Indexer &indexer, const Key &key) {
+    { indexer(key) } -> std::convertible_to<std::size_t>;
+    { indexer.size() } -> std::convertible_to<std::size_t>;
+};
+
+/**
+ * Stand-in for the neighbor callback that the algorithms pass to
+ * process_neighbors. It's never defined, only used to check the concept
+ * below, so process_neighbors should take the callback as a template
+ * parameter (usually `auto &&process`) rather than as a std::function.
+ */
+template <class Key>
+struct neighbor_callback {
+    void operator()(const Key &key) const;
+};
+
 template <class Func, class Key>
 concept ProcessNeighbors =
     requires(Func process_neighbors, const Key &key,
-             std::function<void(const Key &key)> &process) {
+             neighbor_callback<Key> &process) {
         process_neighbors(key, process);
     };
 
@@ -119,6 +151,16 @@ concept GetDistance = requires(Func get_distance, const Key &u, const Key &v) {
     { get_distance(u, v) } -> std::integral;
 };
 
+/**
+ * A GetDistance function that also declares an upper bound on the weights it
+ * returns, via an integral `max_weight` member (see with_max_weight).
+ */
+template <class Func, class Key>
+concept BoundedGetDistance =
+    GetDistance<Func, Key> && requires(const Func &get_distance) {
+        { get_distance.max_weight } -> std::convertible_to<int>;
+    };
+
 template <class Func, class Key>
 concept Heuristic = requires(Func heuristic, const Key &key) {
     { heuristic(key) } -> std::integral;
@@ -127,12 +169,321 @@ concept Heuristic = requires(Func heuristic, const Key &key) {
 template <class T>
 concept FuncPassed = !std::same_as<T, optional_func>;
 
+// placeholder type for the optional key indexer
+struct no_indexer {};
+
+template <class Indexer, class Key>
+concept MaybeIndexer = std::same_as<std::remove_cvref_t<Indexer>, no_indexer> ||
+                       KeyIndexer<std::remove_cvref_t<Indexer>, Key>;
+
+/**
+ * Set of keys, backed by a hash table (or a tree, if the key isn't hashable).
+ */
+template <class Key, class Indexer>
+class key_set {
+    maybe_unordered_set<Key> m_set{};
+
+  public:
+    explicit key_set(const Indexer &) {}
+
+    bool contains(const Key &key) const { return m_set.contains(key); }
+    /// returns true if the key was not already present
+    bool insert(const Key &key) { return m_set.insert(key).second; }
+};
+
+/**
+ * Set of keys, backed by a flat bitset.
+ */
+template <class Key, KeyIndexer<Key> Indexer>
+class key_set<Key, Indexer> {
+    Indexer m_indexer;
+    std::vector<bool> m_bits;
+
+  public:
+    explicit key_set(const Indexer &indexer)
+        : m_indexer(indexer), m_bits(indexer.size(), false) {}
+
+    bool contains(const Key &key) const { return m_bits[m_indexer(key)]; }
+    /// returns true if the key was not already present
+    bool insert(const Key &key) {
+        auto &&bit = m_bits[m_indexer(key)];
+        if (bit) {
+            return false;
+        }
+        bit = true;
+        return true;
+    }
+};
+
+/**
+ * Deduplicated queue of keys for a single BFS level, backed by a hash table
+ * (or a tree, if the key isn't hashable).
+ */
+template <class Key, class Indexer>
+class key_queue {
+    maybe_unordered_set<Key> m_set{};
+
+  public:
+    explicit key_queue(const Indexer &) {}
+
+    auto begin() const { return m_set.begin(); }
+    auto end() const { return m_set.end(); }
+    bool empty() const { return m_set.empty(); }
+    void insert(const Key &key) { m_set.insert(key); }
+    void clear() { m_set.clear(); }
+    void swap(key_queue &other) { m_set.swap(other.m_set); }
+};
+
+/**
+ * Deduplicated queue of keys for a single BFS level, backed by a vector and a
+ * flat bitset.
+ */
+template <class Key, KeyIndexer<Key> Indexer>
+class key_queue<Key, Indexer> {
+    Indexer m_indexer;
+    std::vector<Key> m_keys{};
+    std::vector<bool> m_queued;
+
+  public:
+    explicit key_queue(const Indexer &indexer)
+        : m_indexer(indexer), m_queued(indexer.size(), false) {}
+
+    auto begin() const { return m_keys.begin(); }
+    auto end() const { return m_keys.end(); }
+    bool empty() const { return m_keys.empty(); }
+    void insert(const Key &key) {
+        auto &&bit = m_queued[m_indexer(key)];
+        if (!bit) {
+            bit = true;
+            m_keys.push_back(key);
+        }
+    }
+    void clear() {
+        // only reset the bits we set, so this is O(size) rather than
+        // O(capacity)
+        for (const Key &key : m_keys) {
+            m_queued[m_indexer(key)] = false;
+        }
+        m_keys.clear();
+    }
+    void swap(key_queue &other) {
+        m_keys.swap(other.m_keys);
+        m_queued.swap(other.m_queued);
+    }
+};
+
+/**
+ * Mapping from keys to values, backed by a hash table (or a tree, if the key
+ * isn't hashable).
+ */
+template <class Key, class T, class Indexer>
+class key_map {
+    maybe_unordered_map<Key, T> m_map{};
+
+  public:
+    explicit key_map(const Indexer &) {}
+
+    /// returns nullptr if the key is not present
+    T *find(const Key &key) {
+        auto it = m_map.find(key);
+        return it == m_map.end() ? nullptr : &it->second;
+    }
+    const T *find(const Key &key) const {
+        auto it = m_map.find(key);
+        return it == m_map.end() ? nullptr : &it->second;
+    }
+    T &at(const Key &key) { return m_map.at(key); }
+    const T &at(const Key &key) const { return m_map.at(key); }
+    /// inserts or overwrites the value for key
+    template <class... Args>
+    T &emplace(const Key &key, Args &&...args) {
+        return m_map.insert_or_assign(key, T(std::forward<Args>(args)...))
+            .first->second;
+    }
+
+    const maybe_unordered_map<Key, T> &base() const { return m_map; }
+};
+
+/**
+ * Mapping from keys to values, backed by a flat array.
+ */
+template <class Key, class T, KeyIndexer<Key> Indexer>
+class key_map<Key, T, Indexer> {
+    Indexer m_indexer;
+    std::vector<std::optional<T>> m_data;
+
+  public:
+    explicit key_map(const Indexer &indexer)
+        : m_indexer(indexer), m_data(indexer.size()) {}
+
+    /// returns nullptr if the key is not present
+    T *find(const Key &key) {
+        auto &value = m_data[m_indexer(key)];
+        return value ? &*value : nullptr;
+    }
+    const T *find(const Key &key) const {
+        const auto &value = m_data[m_indexer(key)];
+        return value ? &*value : nullptr;
+    }
+    T &at(const Key &key) { return m_data[m_indexer(key)].value(); }
+    const T &at(const Key &key) const {
+        return m_data[m_indexer(key)].value();
+    }
+    /// inserts or overwrites the value for key
+    template <class... Args>
+    T &emplace(const Key &key, Args &&...args) {
+        return m_data[m_indexer(key)].emplace(std::forward<Args>(args)...);
+    }
+};
+
+/**
+ * Priority queue of (distance, key) pairs for Dijkstra's algorithm, backed by
+ * a binary heap.
+ */
+template <class Key, class GetDistance>
+class dijkstra_frontier {
+    using pq_key = std::pair<int, Key>;
+    std::priority_queue<pq_key, std::vector<pq_key>, std::greater<pq_key>>
+        m_pq{};
+
+  public:
+    explicit dijkstra_frontier(const GetDistance &) {}
+
+    bool empty() const { return m_pq.empty(); }
+    std::size_t size() const { return m_pq.size(); }
+    int top_distance() const { return m_pq.top().first; }
+    void emplace(int distance, const Key &key) { m_pq.emplace(distance, key); }
+    /// removes and returns the closest entry
+    pq_key pop() {
+        pq_key top = std::move(m_pq.top());
+        m_pq.pop();
+        return top;
+    }
+};
+
+/**
+ * Priority queue of (distance, key) pairs for Dijkstra's algorithm, backed by
+ * a bucket queue when the edge weights are bounded.
+ */
+template <class Key, BoundedGetDistance<Key> GetDistance>
+class dijkstra_frontier<Key, GetDistance> {
+    using pq_key = std::pair<int, Key>;
+    ds::bucket_queue<Key> m_pq;
+
+  public:
+    explicit dijkstra_frontier(const GetDistance &get_distance)
+        : m_pq(get_distance.max_weight) {}
+
+    bool empty() const { return m_pq.empty(); }
+    std::size_t size() const { return m_pq.size(); }
+    int top_distance() const { return m_pq.top_priority(); }
+    void emplace(int distance, const Key &key) { m_pq.emplace(distance, key); }
+    /// removes and returns the closest entry
+    pq_key pop() {
+        pq_key top{m_pq.top_priority(), std::move(m_pq.top())};
+        m_pq.pop();
+        return top;
+    }
+};
+
 template <class T>
 concept AnySourceCollection =
     util::concepts::any_iterable_collection<T, typename T::value_type>;
 
 } // namespace detail
 
+/**
+ * Wrapper for a GetDistance function whose weights are all in
+ * [0, max_weight]. Passing one of these to dijkstra switches the frontier to
+ * a bucket queue, which is much faster than a binary heap for small weights.
+ */
+template <class Func>
+struct bounded_distance {
+    Func func;
+    int max_weight;
+
+    template <class Key>
+    int operator()(const Key &u, const Key &v) const {
+        int weight = func(u, v);
+        assert(weight >= 0 && weight <= max_weight);
+        return weight;
+    }
+};
+
+template <class Func>
+bounded_distance<std::remove_cvref_t<Func>> with_max_weight(int max_weight,
+                                                            Func &&func) {
+    return {std::forward<Func>(func), max_weight};
+}
+
+/**
+ * Indexer for keys that live on a rectangular grid, for use with the flat
+ * storage backend of bfs, dijkstra and a_star.
+ *
+ * `proj(key)` must return a (position, layer) pair, where the layer is an
+ * integer or enum in [0, layers) that distinguishes keys at the same position
+ * (e.g. a direction).
+ */
+template <class Proj>
+struct grid_indexer {
+    int width;
+    int height;
+    int layers;
+    Proj proj;
+
+    template <class Key>
+    std::size_t operator()(const Key &key) const {
+        const auto &[pos, layer] = proj(key);
+        return (static_cast<std::size_t>(layer) * height + pos.y) * width +
+               pos.x;
+    }
+    std::size_t size() const {
+        return static_cast<std::size_t>(width) * height * layers;
+    }
+};
+
+namespace detail {
+struct pos_projection {
+    template <class Pos>
+    constexpr auto operator()(const Pos &pos) const {
+        return std::make_pair(pos, 0);
+    }
+};
+
+struct pos_dir_projection {
+    template <class Key>
+    constexpr auto operator()(const Key &key) const {
+        return std::make_pair(key.pos, key.dir);
+    }
+};
+} // namespace detail
+
+/**
+ * Make an indexer for keys on a grid-like object (anything with `width` and
+ * `height` members).
+ *
+ * With no projection, this handles plain Pos keys.
+ */
+template <class Grid>
+grid_indexer<detail::pos_projection> make_grid_indexer(const Grid &grid) {
+    return {grid.width, grid.height, 1, {}};
+}
+
+/**
+ * Make an indexer for keys made of a `pos` and an AbsDirection `dir`.
+ */
+template <class Grid>
+grid_indexer<detail::pos_dir_projection>
+make_pos_dir_indexer(const Grid &grid) {
+    return {grid.width, grid.height, 4, {}};
+}
+
+template <class Grid, class Proj>
+grid_indexer<std::remove_cvref_t<Proj>>
+make_grid_indexer(const Grid &grid, int layers, Proj &&proj) {
+    return {grid.width, grid.height, layers, std::forward<Proj>(proj)};
+}
+
 /**
  * Generic BFS on an arbitrary graph.
  *
@@ -146,6 +497,9 @@ concept AnySourceCollection =
  * visited as a tree). `use_seen` should only be set to false if the graph has
  * no cycles.
  *
+ * If an `indexer` is passed (see KeyIndexer), the queues and seen set will be
+ * stored in flat arrays instead of hash tables.
+ *
  * Returns the distance from the source(s) to the first target found, or -1 if
  * not found.
  */
@@ -153,19 +507,26 @@ template <bool use_seen = true, detail::AnySourceCollection ASC,
           class Key = typename ASC::value_type,
           detail::ProcessNeighbors<Key> ProcessNeighbors,
           detail::IsTarget<Key> IsTarget = detail::optional_func,
-          detail::Visit<Key> Visit = detail::optional_func>
+          detail::Visit<Key> Visit = detail::optional_func,
+          detail::MaybeIndexer<Key> Indexer = detail::no_indexer>
 int bfs(const ASC &sources, ProcessNeighbors &&process_neighbors,
-        IsTarget &&is_target, Visit &&visit) {
+        IsTarget &&is_target, Visit &&visit, Indexer &&indexer = {}) {
     static_assert(detail::FuncPassed<IsTarget> || detail::FuncPassed<Visit>,
                   "is_target and visit must not both be defaulted");
     using visit_ret_t = typename detail::visit_invoke_result<Key, Visit>::type;
-    detail::maybe_unordered_set<Key> queue = {std::begin(sources),
-                                              std::end(sources)};
-    detail::maybe_unordered_set<Key> next_queue{};
-    detail::maybe_unordered_set<Key> seen{};
+    using indexer_t = std::remove_cvref_t<Indexer>;
+    const perf::Scope perf_scope(std::same_as<indexer_t, detail::no_indexer>
+                                     ? "graph::bfs (hashed)"
+                                     : "graph::bfs (indexed)");
+    detail::key_queue<Key, indexer_t> queue(indexer);
+    for (const Key &source : sources) {
+        queue.insert(source);
+    }
+    detail::key_queue<Key, indexer_t> next_queue(indexer);
+    detail::key_set<Key, indexer_t> seen(indexer);
 
     for (int distance = 0; !queue.empty();
-         ++distance, queue.clear(), std::swap(queue, next_queue)) {
+         ++distance, queue.clear(), queue.swap(next_queue)) {
         for (const Key &key : queue) {
             if constexpr (std::same_as<visit_ret_t, bool>) {
                 if (!visit(key, distance)) {
@@ -201,25 +562,130 @@ int bfs(const ASC &sources, ProcessNeighbors &&process_neighbors,
 template <bool use_seen = true, class Key,
           detail::ProcessNeighbors<Key> ProcessNeighbors,
           detail::IsTarget<Key> IsTarget = detail::optional_func,
-          detail::Visit<Key> Visit = detail::optional_func>
+          detail::Visit<Key> Visit = detail::optional_func,
+          detail::MaybeIndexer<Key> Indexer = detail::no_indexer>
 int bfs(const std::initializer_list<Key> &sources,
         ProcessNeighbors &&process_neighbors, IsTarget &&is_target,
-        Visit &&visit) {
+        Visit &&visit, Indexer &&indexer = {}) {
     // explicitly specify the ASC template argument to avoid recursion
     return bfs<use_seen, std::initializer_list<Key>>(
         sources, std::forward<ProcessNeighbors>(process_neighbors),
-        std::forward<IsTarget>(is_target), std::forward<Visit>(visit));
+        std::forward<IsTarget>(is_target), std::forward<Visit>(visit),
+        std::forward<Indexer>(indexer));
 }
 
 template <bool use_seen = true, class Key,
           detail::ProcessNeighbors<Key> ProcessNeighbors,
           detail::IsTarget<Key> IsTarget = detail::optional_func,
-          detail::Visit<Key> Visit = detail::optional_func>
+          detail::Visit<Key> Visit = detail::optional_func,
+          detail::MaybeIndexer<Key> Indexer = detail::no_indexer>
 int bfs(const Key &source, ProcessNeighbors &&process_neighbors,
-        IsTarget &&is_target, Visit &&visit) {
+        IsTarget &&is_target, Visit &&visit, Indexer &&indexer = {}) {
     return bfs<use_seen, std::initializer_list<Key>>(
         {source}, std::forward<ProcessNeighbors>(process_neighbors),
-        std::forward<IsTarget>(is_target), std::forward<Visit>(visit));
+        std::forward<IsTarget>(is_target), std::forward<Visit>(visit),
+        std::forward<Indexer>(indexer));
+}
+
+namespace detail {
+/**
+ * Joins the two halves of a path found by a bidirectional search. `forward`
+ * and `backward` map each key to its distance and parent in the searches from
+ * `source` and `target`, respectively.
+ */
+template <class Key, class Map>
+std::vector<Key> join_bidirectional_path(const Key &source, const Key &target,
+                                         const Key &meet, const Map &forward,
+                                         const Map &backward) {
+    std::vector<Key> path{meet};
+    const std::pair<int, Key> *entry;
+    while (path.back() != source &&
+           (entry = forward.find(path.back())) != nullptr) {
+        path.emplace_back(entry->second);
+    }
+    std::ranges::reverse(path);
+    while (path.back() != target &&
+           (entry = backward.find(path.back())) != nullptr) {
+        path.emplace_back(entry->second);
+    }
+    return path;
+}
+} // namespace detail
+
+/**
+ * BFS between a single source and target, searching from both ends at once.
+ *
+ * `forward_neighbors(node, process)` must call `process` on each node reachable
+ * from `node`, and `reverse_neighbors(node, process)` on each node that `node`
+ * is reachable from (for an undirected graph, these can be the same). The
+ * search always expands the smaller of the two frontiers by a full level, and
+ * stops once they meet.
+ *
+ * If an `indexer` is passed (see KeyIndexer), the distances will be stored in
+ * flat arrays instead of hash tables.
+ *
+ * Returns the distance and path from the source to the target, or -1 and an
+ * empty path if the target is unreachable.
+ */
+template <class Key, detail::ProcessNeighbors<Key> ForwardNeighbors,
+          detail::ProcessNeighbors<Key> ReverseNeighbors,
+          detail::MaybeIndexer<Key> Indexer = detail::no_indexer>
+std::pair<int, std::vector<Key>>
+bfs_bidirectional(const Key &source, const Key &target,
+                  ForwardNeighbors &&forward_neighbors,
+                  ReverseNeighbors &&reverse_neighbors,
+                  Indexer &&indexer = {}) {
+    using map_t =
+        detail::key_map<Key, std::pair<int, Key>, std::remove_cvref_t<Indexer>>;
+    if (source == target) {
+        return {0, {source}};
+    }
+    map_t forward(indexer);
+    map_t backward(indexer);
+    forward.emplace(source, 0, source);
+    backward.emplace(target, 0, target);
+    std::vector<Key> forward_queue{source};
+    std::vector<Key> backward_queue{target};
+    std::vector<Key> next_queue{};
+
+    // expands one full level from one side, and returns the shortest path
+    // length through any node where the two searches met (or -1)
+    const auto expand = [&next_queue](std::vector<Key> &queue, map_t &seen,
+                                      const map_t &other, auto &neighbors) {
+        int best = -1;
+        std::optional<Key> best_meet{};
+        next_queue.clear();
+        for (const Key &key : queue) {
+            const int distance = seen.at(key).first + 1;
+            neighbors(key, [&](const Key &neighbor) {
+                if (seen.find(neighbor) != nullptr) {
+                    return;
+                }
+                seen.emplace(neighbor, distance, key);
+                next_queue.push_back(neighbor);
+                const std::pair<int, Key> *entry = other.find(neighbor);
+                if (entry != nullptr &&
+                    (best == -1 || distance + entry->first < best)) {
+                    best = distance + entry->first;
+                    best_meet = neighbor;
+                }
+            });
+        }
+        queue.swap(next_queue);
+        return std::make_pair(best, best_meet);
+    };
+
+    while (!forward_queue.empty() && !backward_queue.empty()) {
+        const auto [distance, meet] =
+            forward_queue.size() <= backward_queue.size()
+                ? expand(forward_queue, forward, backward, forward_neighbors)
+                : expand(backward_queue, backward, forward, reverse_neighbors);
+        if (distance != -1) {
+            return {distance, detail::join_bidirectional_path(
+                                  source, target, *meet, forward, backward)};
+        }
+    }
+    return {-1, {}};
 }
 
 /**
@@ -269,6 +735,157 @@ int bfs_manual_dedupe(const Key &source, ProcessNeighbors &&process_neighbors,
     return -1;
 }
 
+namespace detail {
+/**
+ * Fixed-size bitset that can be claimed from several threads at once.
+ */
+class atomic_bitset {
+    std::vector<std::atomic<std::uint64_t>> m_words;
+
+  public:
+    explicit atomic_bitset(std::size_t size) : m_words((size + 63) / 64) {}
+
+    /// returns true if this call set the bit (i.e. no other thread got it)
+    bool claim(std::size_t index) {
+        const std::uint64_t mask = std::uint64_t{1} << (index % 64);
+        auto &word = m_words[index / 64];
+        // cheap check first, to avoid an RMW on already-visited keys
+        if (word.load(std::memory_order_relaxed) & mask) {
+            return false;
+        }
+        return !(word.fetch_or(mask, std::memory_order_relaxed) & mask);
+    }
+
+    /// same as claim(), but without a locked RMW; only call this while no
+    /// other thread is touching the bitset
+    bool claim_exclusive(std::size_t index) {
+        const std::uint64_t mask = std::uint64_t{1} << (index % 64);
+        auto &word = m_words[index / 64];
+        const std::uint64_t bits = word.load(std::memory_order_relaxed);
+        if (bits & mask) {
+            return false;
+        }
+        word.store(bits | mask, std::memory_order_relaxed);
+        return true;
+    }
+};
+} // namespace detail
+
+/**
+ * Tuning knobs for bfs_parallel.
+ */
+struct parallel_bfs_options {
+    /// number of threads to use (0 means std::thread::hardware_concurrency())
+    unsigned int num_threads = 0;
+    /// levels with fewer keys than this are expanded on a single thread
+    std::size_t serial_cutoff = 4096;
+};
+
+/**
+ * Level-synchronous BFS over keys with a dense indexer (see KeyIndexer), for
+ * large floods.
+ *
+ * Each level is split evenly between the threads, which claim keys in a
+ * shared atomic bitset and collect the next level in their own buffers.
+ * Levels smaller than `options.serial_cutoff` (including all levels before the
+ * frontier first grows that large) are expanded on the calling thread, so
+ * small inputs never start any threads.
+ *
+ * `process_neighbors` may be called concurrently from several threads, so it
+ * must not modify any shared state.
+ *
+ * Returns the distance to each key from the nearest source, indexed by
+ * `indexer(key)`, or -1 for unreachable keys. The distances don't depend on
+ * the number of threads.
+ */
+template <detail::AnySourceCollection ASC, class Key = typename ASC::value_type,
+          detail::ProcessNeighbors<Key> ProcessNeighbors,
+          detail::KeyIndexer<Key> Indexer>
+std::vector<int> bfs_parallel(const ASC &sources,
+                              ProcessNeighbors &&process_neighbors,
+                              const Indexer &indexer,
+                              parallel_bfs_options options = {}) {
+    std::vector<int> distances(indexer.size(), -1);
+    detail::atomic_bitset seen(indexer.size());
+    std::vector<Key> frontier{};
+    for (const Key &source : sources) {
+        if (seen.claim(indexer(source))) {
+            distances[indexer(source)] = 0;
+            frontier.push_back(source);
+        }
+    }
+
+    int distance = 0;
+    const auto expand = [&](auto begin, auto end, std::vector<Key> &next,
+                            bool concurrent) {
+        for (auto it = begin; it != end; ++it) {
+            process_neighbors(*it, [&](const Key &neighbor) {
+                const std::size_t index = indexer(neighbor);
+                if (concurrent ? seen.claim(index)
+                               : seen.claim_exclusive(index)) {
+                    distances[index] = distance + 1;
+                    next.push_back(neighbor);
+                }
+            });
+        }
+    };
+    std::vector<Key> next_frontier{};
+    const auto expand_serial = [&](std::size_t cutoff) {
+        while (!frontier.empty() && frontier.size() < cutoff) {
+            expand(frontier.begin(), frontier.end(), next_frontier, false);
+            ++distance;
+            frontier.swap(next_frontier);
+            next_frontier.clear();
+        }
+    };
+
+    expand_serial(options.serial_cutoff);
+    // only look up the thread count once it's needed, since it's a syscall
+    unsigned int num_threads = options.num_threads;
+    if (num_threads == 0 && !frontier.empty()) {
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    if (num_threads == 1) {
+        expand_serial(std::numeric_limits<std::size_t>::max());
+    }
+    if (frontier.empty()) {
+        return distances;
+    }
+
+    std::vector<std::vector<Key>> buffers(num_threads);
+    bool done = false;
+    // runs on one thread after every thread has finished the current level
+    const auto merge = [&]() noexcept {
+        frontier.clear();
+        for (auto &buffer : buffers) {
+            frontier.insert(frontier.end(), buffer.begin(), buffer.end());
+            buffer.clear();
+        }
+        ++distance;
+        expand_serial(options.serial_cutoff);
+        done = frontier.empty();
+    };
+    std::barrier sync(num_threads, merge);
+    const auto worker = [&](unsigned int id) {
+        while (!done) {
+            const std::size_t size = frontier.size();
+            expand(frontier.begin() + size * id / num_threads,
+                   frontier.begin() + size * (id + 1) / num_threads,
+                   buffers[id], true);
+            sync.arrive_and_wait();
+        }
+    };
+    {
+        std::vector<std::jthread> threads;
+        threads.reserve(num_threads - 1);
+        for (unsigned int id = 1; id < num_threads; ++id) {
+            threads.emplace_back(worker, id);
+        }
+        worker(0);
+    }
+    return distances;
+}
+
 /**
  * Generic DFS on an arbitrary graph, non-recursive version.
  *
@@ -627,32 +1244,66 @@ longest_path_dag(const Key &source, ProcessNeighbors &&process_neighbors,
     return {max_distance, std::move(path)};
 }
 
+/**
+ * Frontier operation counts for a single shortest-path search. Pass a pointer
+ * to one of these as the last argument of dijkstra, a_star, or their
+ * decrease-key variants to compare how much work each one does.
+ */
+struct search_stats {
+    std::size_t pushes = 0;
+    std::size_t pops = 0;
+    // decrease-key operations (always 0 for the lazy versions)
+    std::size_t updates = 0;
+    std::size_t max_frontier_size = 0;
+
+    void record_push(std::size_t frontier_size) {
+        ++pushes;
+        max_frontier_size = std::max(max_frontier_size, frontier_size);
+    }
+};
+
 /**
  * Generic Dijkstra's algorithm on an arbitrary weighted graph.
  *
+ * If an `indexer` is passed (see KeyIndexer), the distances and visited set
+ * will be stored in flat arrays instead of hash tables.
+ *
+ * If `get_distance` declares a maximum weight (see with_max_weight), the
+ * frontier will be a bucket queue instead of a binary heap.
+ *
+ * Nodes are re-pushed whenever a shorter path to them is found, and stale
+ * frontier entries are skipped when popped. See dijkstra_decrease_key for a
+ * version that keeps at most one entry per node in the frontier.
+ *
  * Returns the distance and path from the source to the first target found,
  * or -1 and an empty path if not found.
  */
 template <bool use_visited = false, class Key,
           detail::ProcessNeighbors<Key> ProcessNeighbors,
           detail::GetDistance<Key> GetDistance, detail::IsTarget<Key> IsTarget,
-          detail::Visit<Key> Visit = detail::optional_func>
+          detail::Visit<Key> Visit = detail::optional_func,
+          detail::MaybeIndexer<Key> Indexer = detail::no_indexer>
 std::pair<int, std::vector<Key>>
 dijkstra(const Key &source, ProcessNeighbors &&process_neighbors,
-         GetDistance &&get_distance, IsTarget &&is_target, Visit &&visit) {
-    detail::maybe_unordered_set<Key> visited{};
-    detail::maybe_unordered_map<Key, std::pair<int, Key>> distances{};
-
-    using pq_key = std::pair<int, Key>;
-    std::priority_queue<pq_key, std::vector<pq_key>, std::greater<pq_key>>
-        frontier{};
-
-    distances[source] = {0, source};
+         GetDistance &&get_distance, IsTarget &&is_target, Visit &&visit,
+         Indexer &&indexer = {}, search_stats *stats = nullptr) {
+    using indexer_t = std::remove_cvref_t<Indexer>;
+    const perf::Scope perf_scope(std::same_as<indexer_t, detail::no_indexer>
+                                     ? "graph::dijkstra (hashed)"
+                                     : "graph::dijkstra (indexed)");
+    detail::key_set<Key, indexer_t> visited(indexer);
+    detail::key_map<Key, std::pair<int, Key>, indexer_t> distances(indexer);
+    detail::dijkstra_frontier<Key, std::remove_cvref_t<GetDistance>> frontier(
+        get_distance);
+    search_stats counts{};
+
+    distances.emplace(source, 0, source);
     frontier.emplace(0, source);
+    counts.record_push(frontier.size());
 
     while (!frontier.empty()) {
-        auto [dist, current] = std::move(frontier.top());
-        frontier.pop();
+        auto [dist, current] = frontier.pop();
+        ++counts.pops;
         if (dist != distances.at(current).first) {
             continue;
         }
@@ -660,21 +1311,25 @@ dijkstra(const Key &source, ProcessNeighbors &&process_neighbors,
         if (is_target(current)) {
             // reconstruct path
             std::vector<Key> path{current};
-            typename decltype(distances)::const_iterator it;
+            const std::pair<int, Key> *entry;
             while (path.back() != source &&
-                   (it = distances.find(path.back())) != distances.end()) {
-                path.emplace_back(it->second.second);
+                   (entry = distances.find(path.back())) != nullptr) {
+                path.emplace_back(entry->second);
             }
             std::ranges::reverse(path);
-            if constexpr (aoc::DEBUG && util::concepts::Hashable<Key>) {
+            if constexpr (aoc::DEBUG && util::concepts::Hashable<Key> &&
+                          std::same_as<indexer_t, detail::no_indexer>) {
                 std::cerr << "distances map badness: "
-                          << util::hash::unordered_map_badness(distances)
+                          << util::hash::unordered_map_badness(distances.base())
                           << "\n";
             }
+            if (stats != nullptr) {
+                *stats = counts;
+            }
             return {dist, path};
         }
         process_neighbors(current, [&get_distance, &visited, &distances,
-                                    &frontier, dist = dist,
+                                    &frontier, &counts, dist = dist,
                                     &current = current](const Key &neighbor) {
             if constexpr (use_visited) {
                 if (visited.contains(neighbor)) {
@@ -685,23 +1340,120 @@ dijkstra(const Key &source, ProcessNeighbors &&process_neighbors,
                 (void)visited;
             }
             int new_distance = dist + get_distance(current, neighbor);
-            auto it = distances.find(neighbor);
-            if (it == distances.end() || new_distance < it->second.first) {
+            std::pair<int, Key> *entry = distances.find(neighbor);
+            if (entry == nullptr || new_distance < entry->first) {
                 std::pair<int, Key> value{new_distance, current};
-                if (it != distances.end()) {
+                if (entry != nullptr) {
                     // this path has a shorter distance than one we found before
-                    it->second = std::move(value);
+                    *entry = std::move(value);
                 } else {
                     // we've never seen this node before
-                    distances.try_emplace(neighbor, std::move(value));
+                    distances.emplace(neighbor, std::move(value));
                 }
                 frontier.emplace(new_distance, neighbor);
+                counts.record_push(frontier.size());
             }
         });
         if constexpr (use_visited) {
             visited.insert(std::move(current));
         }
     }
+    if (stats != nullptr) {
+        *stats = counts;
+    }
+    return {-1, {}};
+}
+
+namespace detail {
+/**
+ * Per-node bookkeeping for the decrease-key searches.
+ */
+template <class Key>
+struct decrease_key_entry {
+    int dist;
+    Key parent;
+    ds::pooled_pairing_heap<int>::handle_type handle;
+    // true once the node has been popped from the frontier
+    bool closed = false;
+};
+} // namespace detail
+
+/**
+ * Dijkstra's algorithm with a decrease-key frontier.
+ *
+ * Takes the same arguments as dijkstra, but stores a pairing heap handle for
+ * each discovered node and updates its entry in place when a shorter path is
+ * found, so each node is pushed and popped at most once. Closed nodes are
+ * never revisited (which is equivalent to dijkstra<true>, since edge weights
+ * must be non-negative).
+ *
+ * Returns the distance and path from the source to the first target found,
+ * or -1 and an empty path if not found.
+ */
+template <class Key, detail::ProcessNeighbors<Key> ProcessNeighbors,
+          detail::GetDistance<Key> GetDistance, detail::IsTarget<Key> IsTarget,
+          detail::Visit<Key> Visit = detail::optional_func,
+          detail::MaybeIndexer<Key> Indexer = detail::no_indexer>
+std::pair<int, std::vector<Key>>
+dijkstra_decrease_key(const Key &source, ProcessNeighbors &&process_neighbors,
+                      GetDistance &&get_distance, IsTarget &&is_target,
+                      Visit &&visit, Indexer &&indexer = {},
+                      search_stats *stats = nullptr) {
+    using Entry = detail::decrease_key_entry<Key>;
+    using pq_key = std::pair<int, Key>;
+    detail::key_map<Key, Entry, std::remove_cvref_t<Indexer>> entries(indexer);
+    ds::pooled_pairing_heap<pq_key, std::greater<pq_key>> frontier{};
+    search_stats counts{};
+
+    entries.emplace(source, 0, source, frontier.emplace(0, source));
+    counts.record_push(frontier.size());
+
+    while (!frontier.empty()) {
+        const auto [dist, current] = frontier.top();
+        frontier.pop();
+        ++counts.pops;
+        Entry &current_entry = entries.at(current);
+        current_entry.closed = true;
+        visit(current, dist);
+        if (is_target(current)) {
+            // reconstruct path
+            std::vector<Key> path{current};
+            const Entry *entry;
+            while (path.back() != source &&
+                   (entry = entries.find(path.back())) != nullptr) {
+                path.emplace_back(entry->parent);
+            }
+            std::ranges::reverse(path);
+            if (stats != nullptr) {
+                *stats = counts;
+            }
+            return {dist, path};
+        }
+        process_neighbors(current, [&get_distance, &entries, &frontier,
+                                    &counts, dist = dist,
+                                    &current = current](const Key &neighbor) {
+            Entry *entry = entries.find(neighbor);
+            if (entry != nullptr && entry->closed) {
+                return;
+            }
+            int new_distance = dist + get_distance(current, neighbor);
+            if (entry == nullptr) {
+                // we've never seen this node before
+                entries.emplace(neighbor, new_distance, current,
+                                frontier.emplace(new_distance, neighbor));
+                counts.record_push(frontier.size());
+            } else if (new_distance < entry->dist) {
+                // this path has a shorter distance than one we found before
+                entry->dist = new_distance;
+                entry->parent = current;
+                frontier.update(entry->handle, {new_distance, neighbor});
+                ++counts.updates;
+            }
+        });
+    }
+    if (stats != nullptr) {
+        *stats = counts;
+    }
     return {-1, {}};
 }
 
@@ -720,9 +1472,108 @@ struct a_star_entry {
 };
 } // namespace detail
 
+/**
+ * Dijkstra's algorithm between a single source and target, searching from
+ * both ends at once.
+ *
+ * `forward_neighbors` and `reverse_neighbors` are as in bfs_bidirectional.
+ * `get_distance(from, to)` is always called with the nodes in the forward
+ * direction, even when expanding the backward search. The side with the
+ * closer frontier is expanded next, and the search stops once the sum of the
+ * two frontier distances reaches the best path found so far.
+ *
+ * `get_distance` may declare a maximum weight (see with_max_weight) and an
+ * `indexer` may be passed, just like for dijkstra.
+ *
+ * Returns the distance and path from the source to the target, or -1 and an
+ * empty path if the target is unreachable.
+ */
+template <class Key, detail::ProcessNeighbors<Key> ForwardNeighbors,
+          detail::ProcessNeighbors<Key> ReverseNeighbors,
+          detail::GetDistance<Key> GetDistance,
+          detail::MaybeIndexer<Key> Indexer = detail::no_indexer>
+std::pair<int, std::vector<Key>>
+dijkstra_bidirectional(const Key &source, const Key &target,
+                       ForwardNeighbors &&forward_neighbors,
+                       ReverseNeighbors &&reverse_neighbors,
+                       GetDistance &&get_distance, Indexer &&indexer = {}) {
+    using map_t =
+        detail::key_map<Key, std::pair<int, Key>, std::remove_cvref_t<Indexer>>;
+    using frontier_t =
+        detail::dijkstra_frontier<Key, std::remove_cvref_t<GetDistance>>;
+    if (source == target) {
+        return {0, {source}};
+    }
+    map_t forward(indexer);
+    map_t backward(indexer);
+    frontier_t forward_frontier(get_distance);
+    frontier_t backward_frontier(get_distance);
+    forward.emplace(source, 0, source);
+    backward.emplace(target, 0, target);
+    forward_frontier.emplace(0, source);
+    backward_frontier.emplace(0, target);
+
+    int best = -1;
+    std::optional<Key> best_meet{};
+
+    // pops one node from one side and relaxes its edges
+    const auto expand = [&best, &best_meet](
+                            frontier_t &frontier, map_t &distances,
+                            const map_t &other, auto &neighbors,
+                            const auto &edge_weight) {
+        auto [dist, current] = frontier.pop();
+        if (dist != distances.at(current).first) {
+            return;
+        }
+        neighbors(current, [&, dist = dist,
+                            &current = current](const Key &neighbor) {
+            int new_distance = dist + edge_weight(current, neighbor);
+            std::pair<int, Key> *entry = distances.find(neighbor);
+            if (entry != nullptr && new_distance >= entry->first) {
+                return;
+            }
+            distances.emplace(neighbor, new_distance, current);
+            frontier.emplace(new_distance, neighbor);
+            const std::pair<int, Key> *other_entry = other.find(neighbor);
+            if (other_entry != nullptr &&
+                (best == -1 || new_distance + other_entry->first < best)) {
+                best = new_distance + other_entry->first;
+                best_meet = neighbor;
+            }
+        });
+    };
+    const auto reverse_weight = [&get_distance](const Key &from,
+                                                const Key &to) {
+        return get_distance(to, from);
+    };
+
+    while (!forward_frontier.empty() && !backward_frontier.empty()) {
+        const int forward_top = forward_frontier.top_distance();
+        const int backward_top = backward_frontier.top_distance();
+        if (best != -1 && forward_top + backward_top >= best) {
+            break;
+        }
+        if (forward_top <= backward_top) {
+            expand(forward_frontier, forward, backward, forward_neighbors,
+                   get_distance);
+        } else {
+            expand(backward_frontier, backward, forward, reverse_neighbors,
+                   reverse_weight);
+        }
+    }
+    if (best == -1) {
+        return {-1, {}};
+    }
+    return {best, detail::join_bidirectional_path(source, target, *best_meet,
+                                                  forward, backward)};
+}
+
 /**
  * Generic A* search on an arbitrary weighted graph.
  *
+ * If an `indexer` is passed (see KeyIndexer), the distances will be stored in
+ * a flat array instead of a hash table.
+ *
  * Returns the distance and path from the source to the first target found,
  * or -1 and an empty path if not found.
  */
@@ -730,23 +1581,28 @@ template <bool use_visited = false, class Key,
           detail::ProcessNeighbors<Key> ProcessNeighbors,
           detail::GetDistance<Key> GetDistance, detail::IsTarget<Key> IsTarget,
           detail::Heuristic<Key> Heuristic,
-          detail::Visit<Key> Visit = detail::optional_func>
+          detail::Visit<Key> Visit = detail::optional_func,
+          detail::MaybeIndexer<Key> Indexer = detail::no_indexer>
 std::pair<int, std::vector<Key>>
 a_star(const Key &source, ProcessNeighbors &&process_neighbors,
        GetDistance &&get_distance, IsTarget &&is_target, Heuristic &&heuristic,
-       Visit &&visit) {
+       Visit &&visit, Indexer &&indexer = {}, search_stats *stats = nullptr) {
     using Entry = detail::a_star_entry<Key>;
 
-    detail::maybe_unordered_map<Key, Entry> distances{};
+    detail::key_map<Key, Entry, std::remove_cvref_t<Indexer>> distances(
+        indexer);
     std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>>
         frontier{};
+    search_stats counts{};
 
     distances.emplace(source, Entry{heuristic(source), 0, source});
     frontier.emplace(heuristic(source), 0, source);
+    counts.record_push(frontier.size());
 
     while (!frontier.empty()) {
         Entry curr = std::move(frontier.top());
         frontier.pop();
+        ++counts.pops;
         Entry &distances_entry = distances.at(curr.key);
         if (curr.dist != distances_entry.dist) {
             continue;
@@ -755,38 +1611,139 @@ a_star(const Key &source, ProcessNeighbors &&process_neighbors,
         if (is_target(curr.key)) {
             // reconstruct path
             std::vector<Key> path{curr.key};
-            typename decltype(distances)::const_iterator it;
+            const Entry *entry;
             while (path.back() != source &&
-                   (it = distances.find(path.back())) != distances.end()) {
-                path.emplace_back(it->second.key);
+                   (entry = distances.find(path.back())) != nullptr) {
+                path.emplace_back(entry->key);
             }
             std::ranges::reverse(path);
+            if (stats != nullptr) {
+                *stats = counts;
+            }
             return {curr.dist, std::move(path)};
         }
         process_neighbors(curr.key, [&get_distance, &heuristic, &distances,
-                                     &frontier, &curr](const Key &neighbor) {
-            auto it = distances.find(neighbor);
+                                     &frontier, &counts,
+                                     &curr](const Key &neighbor) {
+            Entry *entry = distances.find(neighbor);
             if constexpr (use_visited) {
-                if (it != distances.end() && it->second.visited) {
+                if (entry != nullptr && entry->visited) {
                     return;
                 }
             }
             int new_distance = curr.dist + get_distance(curr.key, neighbor);
-            if (it == distances.end() || new_distance < it->second.dist) {
+            if (entry == nullptr || new_distance < entry->dist) {
                 int new_estimate = new_distance + heuristic(neighbor);
                 Entry new_entry{new_estimate, new_distance, curr.key};
-                if (it != distances.end()) {
-                    it->second = std::move(new_entry);
+                if (entry != nullptr) {
+                    *entry = std::move(new_entry);
                 } else {
-                    distances.try_emplace(neighbor, std::move(new_entry));
+                    distances.emplace(neighbor, std::move(new_entry));
                 }
                 frontier.emplace(new_estimate, new_distance, neighbor);
+                counts.record_push(frontier.size());
             }
         });
         if constexpr (use_visited) {
             distances_entry.visited = true;
         }
     }
+    if (stats != nullptr) {
+        *stats = counts;
+    }
+    return {-1, {}};
+}
+
+/**
+ * A* search with a decrease-key frontier.
+ *
+ * Takes the same arguments as a_star, but keeps at most one frontier entry
+ * per node, updating it in place when a shorter path is found. If
+ * `use_visited` is false, closed nodes will be reopened when a shorter path
+ * to them is found (which only happens with an inconsistent heuristic).
+ *
+ * Returns the distance and path from the source to the first target found,
+ * or -1 and an empty path if not found.
+ */
+template <bool use_visited = false, class Key,
+          detail::ProcessNeighbors<Key> ProcessNeighbors,
+          detail::GetDistance<Key> GetDistance, detail::IsTarget<Key> IsTarget,
+          detail::Heuristic<Key> Heuristic,
+          detail::Visit<Key> Visit = detail::optional_func,
+          detail::MaybeIndexer<Key> Indexer = detail::no_indexer>
+std::pair<int, std::vector<Key>>
+a_star_decrease_key(const Key &source, ProcessNeighbors &&process_neighbors,
+                    GetDistance &&get_distance, IsTarget &&is_target,
+                    Heuristic &&heuristic, Visit &&visit, Indexer &&indexer = {},
+                    search_stats *stats = nullptr) {
+    using Entry = detail::decrease_key_entry<Key>;
+    using pq_key = detail::a_star_entry<Key>;
+    detail::key_map<Key, Entry, std::remove_cvref_t<Indexer>> entries(indexer);
+    ds::pooled_pairing_heap<pq_key, std::greater<pq_key>> frontier{};
+    search_stats counts{};
+
+    entries.emplace(source, 0, source,
+                    frontier.emplace(heuristic(source), 0, source));
+    counts.record_push(frontier.size());
+
+    while (!frontier.empty()) {
+        const pq_key curr = frontier.top();
+        frontier.pop();
+        ++counts.pops;
+        entries.at(curr.key).closed = true;
+        visit(curr.key, curr.dist);
+        if (is_target(curr.key)) {
+            // reconstruct path
+            std::vector<Key> path{curr.key};
+            const Entry *entry;
+            while (path.back() != source &&
+                   (entry = entries.find(path.back())) != nullptr) {
+                path.emplace_back(entry->parent);
+            }
+            std::ranges::reverse(path);
+            if (stats != nullptr) {
+                *stats = counts;
+            }
+            return {curr.dist, std::move(path)};
+        }
+        process_neighbors(curr.key, [&get_distance, &heuristic, &entries,
+                                     &frontier, &counts,
+                                     &curr](const Key &neighbor) {
+            Entry *entry = entries.find(neighbor);
+            if constexpr (use_visited) {
+                if (entry != nullptr && entry->closed) {
+                    return;
+                }
+            }
+            int new_distance = curr.dist + get_distance(curr.key, neighbor);
+            if (entry != nullptr && new_distance >= entry->dist) {
+                return;
+            }
+            pq_key new_key{new_distance + heuristic(neighbor), new_distance,
+                           neighbor};
+            if (entry == nullptr) {
+                // we've never seen this node before
+                entries.emplace(neighbor, new_distance, curr.key,
+                                frontier.push(std::move(new_key)));
+                counts.record_push(frontier.size());
+            } else if (entry->closed) {
+                // reopen a closed node
+                entry->dist = new_distance;
+                entry->parent = curr.key;
+                entry->handle = frontier.push(std::move(new_key));
+                entry->closed = false;
+                counts.record_push(frontier.size());
+            } else {
+                entry->dist = new_distance;
+                entry->parent = curr.key;
+                frontier.update(entry->handle, new_key);
+                ++counts.updates;
+            }
+        });
+    }
+    if (stats != nullptr) {
+        *stats = counts;
+    }
     return {-1, {}};
 }
 
@@ -831,6 +1788,13 @@ shortest_distances(const Key &source, ProcessNeighbors &&process_neighbors,
 // instantiate templates in an anonymous namespace, so static analyzers will
 // check these functions
 namespace {
+template <class Key>
+struct _lint_indexer {
+    std::function<std::size_t(const Key &)> index;
+    std::size_t operator()(const Key &key) const { return index(key); }
+    std::size_t size() const { return 100; }
+};
+
 template <class Key>
 void _lint_helper_template(
     const Key &source,
@@ -844,6 +1808,7 @@ void _lint_helper_template(
     std::function<int(const Key &, const Key &)> get_distance,
     std::function<int(const Key &)> heuristic) {
     const std::vector<Key> sources_vec{source, source};
+    const _lint_indexer<Key> indexer{[](const Key &) { return 0; }};
 
     bfs<true>(source, process_neighbors, is_target, {});
     bfs<true>(source, process_neighbors, {}, visit);
@@ -878,6 +1843,15 @@ void _lint_helper_template(
     bfs<false>(sources_vec, process_neighbors, is_target, visit);
     bfs<false>(sources_vec, process_neighbors, is_target, visit_bool);
 
+    bfs<true>(source, process_neighbors, is_target, {}, indexer);
+    bfs<true>(source, process_neighbors, {}, visit_bool, indexer);
+    bfs<false>({source, source}, process_neighbors, is_target, visit, indexer);
+    bfs<true>(sources_vec, process_neighbors, is_target, visit_bool, indexer);
+
+    bfs_bidirectional(source, source, process_neighbors, process_neighbors);
+    bfs_bidirectional(source, source, process_neighbors, process_neighbors,
+                      indexer);
+
     bfs_manual_dedupe(source, process_neighbors, is_target, {});
     bfs_manual_dedupe(source, process_neighbors, {}, visit);
     bfs_manual_dedupe(source, process_neighbors, {}, visit_bool);
@@ -919,6 +1893,35 @@ void _lint_helper_template(
     dijkstra<false>(source, process_neighbors, get_distance, is_target, visit);
     dijkstra<true>(source, process_neighbors, get_distance, is_target, {});
     dijkstra<true>(source, process_neighbors, get_distance, is_target, visit);
+    dijkstra<false>(source, process_neighbors, get_distance, is_target, {},
+                    indexer);
+    dijkstra<true>(source, process_neighbors, get_distance, is_target, visit,
+                   indexer);
+    dijkstra<false>(source, process_neighbors, with_max_weight(1, get_distance),
+                    is_target, {});
+    dijkstra<true>(source, process_neighbors, with_max_weight(9, get_distance),
+                   is_target, visit, indexer);
+    search_stats stats;
+    dijkstra<false>(source, process_neighbors, get_distance, is_target, {}, {},
+                    &stats);
+    dijkstra<true>(source, process_neighbors, with_max_weight(9, get_distance),
+                   is_target, visit, indexer, &stats);
+
+    dijkstra_decrease_key(source, process_neighbors, get_distance, is_target,
+                          {});
+    dijkstra_bidirectional(source, source, process_neighbors,
+                           process_neighbors, get_distance);
+    dijkstra_bidirectional(source, source, process_neighbors,
+                           process_neighbors, with_max_weight(9, get_distance),
+                           indexer);
+    dijkstra_decrease_key(source, process_neighbors, get_distance, is_target,
+                          visit);
+    dijkstra_decrease_key(source, process_neighbors, get_distance, is_target,
+                          {}, indexer);
+    dijkstra_decrease_key(source, process_neighbors, get_distance, is_target,
+                          visit, {}, &stats);
+    dijkstra_decrease_key(source, process_neighbors, get_distance, is_target,
+                          visit, indexer, &stats);
 
     a_star<false>(source, process_neighbors, get_distance, is_target, heuristic,
                   {});
@@ -928,6 +1931,21 @@ void _lint_helper_template(
                  {});
     a_star<true>(source, process_neighbors, get_distance, is_target, heuristic,
                  visit);
+    a_star<false>(source, process_neighbors, get_distance, is_target, heuristic,
+                  {}, indexer);
+    a_star<true>(source, process_neighbors, get_distance, is_target, heuristic,
+                 visit, indexer);
+    a_star<false>(source, process_neighbors, get_distance, is_target, heuristic,
+                  {}, {}, &stats);
+
+    a_star_decrease_key<false>(source, process_neighbors, get_distance,
+                               is_target, heuristic, {});
+    a_star_decrease_key<true>(source, process_neighbors, get_distance,
+                              is_target, heuristic, visit);
+    a_star_decrease_key<false>(source, process_neighbors, get_distance,
+                               is_target, heuristic, visit, indexer);
+    a_star_decrease_key<true>(source, process_neighbors, get_distance,
+                              is_target, heuristic, {}, indexer, &stats);
 
     shortest_distances(source, process_neighbors, get_distance);
 }
@@ -0,0 +1,499 @@
+/******************************************************************************
+ * File:        ilp.hpp
+ *
+ * Author:      Eric T. Johnson (yut23)
+ * Created:     2026-10-17
+ * Description: Branch-and-bound solver for small integer linear programs.
+ *****************************************************************************/
+
+#ifndef ILP_HPP_8FJ3WQ2C
+#define ILP_HPP_8FJ3WQ2C
+
+#include "ds/grid.hpp"    // for Grid
+#include "gauss_elim.hpp" // for reduced_row_echelon
+#include "lib.hpp"        // for DEBUG
+#include <algorithm>      // for min
+#include <cassert>        // for assert
+#include <cmath>          // for floor, ceil, round, abs
+#include <concepts>       // for signed_integral
+#include <cstddef>        // for size_t
+#include <iostream>       // for cerr
+#include <limits>         // for numeric_limits
+#include <optional>       // for optional
+#include <utility>        // for move
+#include <vector>         // for vector
+
+namespace aoc::math {
+
+/// Counters for ilp_min_sum.
+struct ilp_stats {
+    // branch-and-bound nodes visited (including pruned ones)
+    long nodes = 0;
+    // LP relaxations solved
+    long lp_solves = 0;
+    // simplex pivots, over all the LP relaxations
+    long pivots = 0;
+};
+
+namespace detail {
+
+constexpr double LP_EPS = 1e-9;
+
+struct lp_solution {
+    double value;
+    std::vector<double> z;
+};
+
+/**
+ * Dense two-phase simplex with Bland's rule, for small problems.
+ *
+ * Minimizes c.z subject to G z <= h and z >= 0, where G has one row per
+ * constraint. Returns {} if the constraints are infeasible. The objective
+ * must be bounded below on the feasible region.
+ */
+std::optional<lp_solution> simplex_min(const std::vector<std::vector<double>> &G,
+                                       const std::vector<double> &h,
+                                       const std::vector<double> &c,
+                                       long &pivots) {
+    const int rows = G.size();
+    const int num_vars = c.size();
+    if (rows == 0) {
+        // z = 0 is optimal, since the objective must be bounded
+        return lp_solution{0.0, std::vector<double>(num_vars, 0.0)};
+    }
+    int num_artificial = 0;
+    for (double value : h) {
+        if (value < 0) {
+            ++num_artificial;
+        }
+    }
+    // columns: structural variables, slacks, artificials, then the RHS
+    const int first_artificial = num_vars + rows;
+    const int cols = first_artificial + num_artificial;
+    aoc::ds::Grid<double> tab(cols + 1, rows, 0.0);
+    std::vector<int> basis(rows);
+    for (int r = 0, a = first_artificial; r < rows; ++r) {
+        // negate rows with a negative RHS, and give them an artificial
+        // variable to start from instead of the slack
+        const double sign = h[r] < 0 ? -1 : 1;
+        for (int j = 0; j < num_vars; ++j) {
+            tab.at(j, r) = sign * G[r][j];
+        }
+        tab.at(num_vars + r, r) = sign;
+        tab.at(cols, r) = sign * h[r];
+        if (h[r] < 0) {
+            tab.at(a, r) = 1;
+            basis[r] = a++;
+        } else {
+            basis[r] = num_vars + r;
+        }
+    }
+
+    std::vector<double> reduced_costs(cols);
+    const auto price = [&](const std::vector<double> &costs) {
+        for (int j = 0; j < cols; ++j) {
+            reduced_costs[j] = costs[j];
+            for (int r = 0; r < rows; ++r) {
+                reduced_costs[j] -= costs[basis[r]] * tab.at(j, r);
+            }
+        }
+    };
+    const auto pivot = [&](int row, int col) {
+        ++pivots;
+        const double p = tab.at(col, row);
+        for (int j = 0; j <= cols; ++j) {
+            tab.at(j, row) /= p;
+        }
+        for (int r = 0; r < rows; ++r) {
+            const double f = tab.at(col, r);
+            if (r != row && f != 0) {
+                for (int j = 0; j <= cols; ++j) {
+                    tab.at(j, r) -= f * tab.at(j, row);
+                }
+            }
+        }
+        const double f = reduced_costs[col];
+        for (int j = 0; j < cols; ++j) {
+            reduced_costs[j] -= f * tab.at(j, row);
+        }
+        basis[row] = col;
+    };
+    // runs the simplex method on columns [0, max_col), returns false if the
+    // objective is unbounded
+    const auto optimize = [&](int max_col) {
+        while (true) {
+            int col = 0;
+            while (col < max_col && reduced_costs[col] >= -LP_EPS) {
+                ++col;
+            }
+            if (col == max_col) {
+                return true;
+            }
+            int row = -1;
+            double best_ratio = 0;
+            for (int r = 0; r < rows; ++r) {
+                if (tab.at(col, r) > LP_EPS) {
+                    const double ratio = tab.at(cols, r) / tab.at(col, r);
+                    if (row == -1 || ratio < best_ratio - LP_EPS ||
+                        (ratio < best_ratio + LP_EPS && basis[r] < basis[row])) {
+                        row = r;
+                        best_ratio = ratio;
+                    }
+                }
+            }
+            if (row == -1) {
+                return false;
+            }
+            pivot(row, col);
+        }
+    };
+
+    if (num_artificial > 0) {
+        // phase 1: minimize the sum of the artificial variables
+        std::vector<double> costs(cols, 0.0);
+        for (int j = first_artificial; j < cols; ++j) {
+            costs[j] = 1;
+        }
+        price(costs);
+        optimize(cols);
+        double infeasibility = 0;
+        for (int r = 0; r < rows; ++r) {
+            if (basis[r] >= first_artificial) {
+                infeasibility += tab.at(cols, r);
+            }
+        }
+        if (infeasibility > 1e-7) {
+            return {};
+        }
+        // drive any remaining (zero) artificial variables out of the basis;
+        // if a row has no other non-zero entries, it's redundant and the
+        // artificial variable stays at zero
+        for (int r = 0; r < rows; ++r) {
+            if (basis[r] < first_artificial) {
+                continue;
+            }
+            for (int j = 0; j < first_artificial; ++j) {
+                if (std::abs(tab.at(j, r)) > LP_EPS) {
+                    pivot(r, j);
+                    break;
+                }
+            }
+        }
+    }
+
+    // phase 2: minimize the real objective, without the artificial variables
+    std::vector<double> costs(cols, 0.0);
+    for (int j = 0; j < num_vars; ++j) {
+        costs[j] = c[j];
+    }
+    price(costs);
+    [[maybe_unused]] const bool bounded = optimize(first_artificial);
+    assert(bounded);
+
+    lp_solution solution{0.0, std::vector<double>(num_vars, 0.0)};
+    for (int r = 0; r < rows; ++r) {
+        if (basis[r] < num_vars) {
+            solution.z[basis[r]] = tab.at(cols, r);
+        }
+    }
+    for (int j = 0; j < num_vars; ++j) {
+        solution.value += c[j] * solution.z[j];
+    }
+    return solution;
+}
+
+/**
+ * The system A x = b after Gauss-Jordan elimination, with each pivot variable
+ * written in terms of the free variables:
+ *
+ *   x[pivot_vars[r]] = (rhs[r] - sum_f coeffs[r][f] * x[free_vars[f]])
+ *                      / divisors[r]
+ */
+template <std::signed_integral T>
+struct reduced_system {
+    int num_vars = 0;
+    std::vector<int> pivot_vars{};
+    std::vector<int> free_vars{};
+    std::vector<T> rhs{};
+    std::vector<T> divisors{};
+    std::vector<std::vector<T>> coeffs{};
+};
+
+/**
+ * Reduces A x = b with reduced_row_echelon. Returns {} if the system is
+ * inconsistent.
+ */
+template <std::signed_integral T>
+std::optional<reduced_system<T>> reduce_system(aoc::ds::Grid<T> A,
+                                               std::vector<T> b) {
+    reduced_system<T> sys;
+    sys.num_vars = A.width;
+    const int rank = aoc::math::reduced_row_echelon(A, b);
+    for (int r = rank; r < A.height; ++r) {
+        // 0 = b[r]
+        if (b[r] != 0) {
+            return {};
+        }
+    }
+    std::vector<bool> is_pivot(A.width, false);
+    for (int r = 0; r < rank; ++r) {
+        int col = 0;
+        while (A.at(col, r) == 0) {
+            ++col;
+        }
+        is_pivot[col] = true;
+        sys.pivot_vars.push_back(col);
+    }
+    for (int col = 0; col < A.width; ++col) {
+        if (!is_pivot[col]) {
+            sys.free_vars.push_back(col);
+        }
+    }
+    for (int r = 0; r < rank; ++r) {
+        // pivots are always positive
+        sys.divisors.push_back(A.at(sys.pivot_vars[r], r));
+        sys.rhs.push_back(b[r]);
+        auto &row = sys.coeffs.emplace_back();
+        for (int f : sys.free_vars) {
+            row.push_back(A.at(f, r));
+        }
+    }
+    return sys;
+}
+
+template <std::signed_integral T>
+class min_sum_solver {
+    static constexpr long INF = std::numeric_limits<long>::max();
+
+    const reduced_system<T> &sys;
+    ilp_stats &stats;
+    // objective = base_value + sum_f objective_coeffs[f] * x[free_vars[f]]
+    double base_value = 0;
+    std::vector<double> objective_coeffs{};
+    std::optional<T> best{};
+
+    /// Checks an integral assignment of the free variables exactly.
+    std::optional<T> evaluate(const std::vector<long> &lo,
+                              const std::vector<long> &hi,
+                              const std::vector<T> &free_values) const {
+        T total = 0;
+        for (std::size_t f = 0; f < free_values.size(); ++f) {
+            total += free_values[f];
+        }
+        for (std::size_t r = 0; r < sys.pivot_vars.size(); ++r) {
+            T numerator = sys.rhs[r];
+            for (std::size_t f = 0; f < free_values.size(); ++f) {
+                numerator -= sys.coeffs[r][f] * free_values[f];
+            }
+            if (numerator % sys.divisors[r] != 0) {
+                return {};
+            }
+            const T value = numerator / sys.divisors[r];
+            const int var = sys.pivot_vars[r];
+            if (value < lo[var] || value > hi[var]) {
+                return {};
+            }
+            total += value;
+        }
+        return total;
+    }
+
+    void branch(std::vector<long> &lo, std::vector<long> &hi) {
+        ++stats.nodes;
+        const std::size_t k = sys.free_vars.size();
+
+        // set up the LP relaxation over z = x_free - lo_free >= 0
+        std::vector<std::vector<double>> G;
+        std::vector<double> h;
+        for (std::size_t f = 0; f < k; ++f) {
+            const int var = sys.free_vars[f];
+            if (hi[var] < lo[var]) {
+                return;
+            }
+            if (hi[var] != INF) {
+                G.emplace_back(k, 0.0)[f] = 1;
+                h.push_back(hi[var] - lo[var]);
+            }
+        }
+        for (std::size_t r = 0; r < sys.pivot_vars.size(); ++r) {
+            const int var = sys.pivot_vars[r];
+            if (hi[var] < lo[var]) {
+                return;
+            }
+            // sum_f coeffs[r][f] * x_f = rhs[r] - divisors[r] * x_pivot
+            double shifted_rhs = sys.rhs[r];
+            std::vector<double> row(k);
+            for (std::size_t f = 0; f < k; ++f) {
+                row[f] = sys.coeffs[r][f];
+                shifted_rhs -= row[f] * lo[sys.free_vars[f]];
+            }
+            // x_pivot >= lo
+            G.push_back(row);
+            h.push_back(shifted_rhs - double(sys.divisors[r]) * lo[var]);
+            if (hi[var] != INF) {
+                // x_pivot <= hi
+                for (double &value : row) {
+                    value = -value;
+                }
+                G.push_back(std::move(row));
+                h.push_back(double(sys.divisors[r]) * hi[var] - shifted_rhs);
+            }
+        }
+        double offset = base_value;
+        for (std::size_t f = 0; f < k; ++f) {
+            offset += objective_coeffs[f] * lo[sys.free_vars[f]];
+        }
+
+        ++stats.lp_solves;
+        auto lp = simplex_min(G, h, objective_coeffs, stats.pivots);
+        if (!lp) {
+            return;
+        }
+        const double bound = offset + lp->value;
+        if (best && std::ceil(bound - 1e-6) >= *best) {
+            return;
+        }
+
+        // find the most fractional variable in the relaxed solution
+        std::vector<double> x(sys.num_vars);
+        for (std::size_t f = 0; f < k; ++f) {
+            x[sys.free_vars[f]] = lo[sys.free_vars[f]] + lp->z[f];
+        }
+        for (std::size_t r = 0; r < sys.pivot_vars.size(); ++r) {
+            double numerator = sys.rhs[r];
+            for (std::size_t f = 0; f < k; ++f) {
+                numerator -= sys.coeffs[r][f] * x[sys.free_vars[f]];
+            }
+            x[sys.pivot_vars[r]] = numerator / sys.divisors[r];
+        }
+        int branch_var = -1;
+        double max_frac = 1e-6;
+        for (int var = 0; var < sys.num_vars; ++var) {
+            const double frac = std::abs(x[var] - std::round(x[var]));
+            if (frac > max_frac) {
+                max_frac = frac;
+                branch_var = var;
+            }
+        }
+
+        if (branch_var == -1) {
+            std::vector<T> free_values(k);
+            for (std::size_t f = 0; f < k; ++f) {
+                free_values[f] = std::round(x[sys.free_vars[f]]);
+            }
+            if (auto total = evaluate(lo, hi, free_values);
+                total && (!best || *total < *best)) {
+                best = total;
+                if constexpr (aoc::DEBUG) {
+                    std::cerr << "ilp: new best " << *best << " at node "
+                              << stats.nodes << "\n";
+                }
+            }
+            return;
+        }
+
+        // x[branch_var] <= floor(value) or x[branch_var] >= ceil(value),
+        // trying the closer side first
+        const double value = x[branch_var];
+        const long down = std::floor(value);
+        const long old_lo = lo[branch_var];
+        const long old_hi = hi[branch_var];
+        const auto branch_down = [&]() {
+            hi[branch_var] = down;
+            branch(lo, hi);
+            hi[branch_var] = old_hi;
+        };
+        const auto branch_up = [&]() {
+            lo[branch_var] = down + 1;
+            branch(lo, hi);
+            lo[branch_var] = old_lo;
+        };
+        if (value - down < 0.5) {
+            branch_down();
+            branch_up();
+        } else {
+            branch_up();
+            branch_down();
+        }
+    }
+
+  public:
+    min_sum_solver(const reduced_system<T> &sys, ilp_stats &stats)
+        : sys(sys), stats(stats), objective_coeffs(sys.free_vars.size(), 1.0) {
+        for (std::size_t r = 0; r < sys.pivot_vars.size(); ++r) {
+            base_value += double(sys.rhs[r]) / sys.divisors[r];
+            for (std::size_t f = 0; f < sys.free_vars.size(); ++f) {
+                objective_coeffs[f] -=
+                    double(sys.coeffs[r][f]) / sys.divisors[r];
+            }
+        }
+    }
+
+    std::optional<T> solve(std::vector<long> lo, std::vector<long> hi) {
+        branch(lo, hi);
+        return best;
+    }
+};
+
+} // namespace detail
+
+/**
+ * Minimizes sum(x) subject to A x = b, with x a vector of non-negative
+ * integers, by branch and bound.
+ *
+ * The system is first reduced with reduced_row_echelon, so only the free
+ * variables appear in the LP relaxations, which are solved with a small dense
+ * simplex.
+ * Each node branches on the most fractional variable (free or pivot) of its
+ * relaxed solution, and is pruned once its bound can't beat the best integer
+ * solution found so far.
+ *
+ * Every variable with a positive coefficient in a row whose coefficients are
+ * all non-negative is bounded above by that row. Other variables are
+ * unbounded, so if there are any, the search may not terminate when the
+ * problem has no integer solutions.
+ *
+ * Returns the minimum sum, or {} if there are no solutions.
+ */
+template <std::signed_integral T>
+std::optional<T> ilp_min_sum(const aoc::ds::Grid<T> &A, const std::vector<T> &b,
+                             ilp_stats *stats = nullptr) {
+    assert(b.size() == static_cast<std::size_t>(A.height));
+    constexpr long INF = std::numeric_limits<long>::max();
+    std::vector<long> lo(A.width, 0);
+    std::vector<long> hi(A.width, INF);
+    for (int r = 0; r < A.height; ++r) {
+        bool nonnegative = true;
+        for (int c = 0; c < A.width && nonnegative; ++c) {
+            nonnegative = A.at(c, r) >= 0;
+        }
+        if (!nonnegative) {
+            continue;
+        }
+        for (int c = 0; c < A.width; ++c) {
+            if (A.at(c, r) > 0) {
+                // x[c] <= b[r] / A[r, c], rounding towards -infinity
+                long bound = b[r] / A.at(c, r);
+                if (b[r] < 0 && b[r] % A.at(c, r) != 0) {
+                    --bound;
+                }
+                hi[c] = std::min(hi[c], bound);
+            }
+        }
+    }
+
+    ilp_stats local_stats;
+    if (stats == nullptr) {
+        stats = &local_stats;
+    }
+    auto sys = detail::reduce_system(A, b);
+    if (!sys) {
+        return {};
+    }
+    return detail::min_sum_solver<T>(*sys, *stats).solve(std::move(lo),
+                                                         std::move(hi));
+}
+
+} // namespace aoc::math
+
+#endif /* end of include guard: ILP_HPP_8FJ3WQ2C */
@@ -0,0 +1,206 @@
+/******************************************************************************
+ * File:        incremental_path.hpp
+ *
+ * Author:      Eric T. Johnson (yut23)
+ * Created:     2026-10-16
+ * Description: Incremental shortest paths on a grid that changes between
+ *              queries (Lifelong Planning A*).
+ *****************************************************************************/
+
+#ifndef INCREMENTAL_PATH_HPP_R7XK2M4Q
+#define INCREMENTAL_PATH_HPP_R7XK2M4Q
+
+#include "ds/grid.hpp" // for Grid
+#include "lib.hpp"     // for Pos, Delta, DIRECTIONS
+#include <algorithm>   // for min, reverse
+#include <cassert>     // for assert
+#include <functional>  // for greater
+#include <limits>      // for numeric_limits
+#include <queue>       // for priority_queue
+#include <utility>     // for pair
+#include <vector>      // for vector
+
+namespace aoc::graph {
+
+/**
+ * Shortest path between two fixed cells on a 4-connected grid of open (true)
+ * and blocked (false) cells, with unit step costs.
+ *
+ * Cells can be blocked or reopened between queries. Each query only
+ * re-expands the cells whose distance from the source was affected by the
+ * changes since the previous one (Koenig, Likhachev & Furcy, "Lifelong
+ * Planning A*", 2004), so a sequence of small edits is much cheaper than
+ * rerunning a full search after each one.
+ */
+class IncrementalGridPath {
+    static constexpr int INF = std::numeric_limits<int>::max() / 4;
+    // (min(g, rhs) + h, min(g, rhs)), compared lexicographically
+    using key_type = std::pair<int, int>;
+    using entry_type = std::pair<key_type, Pos>;
+
+    ds::Grid<bool> m_open;
+    Pos m_source;
+    Pos m_target;
+    // g: current distance estimate; rhs: one-step lookahead from the
+    // neighbors' g values. Cells where these differ are in the queue.
+    ds::Grid<int> m_g;
+    ds::Grid<int> m_rhs;
+    // may contain stale entries, which are skipped when they reach the top
+    std::priority_queue<entry_type, std::vector<entry_type>,
+                        std::greater<entry_type>>
+        m_queue{};
+
+    int heuristic(const Pos &pos) const {
+        return (pos - m_target).manhattan_distance();
+    }
+
+    key_type calculate_key(const Pos &pos) const {
+        int dist = std::min(m_g[pos], m_rhs[pos]);
+        return {dist == INF ? INF : dist + heuristic(pos), dist};
+    }
+
+    template <class Func>
+    void for_each_neighbor(const Pos &pos, Func &&func) const {
+        for (const AbsDirection dir : DIRECTIONS) {
+            Pos neighbor = pos + Delta(dir, true);
+            if (m_open.in_bounds(neighbor) && m_open[neighbor]) {
+                func(neighbor);
+            }
+        }
+    }
+
+    void update_vertex(const Pos &pos) {
+        if (pos != m_source) {
+            int rhs = INF;
+            if (m_open[pos]) {
+                for_each_neighbor(pos, [this, &rhs](const Pos &neighbor) {
+                    rhs = std::min(rhs, m_g[neighbor] + 1);
+                });
+            }
+            m_rhs[pos] = std::min(rhs, INF);
+        }
+        if (m_g[pos] != m_rhs[pos]) {
+            m_queue.emplace(calculate_key(pos), pos);
+        }
+    }
+
+    /// drops stale entries from the top of the queue
+    void skip_stale() {
+        while (!m_queue.empty()) {
+            const auto &[key, pos] = m_queue.top();
+            if (m_g[pos] != m_rhs[pos] && key == calculate_key(pos)) {
+                return;
+            }
+            m_queue.pop();
+        }
+    }
+
+    void compute_shortest_path() {
+        for (skip_stale(); !m_queue.empty() &&
+                           (m_queue.top().first < calculate_key(m_target) ||
+                            m_g[m_target] != m_rhs[m_target]);
+             skip_stale()) {
+            Pos pos = m_queue.top().second;
+            m_queue.pop();
+            if (m_g[pos] > m_rhs[pos]) {
+                // overconsistent: the distance went down
+                m_g[pos] = m_rhs[pos];
+            } else {
+                // underconsistent: the distance went up
+                m_g[pos] = INF;
+                update_vertex(pos);
+            }
+            for_each_neighbor(
+                pos, [this](const Pos &neighbor) { update_vertex(neighbor); });
+        }
+    }
+
+    /// updates the distances around a cell after it changes state
+    void cell_changed(const Pos &pos) {
+        update_vertex(pos);
+        for (const AbsDirection dir : DIRECTIONS) {
+            Pos neighbor = pos + Delta(dir, true);
+            if (m_open.in_bounds(neighbor)) {
+                update_vertex(neighbor);
+            }
+        }
+    }
+
+  public:
+    IncrementalGridPath(const ds::Grid<bool> &open, const Pos &source,
+                        const Pos &target)
+        : m_open(open), m_source(source), m_target(target),
+          m_g(open.width, open.height, INF),
+          m_rhs(open.width, open.height, INF) {
+        assert(m_open.in_bounds(source) && m_open.in_bounds(target));
+        if (m_open[m_source]) {
+            m_rhs[m_source] = 0;
+            m_queue.emplace(calculate_key(m_source), m_source);
+        }
+    }
+
+    /// Returns whether a cell is currently open.
+    bool is_open(const Pos &pos) const { return m_open[pos]; }
+
+    /// Marks a cell as blocked. Does nothing if it was already blocked.
+    void block(const Pos &pos) {
+        if (!m_open[pos]) {
+            return;
+        }
+        m_open[pos] = false;
+        if (pos == m_source) {
+            m_rhs[pos] = INF;
+        }
+        cell_changed(pos);
+    }
+
+    /// Marks a cell as open. Does nothing if it was already open.
+    void unblock(const Pos &pos) {
+        if (m_open[pos]) {
+            return;
+        }
+        m_open[pos] = true;
+        if (pos == m_source) {
+            m_rhs[pos] = 0;
+        }
+        cell_changed(pos);
+    }
+
+    /**
+     * Returns the length of the shortest path from the source to the target,
+     * or -1 if the target is unreachable.
+     */
+    int query() {
+        compute_shortest_path();
+        return m_g[m_target] == INF ? -1 : m_g[m_target];
+    }
+
+    /**
+     * Returns the cells along a shortest path from the source to the target
+     * (inclusive), or an empty vector if the target is unreachable.
+     */
+    std::vector<Pos> path() {
+        if (query() < 0) {
+            return {};
+        }
+        // walk back from the target along decreasing g values
+        std::vector<Pos> path{m_target};
+        while (path.back() != m_source) {
+            const Pos &pos = path.back();
+            Pos next = pos;
+            for_each_neighbor(pos, [this, &pos, &next](const Pos &neighbor) {
+                if (m_g[neighbor] + 1 == m_g[pos]) {
+                    next = neighbor;
+                }
+            });
+            assert(next != pos);
+            path.push_back(next);
+        }
+        std::ranges::reverse(path);
+        return path;
+    }
+};
+
+} // namespace aoc::graph
+
+#endif /* end of include guard: INCREMENTAL_PATH_HPP_R7XK2M4Q */
@@ -9,20 +9,27 @@
 #ifndef LIB_HPP_0IZKV7KG
 #define LIB_HPP_0IZKV7KG
 
-#include "util/concepts.hpp" // for same_as_any
-#include "util/hash.hpp"     // for make_hash
-#include "util/util.hpp"     // for reveal_type  // IWYU pragma: keep
-#include <algorithm>         // for max, min  // IWYU pragma: keep
-#include <cassert>           // for assert
-#include <compare>           // for strong_ordering
-#include <concepts>          // for integral
-#include <cstdlib>           // for abs, size_t, exit
-#include <fstream>           // for ifstream  // IWYU pragma: keep
-#include <functional>        // for hash
-#include <initializer_list>  // for initializer_list
-#include <iostream>          // for cout
-#include <iterator>          // for istreambuf_iterator
-#include <string>            // for string, operator==
+#include "util/concepts.hpp"    // for same_as_any
+#include "util/digit_scan.hpp"  // for for_each_digit_run
+#include "util/hash.hpp"        // for make_hash
+#include "util/mapped_file.hpp" // for MappedFile
+#include "util/util.hpp"        // for reveal_type  // IWYU pragma: keep
+#include <algorithm>            // for max, min  // IWYU pragma: keep
+#include <cassert>              // for assert
+#include <charconv>             // for from_chars
+#include <compare>              // for strong_ordering
+#include <concepts>             // for integral
+#include <cstddef>              // for ptrdiff_t
+#include <cstdlib>              // for abs, size_t, exit
+#include <fstream>              // for ifstream  // IWYU pragma: keep
+#include <functional>           // for hash
+#include <initializer_list>     // for initializer_list
+#include <iostream>             // for cout
+#include <iterator>             // for istreambuf_iterator, default_sentinel_t
+#include <limits>               // for numeric_limits
+#include <string>               // for string, operator==
+#include <string_view>          // for string_view
+#include <system_error>         // for errc
 #include <type_traits> // for underlying_type_t, is_same_v, is_signed_v, conditional_t, is_const_v
 #include <utility> // for move
 #include <vector>  // for vector
@@ -688,6 +695,15 @@ struct Arguments {
     std::ifstream infile;
     std::string filename;
     InputType input_type;
+
+    /**
+     * @brief Maps the input file into memory, for zero-copy parsing with the
+     * std::string_view overloads below.
+     *
+     * The returned object owns the mapping, so it must outlive any views into
+     * it.
+     */
+    util::MappedFile map_infile() const { return util::MappedFile(filename); }
 };
 
 /**
@@ -744,6 +760,246 @@ std::vector<T> read_vector(std::istream &is) {
     return vec;
 }
 
+/**
+ * @brief Range of the pieces of a string between occurrences of a delimiter.
+ *
+ * A trailing delimiter does not produce an empty final piece, so splitting on
+ * '\n' gives the same lines as std::getline. If `skip_empty` is set, runs of
+ * delimiters are treated as a single separator.
+ */
+class split_view {
+    std::string_view m_str;
+    char m_delim;
+    bool m_skip_empty;
+
+  public:
+    class iterator {
+        std::string_view m_rest{};
+        std::string_view m_current{};
+        char m_delim = '\n';
+        bool m_skip_empty = false;
+        bool m_done = true;
+
+        void advance() {
+            if (m_skip_empty) {
+                std::size_t start = m_rest.find_first_not_of(m_delim);
+                m_rest.remove_prefix(std::min(start, m_rest.size()));
+            }
+            if (m_rest.empty()) {
+                m_done = true;
+                return;
+            }
+            std::size_t pos = m_rest.find(m_delim);
+            m_current = m_rest.substr(0, pos);
+            if (pos == std::string_view::npos) {
+                m_rest = {};
+            } else {
+                m_rest.remove_prefix(pos + 1);
+            }
+        }
+
+      public:
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+        iterator(std::string_view str, char delim, bool skip_empty)
+            : m_rest(str), m_delim(delim), m_skip_empty(skip_empty),
+              m_done(false) {
+            advance();
+        }
+
+        std::string_view operator*() const { return m_current; }
+        iterator &operator++() {
+            advance();
+            return *this;
+        }
+        iterator operator++(int) {
+            iterator tmp = *this;
+            advance();
+            return tmp;
+        }
+        bool operator==(std::default_sentinel_t) const { return m_done; }
+    };
+
+    split_view(std::string_view str, char delim, bool skip_empty = false)
+        : m_str(str), m_delim(delim), m_skip_empty(skip_empty) {}
+
+    iterator begin() const { return {m_str, m_delim, m_skip_empty}; }
+    std::default_sentinel_t end() const { return {}; }
+};
+
+/**
+ * @brief Iterates over the lines of a string, without copying them.
+ */
+split_view lines(std::string_view text) { return split_view(text, '\n'); }
+
+/**
+ * @brief Iterates over the fields of a line, separated by runs of `delim`.
+ */
+split_view fields(std::string_view line, char delim = ' ') {
+    return split_view(line, delim, true);
+}
+
+/**
+ * @brief Reads lines from a string, as views into it.
+ */
+std::vector<std::string_view> read_lines(std::string_view text) {
+    std::vector<std::string_view> result;
+    for (std::string_view line : lines(text)) {
+        result.push_back(line);
+    }
+    return result;
+}
+
+/**
+ * @brief Parses an integer from the front of a string, skipping leading
+ * whitespace.
+ *
+ * On success, stores the value, removes it from the front of `text`, and
+ * returns true. On failure, returns false and leaves `value` unchanged. Like
+ * `operator>>`, an explicit '+' sign is accepted.
+ */
+template <std::integral T>
+bool scan_int(std::string_view &text, T &value) {
+    const char *first = text.data();
+    const char *last = first + text.size();
+    while (first != last &&
+           (*first == ' ' || *first == '\n' || *first == '\t' ||
+            *first == '\r')) {
+        ++first;
+    }
+    text.remove_prefix(first - text.data());
+    if (first == last) {
+        return false;
+    }
+    if (*first == '+' && last - first > 1 && first[1] != '-') {
+        ++first;
+    }
+    auto [ptr, ec] = std::from_chars(first, last, value);
+    if (ec != std::errc{}) {
+        return false;
+    }
+    text.remove_prefix(ptr - text.data());
+    return true;
+}
+
+namespace detail {
+/**
+ * Parses the digits in [begin, end) as a T. If `negative` is set, begin[-1]
+ * must be the minus sign. Returns false if the value doesn't fit.
+ */
+template <std::integral T>
+bool parse_digit_run(const char *begin, const char *end, bool negative,
+                     T &value) {
+    if (end - begin <= std::numeric_limits<T>::digits10) {
+        // can't overflow
+        unsigned long long magnitude = 0;
+        for (const char *p = begin; p != end; ++p) {
+            magnitude = magnitude * 10 + (*p - '0');
+        }
+        value = negative ? static_cast<T>(-static_cast<long long>(magnitude))
+                         : static_cast<T>(magnitude);
+        return true;
+    }
+    return std::from_chars(begin - negative, end, value).ec == std::errc{};
+}
+
+bool is_space(char ch) {
+    return ch == ' ' || ch == '\n' || ch == '\t' || ch == '\r' || ch == '\v' ||
+           ch == '\f';
+}
+
+bool all_space(std::string_view text) {
+    for (char ch : text) {
+        if (!is_space(ch)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Extracts integers from `text` using util::for_each_digit_run.
+ *
+ * `accept_gap(gap, is_first)` is given the text between the previous integer
+ * (or the start of the buffer) and the next one, not including its sign, and
+ * returns false to stop. A '+' or (for signed T) '-' directly before a run of
+ * digits is taken as its sign. Also stops at the first value that doesn't fit
+ * in a T.
+ */
+template <std::integral T, class AcceptGap>
+std::vector<T> scan_ints(std::string_view text, AcceptGap &&accept_gap) {
+    std::vector<T> vec;
+    const char *prev_end = text.data();
+    util::for_each_digit_run(text, [&](const char *begin, const char *end) {
+        bool negative = false;
+        const char *gap_end = begin;
+        if (begin != prev_end) {
+            if (std::is_signed_v<T> && begin[-1] == '-') {
+                negative = true;
+                --gap_end;
+            } else if (begin[-1] == '+') {
+                --gap_end;
+            }
+        }
+        T value;
+        if (!accept_gap(std::string_view(prev_end, gap_end), vec.empty()) ||
+            !parse_digit_run(begin, end, negative, value)) {
+            return false;
+        }
+        vec.push_back(value);
+        prev_end = end;
+        return true;
+    });
+    return vec;
+}
+} // namespace detail
+
+/**
+ * @brief Reads whitespace-separated integers from a string into a vector,
+ * stopping at the first thing that isn't one.
+ *
+ * Gives the same result as the istream version, except that a '-' sign is
+ * never accepted for unsigned T.
+ */
+template <std::integral T>
+std::vector<T> read_vector(std::string_view text) {
+    return detail::scan_ints<T>(
+        text, [](std::string_view gap, bool) { return detail::all_space(gap); });
+}
+
+/**
+ * @brief Extracts every integer from a string, ignoring anything in between.
+ *
+ * An integer is a maximal run of digits, with a directly preceding '-' sign
+ * for signed T, so "x=3,y=-12..5" gives {3, -12, 5}. Stops at the first value
+ * that doesn't fit in a T.
+ */
+template <std::integral T = int>
+std::vector<T> parse_ints(std::string_view text) {
+    return detail::scan_ints<T>(text,
+                                [](std::string_view, bool) { return true; });
+}
+
+/**
+ * @brief Reads comma-separated integers from the start of a string.
+ *
+ * Matches read_csv: leading whitespace is skipped before each value, and the
+ * list ends at the first value that isn't directly followed by a comma.
+ */
+template <std::integral T = int>
+std::vector<T> parse_csv_ints(std::string_view text) {
+    return detail::scan_ints<T>(
+        text, [](std::string_view gap, bool is_first) {
+            if (is_first) {
+                return detail::all_space(gap);
+            }
+            return !gap.empty() && gap.front() == ',' &&
+                   detail::all_space(gap.substr(1));
+        });
+}
+
 /**
  * @brief Reads comma-separated values from a stream into a vector.
  *
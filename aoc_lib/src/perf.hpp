@@ -0,0 +1,317 @@
+/******************************************************************************
+ * File:        perf.hpp
+ *
+ * Author:      Eric T. Johnson (yut23)
+ * Created:     2026-10-17
+ * Description: Hardware performance counters for named regions of code.
+ *****************************************************************************/
+
+#ifndef PERF_HPP_V4KD8N2Q
+#define PERF_HPP_V4KD8N2Q
+
+#include <string_view> // for string_view
+
+#if defined(FAST_MODE) && defined(__linux__)
+#define AOC_PERF_ENABLED 1
+#else
+#define AOC_PERF_ENABLED 0
+#endif
+
+#if AOC_PERF_ENABLED
+#include <linux/perf_event.h> // for perf_event_attr, PERF_*
+#include <sys/ioctl.h>        // for ioctl
+#include <sys/syscall.h>      // for SYS_perf_event_open
+#include <unistd.h>           // for syscall, read, close
+
+#include <algorithm> // for all_of
+#include <array>     // for array
+#include <cerrno>    // for errno
+#include <chrono>    // for steady_clock, duration
+#include <cstddef>   // for size_t
+#include <cstdint>   // for uint64_t
+#include <cstdlib>   // for getenv
+#include <cstring>   // for strerror
+#include <iomanip>   // for setw, setprecision, fixed
+#include <iostream>  // for cerr, ostream
+#include <string>    // for string
+#include <vector>    // for vector
+#else
+#include <iosfwd> // for ostream
+#endif
+
+/**
+ * Hardware performance counters (cycles, instructions, cache misses and
+ * branch misses) around named regions of code, read with perf_event_open(2).
+ *
+ * This only does anything in FAST_MODE builds (`make fast` or `make profile`)
+ * on Linux, and only when the AOC_PERF environment variable is set to
+ * something other than 0. Otherwise, Scope is an empty object.
+ *
+ * Counts are accumulated per thread and region name over every time it's
+ * entered, and printed to stderr when the thread exits (or by the benchmark
+ * harness after its summary).
+ * Only user-space events are counted, so this works with the default
+ * perf_event_paranoid setting. If the counters can't be opened (e.g. in a VM
+ * without a virtual PMU), only the call counts and wall times are reported.
+ */
+namespace aoc::perf {
+
+constexpr bool ENABLED = AOC_PERF_ENABLED;
+
+#if AOC_PERF_ENABLED
+
+namespace detail {
+
+enum Event {
+    CYCLES,
+    INSTRUCTIONS,
+    CACHE_REFERENCES,
+    CACHE_MISSES,
+    BRANCH_MISSES,
+    NUM_EVENTS
+};
+
+struct Counters {
+    std::array<std::uint64_t, NUM_EVENTS> events{};
+    double seconds = 0;
+
+    Counters &operator+=(const Counters &other) {
+        for (int i = 0; i < NUM_EVENTS; ++i) {
+            events[i] += other.events[i];
+        }
+        seconds += other.seconds;
+        return *this;
+    }
+    Counters operator-(const Counters &other) const {
+        Counters result = *this;
+        for (int i = 0; i < NUM_EVENTS; ++i) {
+            result.events[i] -= other.events[i];
+        }
+        result.seconds -= other.seconds;
+        return result;
+    }
+};
+
+struct RegionStats {
+    std::string name;
+    long calls = 0;
+    Counters totals{};
+};
+
+/**
+ * A group of counters for the current thread, which are always read
+ * together, plus the per-region totals.
+ */
+class Registry {
+    bool m_enabled = false;
+    int m_leader_fd = -1;
+    std::vector<int> m_fds{};
+    std::vector<RegionStats> m_regions{};
+
+    static int open_event(std::uint64_t config, int group_fd) {
+        perf_event_attr attr{};
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = config;
+        attr.read_format = PERF_FORMAT_GROUP;
+        attr.disabled = group_fd == -1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        return static_cast<int>(
+            syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0));
+    }
+
+    void open_counters() {
+        constexpr std::array<std::uint64_t, NUM_EVENTS> configs{
+            PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+            PERF_COUNT_HW_CACHE_REFERENCES, PERF_COUNT_HW_CACHE_MISSES,
+            PERF_COUNT_HW_BRANCH_MISSES};
+        for (std::uint64_t config : configs) {
+            const int fd = open_event(config, m_leader_fd);
+            if (fd == -1) {
+                std::cerr << "perf: couldn't open hardware counters ("
+                          << std::strerror(errno)
+                          << "), only timing regions\n";
+                close_counters();
+                return;
+            }
+            if (m_leader_fd == -1) {
+                m_leader_fd = fd;
+            }
+            m_fds.push_back(fd);
+        }
+        ioctl(m_leader_fd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+
+    void close_counters() {
+        for (int fd : m_fds) {
+            close(fd);
+        }
+        m_fds.clear();
+        m_leader_fd = -1;
+    }
+
+  public:
+    Registry() {
+        const char *env = std::getenv("AOC_PERF");
+        m_enabled =
+            env != nullptr && *env != '\0' && std::string_view(env) != "0";
+        if (m_enabled) {
+            open_counters();
+        }
+    }
+    Registry(const Registry &) = delete;
+    Registry &operator=(const Registry &) = delete;
+
+    ~Registry() {
+        report(std::cerr);
+        close_counters();
+    }
+
+    bool enabled() const { return m_enabled; }
+
+    Counters read() const {
+        Counters counters;
+        const auto now = std::chrono::steady_clock::now().time_since_epoch();
+        counters.seconds = std::chrono::duration<double>(now).count();
+        if (m_leader_fd != -1) {
+            // layout for PERF_FORMAT_GROUP: nr, then one value per event
+            std::array<std::uint64_t, NUM_EVENTS + 1> buf{};
+            if (::read(m_leader_fd, buf.data(), sizeof(buf)) ==
+                sizeof(buf)) {
+                for (int i = 0; i < NUM_EVENTS; ++i) {
+                    counters.events[i] = buf[i + 1];
+                }
+            }
+        }
+        return counters;
+    }
+
+    /// Returns the index of the region `name`, adding it if needed.
+    std::size_t region(std::string_view name) {
+        for (std::size_t i = 0; i < m_regions.size(); ++i) {
+            if (m_regions[i].name == name) {
+                return i;
+            }
+        }
+        m_regions.emplace_back(std::string(name));
+        return m_regions.size() - 1;
+    }
+
+    void record(std::size_t index, const Counters &delta) {
+        ++m_regions[index].calls;
+        m_regions[index].totals += delta;
+    }
+
+    /// Prints the totals for each region, then resets them.
+    void report(std::ostream &os) {
+        if (std::ranges::all_of(m_regions, [](const RegionStats &stats) {
+                return stats.calls == 0;
+            })) {
+            return;
+        }
+        const bool have_counters = m_leader_fd != -1;
+        const auto old_flags = os.flags();
+        const auto old_precision = os.precision();
+        os << std::fixed << "perf regions:\n  " << std::left << std::setw(28)
+           << "region" << std::right << std::setw(8) << "calls"
+           << std::setw(12) << "time [ms]";
+        if (have_counters) {
+            os << std::setw(14) << "cycles" << std::setw(14) << "instructions"
+               << std::setw(7) << "IPC" << std::setw(14) << "cache misses"
+               << std::setw(8) << "miss %" << std::setw(14) << "branch misses"
+               << std::setw(8) << "MPKI";
+        }
+        os << "\n";
+        for (const RegionStats &stats : m_regions) {
+            if (stats.calls == 0) {
+                continue;
+            }
+            const auto &events = stats.totals.events;
+            const auto ratio = [](double num, double den) {
+                return den == 0 ? 0.0 : num / den;
+            };
+            os << "  " << std::left << std::setw(28) << stats.name
+               << std::right << std::setw(8) << stats.calls
+               << std::setprecision(3) << std::setw(12)
+               << stats.totals.seconds * 1e3;
+            if (have_counters) {
+                os << std::setw(14) << events[CYCLES] << std::setw(14)
+                   << events[INSTRUCTIONS] << std::setprecision(2)
+                   << std::setw(7)
+                   << ratio(events[INSTRUCTIONS], events[CYCLES])
+                   << std::setw(14) << events[CACHE_MISSES]
+                   << std::setprecision(1) << std::setw(8)
+                   << 100 * ratio(events[CACHE_MISSES],
+                                  events[CACHE_REFERENCES])
+                   << std::setw(14) << events[BRANCH_MISSES]
+                   << std::setprecision(2) << std::setw(8)
+                   << 1000 * ratio(events[BRANCH_MISSES],
+                                   events[INSTRUCTIONS]);
+            }
+            os << "\n";
+        }
+        os.flags(old_flags);
+        os.precision(old_precision);
+        // keep the entries, since there may be open scopes referring to them
+        for (RegionStats &stats : m_regions) {
+            stats.calls = 0;
+            stats.totals = {};
+        }
+    }
+};
+
+/// Counters only measure the thread that opened them, so each thread gets its
+/// own registry, which reports when the thread exits.
+inline Registry &registry() {
+    static thread_local Registry instance;
+    return instance;
+}
+
+} // namespace detail
+
+/**
+ * Counts events from construction to destruction, and adds them to the
+ * totals for the region `name`. Nested scopes are counted inclusively.
+ */
+class Scope {
+    static constexpr std::size_t NO_REGION = -1;
+    std::size_t m_region = NO_REGION;
+    detail::Counters m_start{};
+
+  public:
+    explicit Scope(std::string_view name) {
+        detail::Registry &registry = detail::registry();
+        if (registry.enabled()) {
+            m_region = registry.region(name);
+            m_start = registry.read();
+        }
+    }
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+
+    ~Scope() {
+        if (m_region != NO_REGION) {
+            detail::Registry &registry = detail::registry();
+            registry.record(m_region, registry.read() - m_start);
+        }
+    }
+};
+
+/// Prints (and clears) the per-region counters, if any were recorded.
+inline void report(std::ostream &os) { detail::registry().report(os); }
+
+#else
+
+class Scope {
+  public:
+    explicit constexpr Scope(std::string_view) {}
+};
+
+inline void report(std::ostream &) {}
+
+#endif
+
+} // namespace aoc::perf
+
+#endif /* end of include guard: PERF_HPP_V4KD8N2Q */
@@ -0,0 +1,231 @@
+/******************************************************************************
+ * File:        runner.hpp
+ *
+ * Author:      Eric T. Johnson (yut23)
+ * Created:     2026-10-17
+ * Description: Runs several days' solutions concurrently in one process.
+ *****************************************************************************/
+
+#ifndef RUNNER_HPP_5XN2H8WE
+#define RUNNER_HPP_5XN2H8WE
+
+#include "util/thread_pool.hpp" // for ThreadPool
+#include <algorithm>            // for find_if
+#include <chrono>               // for steady_clock, duration
+#include <cstddef>              // for size_t
+#include <cstdlib>              // for exit, strtol
+#include <exception>            // for exception
+#include <filesystem>           // for exists
+#include <iomanip>              // for setw, setprecision, fixed
+#include <iostream>             // for cout, cerr, streambuf
+#include <span>                 // for span
+#include <sstream>              // for ostringstream
+#include <string>               // for string, to_string
+#include <string_view>          // for string_view
+#include <thread>               // for hardware_concurrency
+#include <utility>              // for move
+#include <vector>               // for vector
+
+/**
+ * The `all_days` binary for each year (`make all_days`) links every
+ * src/dayNN.cpp into a single executable, with each day's main() renamed (see
+ * tools/cpp/gen_all_days.sh). This saves the process startup, sanitizer
+ * initialization and page faults that running each day separately would pay.
+ *
+ * Usage: all_days [-j threads] [-i input_name] [-q] [day...]
+ *
+ * The selected days (all of them by default) run concurrently on a thread
+ * pool, each with input/dayNN/<input_name> (input.txt by default). Their
+ * answers are printed in day order, in the same format as answer_tests, and
+ * the per-day and total wall times are printed to stderr.
+ */
+namespace aoc::runner {
+
+using day_main_t = int (*)(int, char **);
+
+struct Day {
+    int number;
+    day_main_t main;
+};
+
+namespace detail {
+
+/**
+ * Stream buffer that forwards everything to a per-thread buffer, so the output
+ * of days running at the same time on different threads can be captured
+ * separately while they all write to std::cout. Output from threads without a
+ * target goes to the original buffer.
+ */
+class ThreadLocalBuf : public std::streambuf {
+    std::streambuf *m_fallback;
+
+    static inline thread_local std::streambuf *t_target = nullptr;
+
+    std::streambuf *target() const {
+        return t_target != nullptr ? t_target : m_fallback;
+    }
+
+  protected:
+    int_type overflow(int_type ch) override {
+        if (traits_type::eq_int_type(ch, traits_type::eof())) {
+            return traits_type::not_eof(ch);
+        }
+        return target()->sputc(traits_type::to_char_type(ch));
+    }
+    std::streamsize xsputn(const char *s, std::streamsize count) override {
+        return target()->sputn(s, count);
+    }
+    int sync() override { return target()->pubsync(); }
+
+  public:
+    explicit ThreadLocalBuf(std::streambuf *fallback) : m_fallback(fallback) {}
+
+    std::streambuf *fallback() const { return m_fallback; }
+
+    /// Sends this thread's output to `buf` until the guard is destroyed.
+    struct Capture {
+        explicit Capture(std::streambuf *buf) { t_target = buf; }
+        ~Capture() { t_target = nullptr; }
+    };
+};
+
+struct DayResult {
+    int status = 0;
+    double seconds = 0;
+    std::string output{};
+    std::string error{};
+};
+
+DayResult run_day(const Day &day, const std::string &input_name) {
+    DayResult result;
+    std::string day_name = std::to_string(day.number);
+    if (day_name.size() < 2) {
+        day_name.insert(0, 1, '0');
+    }
+    std::string prog = "day" + day_name;
+    std::string path = "input/day" + day_name + "/" + input_name;
+    if (!std::filesystem::exists(path)) {
+        result.status = 1;
+        result.error = "missing " + path;
+        return result;
+    }
+
+    std::ostringstream output;
+    char *argv[] = {prog.data(), path.data(), nullptr};
+    const auto start = std::chrono::steady_clock::now();
+    try {
+        ThreadLocalBuf::Capture capture(output.rdbuf());
+        result.status = day.main(2, argv);
+    } catch (const std::exception &e) {
+        result.status = 1;
+        result.error = e.what();
+    }
+    result.seconds = std::chrono::duration<double>(
+                         std::chrono::steady_clock::now() - start)
+                         .count();
+    result.output = std::move(output).str();
+    if (result.status != 0 && result.error.empty()) {
+        result.error = "exited with status " + std::to_string(result.status);
+    }
+    return result;
+}
+
+[[noreturn]] void usage(const char *prog) {
+    std::cerr << "Usage: " << prog
+              << " [-j threads] [-i input_name] [-q] [day...]\n";
+    std::exit(1);
+}
+
+} // namespace detail
+
+/**
+ * Main function for the `all_days` binary. Returns 0 if every selected day
+ * ran successfully.
+ */
+int run(int argc, char **argv, std::span<const Day> days) {
+    std::size_t num_threads = std::thread::hardware_concurrency();
+    std::string input_name = "input.txt";
+    bool quiet = false;
+    std::vector<const Day *> selected;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        if ((arg == "-j" || arg == "-i") && i + 1 == argc) {
+            detail::usage(argv[0]);
+        }
+        if (arg == "-j") {
+            const char *value = argv[++i];
+            char *end;
+            const long threads = std::strtol(value, &end, 10);
+            if (end == value || *end != '\0' || threads <= 0) {
+                std::cerr << "invalid thread count: " << value << "\n";
+                detail::usage(argv[0]);
+            }
+            num_threads = threads;
+        } else if (arg == "-i") {
+            input_name = argv[++i];
+        } else if (arg == "-q") {
+            quiet = true;
+        } else {
+            const int number = std::strtol(argv[i], nullptr, 10);
+            auto it = std::ranges::find_if(
+                days, [number](const Day &day) { return day.number == number; });
+            if (it == days.end()) {
+                std::cerr << "unknown day: " << arg << "\n";
+                detail::usage(argv[0]);
+            }
+            selected.push_back(&*it);
+        }
+    }
+    if (selected.empty()) {
+        for (const Day &day : days) {
+            selected.push_back(&day);
+        }
+    }
+
+    detail::ThreadLocalBuf dispatch_buf(std::cout.rdbuf());
+    std::cout.rdbuf(&dispatch_buf);
+
+    std::vector<detail::DayResult> results(selected.size());
+    const auto start = std::chrono::steady_clock::now();
+    {
+        util::ThreadPool pool(num_threads);
+        num_threads = pool.size();
+        for (std::size_t i = 0; i < selected.size(); ++i) {
+            pool.submit([&results, &selected, &input_name, i]() {
+                results[i] = detail::run_day(*selected[i], input_name);
+            });
+        }
+        pool.wait();
+    }
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    std::cout.rdbuf(dispatch_buf.fallback());
+
+    int status = 0;
+    double total_time = 0;
+    std::cerr << std::fixed << std::setprecision(2);
+    for (std::size_t i = 0; i < selected.size(); ++i) {
+        const detail::DayResult &result = results[i];
+        if (!quiet && result.status == 0) {
+            std::cout << "Day " << selected[i]->number << ":\n"
+                      << result.output;
+        }
+        std::cerr << "Day " << std::setw(2) << selected[i]->number << ": "
+                  << std::setw(10) << result.seconds * 1e3 << " ms";
+        if (result.status != 0) {
+            std::cerr << "  (failed: " << result.error << ")";
+            status = 1;
+        }
+        std::cerr << "\n";
+        total_time += result.seconds;
+    }
+    std::cerr << "total:  " << std::setw(10) << elapsed.count() * 1e3
+              << " ms wall (sum of days " << total_time * 1e3 << " ms, "
+              << num_threads << " threads)\n";
+    return status;
+}
+
+} // namespace aoc::runner
+
+#endif /* end of include guard: RUNNER_HPP_5XN2H8WE */
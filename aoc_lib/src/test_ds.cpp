@@ -6,20 +6,30 @@
  * Description: Unit tests for data structures.
  *****************************************************************************/
 
+#include "ds/bit_grid.hpp"     // IWYU pragma: associated
+#include "ds/bucket_queue.hpp" // IWYU pragma: associated
+#include "ds/disjoint_set.hpp" // IWYU pragma: associated
 #include "ds/grid.hpp"         // IWYU pragma: associated
+#include "ds/kd_tree.hpp"      // IWYU pragma: associated
 #include "ds/pairing_heap.hpp" // IWYU pragma: associated
 
 #include "unit_test/pretty_print.hpp" // for repr
+#include "lib.hpp"                    // for Pos3
 #include "unit_test/unit_test.hpp"    // for TestSuite, fix_exit_code
 #include "util/util.hpp"              // for demangle
 
-#include <array>      // for array
-#include <cstddef>    // for size_t
-#include <functional> // for greater
-#include <sstream>    // for stringstream
-#include <string>     // for string
-#include <typeinfo>   // for type_info
-#include <vector>     // for vector
+#include <algorithm>   // for sort, equal, min, all_of
+#include <array>       // for array
+#include <cstddef>     // for size_t
+#include <functional>  // for greater
+#include <random>      // for mt19937, bernoulli_distribution, uniform_int_...
+#include <sstream>     // for stringstream
+#include <string>      // for string
+#include <string_view> // for string_view
+#include <tuple>       // for tuple
+#include <typeinfo>    // for type_info
+#include <utility>     // for pair
+#include <vector>      // for vector
 
 namespace aoc::ds::test {
 
@@ -28,11 +38,13 @@ namespace aoc::ds::test {
         check_equal(heap.op(), value, "heap " #op " incorrect");               \
     } while (0)
 
-std::size_t test_pairing_heap_max() {
-    unit_test::TestSuite suite("aoc::ds::pairing_heap<int>");
+template <class Heap = pairing_heap<int>>
+std::size_t test_pairing_heap_max(
+    const std::string &name = "aoc::ds::pairing_heap<int>") {
+    unit_test::TestSuite suite(name);
     using namespace unit_test::checks;
     suite.test("", []() {
-        pairing_heap<int> heap;
+        Heap heap;
         int x = 1;
         heap.push(x);
         heap.push(1);
@@ -57,11 +69,13 @@ std::size_t test_pairing_heap_max() {
     return suite.done(), suite.num_failed();
 }
 
-std::size_t test_pairing_heap_min() {
-    unit_test::TestSuite suite("aoc::ds::pairing_heap<int, std::greater>");
+template <class Heap = pairing_heap<int, std::greater<int>>>
+std::size_t test_pairing_heap_min(
+    const std::string &name = "aoc::ds::pairing_heap<int, std::greater>") {
+    unit_test::TestSuite suite(name);
     using namespace unit_test::checks;
     suite.test("", []() {
-        pairing_heap<int, std::greater<int>> heap;
+        Heap heap;
         int x = 5;
         heap.push(x);
         heap.push(3);
@@ -95,8 +109,216 @@ std::size_t test_pairing_heap_min() {
     return suite.done(), suite.num_failed();
 }
 
+std::size_t test_pooled_pairing_heap_reuse() {
+    unit_test::TestSuite suite(
+        "aoc::ds::pooled_pairing_heap<int, std::greater> reuse");
+    using namespace unit_test::checks;
+    suite.test("clear", []() {
+        pooled_pairing_heap<int, std::greater<int>> heap;
+        heap.reserve(8);
+        for (int i = 7; i >= 0; --i) {
+            heap.push(i * 2);
+        }
+        HEAP_CHECK(top, 0);
+        heap.pop();
+        heap.pop();
+        HEAP_CHECK(top, 4);
+        HEAP_CHECK(size, 6ul);
+        heap.clear();
+        HEAP_CHECK(size, 0ul);
+        check(heap.empty(), "heap not empty after clear");
+        // handles are reused after clear()
+        check_equal(heap.push(9), 0u, "first handle after clear");
+        auto nh = heap.push(5);
+        check_equal(nh, 1u, "second handle after clear");
+        heap.push(7);
+        HEAP_CHECK(top, 5);
+        check_equal(heap.value(nh), 5, "value() incorrect");
+        heap.update(nh, 8);
+        HEAP_CHECK(top, 7);
+        heap.pop();
+        HEAP_CHECK(top, 8);
+        heap.pop();
+        HEAP_CHECK(top, 9);
+        heap.pop();
+        check(heap.empty(), "heap not empty");
+    });
+    suite.test("many updates", []() {
+        pooled_pairing_heap<int, std::greater<int>> heap;
+        std::vector<decltype(heap)::handle_type> handles;
+        for (int i = 0; i < 100; ++i) {
+            handles.push_back(heap.push(1000 + i));
+        }
+        // decrease every other key, in reverse order
+        for (int i = 99; i >= 0; i -= 2) {
+            heap.update(handles[i], i);
+        }
+        for (int i = 1; i < 100; i += 2) {
+            HEAP_CHECK(top, i);
+            heap.pop();
+        }
+        for (int i = 0; i < 100; i += 2) {
+            HEAP_CHECK(top, 1000 + i);
+            heap.pop();
+        }
+        check(heap.empty(), "heap not empty");
+    });
+    return suite.done(), suite.num_failed();
+}
+
+std::size_t test_bucket_queue() {
+    unit_test::TestSuite suite("aoc::ds::bucket_queue<char>");
+    using namespace unit_test::checks;
+    suite.test("", []() {
+        bucket_queue<char> heap(3);
+        heap.emplace(0, 'b');
+        heap.push(2, 'a');
+        heap.push(3, 'c');
+        HEAP_CHECK(size, 3ul);
+        HEAP_CHECK(top_priority, 0);
+        HEAP_CHECK(top, 'b');
+        heap.pop();
+        // pushes are relative to the last popped priority (0), even though
+        // the smallest remaining priority is 2
+        heap.push(1, 'd');
+        HEAP_CHECK(top_priority, 1);
+        HEAP_CHECK(top, 'd');
+        heap.pop();
+        HEAP_CHECK(top_priority, 2);
+        HEAP_CHECK(top, 'a');
+        heap.pop();
+        heap.push(5, 'e');
+        heap.push(3, 'f');
+        HEAP_CHECK(top_priority, 3);
+        HEAP_CHECK(top, 'f');
+        heap.pop();
+        HEAP_CHECK(top, 'c');
+        heap.pop();
+        HEAP_CHECK(top_priority, 5);
+        HEAP_CHECK(top, 'e');
+        heap.pop();
+        check(heap.empty(), "heap not empty");
+        // an empty queue restarts at any priority
+        heap.push(100, 'g');
+        HEAP_CHECK(top_priority, 100);
+        HEAP_CHECK(size, 1ul);
+    });
+    return suite.done(), suite.num_failed();
+}
+
 #undef HEAP_CHECK
 
+std::size_t test_disjoint_set() {
+    unit_test::TestSuite suite("aoc::ds::disjoint_set");
+    using namespace unit_test::checks;
+    using pair_t = std::pair<disjoint_set::id_t, disjoint_set::id_t>;
+    suite.test("merge", []() {
+        disjoint_set dset(6);
+        check_equal(dset.size(), 6ul);
+        check_equal(dset.set_count(), 6ul);
+        check(dset.merge(0, 1), "0 and 1 should merge");
+        check(dset.merge(2, 1), "2 and 1 should merge");
+        check(!dset.merge(0, 2), "0 and 2 are already merged");
+        check_equal(dset.set_count(), 4ul);
+        check_equal(dset.find(2), dset.find(0));
+        check_equal(dset.set_size(1), 3ul);
+        check_equal(dset.set_size(5), 1ul);
+        auto id = dset.new_set();
+        check_equal(id, 6ul);
+        check(dset.merge(5, id), "5 and 6 should merge");
+        check_equal(dset.set_count(), 4ul);
+        check_equal(dset.components(),
+                    std::vector<std::pair<disjoint_set::id_t, std::size_t>>{
+                        {dset.find(0), 3}, {3, 1}, {4, 1}, {dset.find(5), 2}});
+    });
+    suite.test("merge_many", []() {
+        disjoint_set dset;
+        dset.reserve(10);
+        for (int i = 0; i < 10; ++i) {
+            (void)dset.new_set();
+        }
+        const std::vector<pair_t> pairs{{0, 1}, {2, 3}, {1, 3}, {0, 2},
+                                        {8, 9}, {9, 8}, {4, 4}};
+        check_equal(dset.merge_many(pairs), 4ul);
+        check_equal(dset.set_count(), 6ul);
+        check_equal(dset.set_size(3), 4ul);
+        std::size_t total = 0;
+        for (const auto &[root, size] : dset.components()) {
+            check_equal(dset.find(root), root);
+            total += size;
+        }
+        check_equal(total, 10ul);
+    });
+    return suite.done(), suite.num_failed();
+}
+
+std::size_t test_kd_tree() {
+    unit_test::TestSuite suite("aoc::ds::kd_tree");
+    using namespace unit_test::checks;
+    using id_t = std::size_t;
+
+    std::vector<Pos3> points;
+    unsigned int state = 2025;
+    const auto next_coord = [&state]() {
+        state = state * 1103515245 + 12345;
+        return static_cast<int>((state >> 16) % 200) - 100;
+    };
+    for (int i = 0; i < 300; ++i) {
+        int x = next_coord();
+        int y = next_coord();
+        int z = next_coord();
+        points.emplace_back(x, y, z);
+    }
+    // add some duplicate distances
+    points.emplace_back(0, 0, 0);
+    points.emplace_back(0, 0, 0);
+
+    std::vector<std::tuple<long, id_t, id_t>> all_pairs;
+    for (id_t i = 0; i < points.size(); ++i) {
+        for (id_t j = i + 1; j < points.size(); ++j) {
+            all_pairs.emplace_back(
+                (points[i] - points[j]).euclidean_distance_sq(), i, j);
+        }
+    }
+    std::ranges::sort(all_pairs);
+
+    suite.test("k_nearest", [&]() {
+        kd_tree<int> tree(points);
+        for (const Pos3 &query : {points[0], points[17], Pos3(5, -3, 50)}) {
+            std::vector<std::pair<long, id_t>> expected;
+            for (id_t id = 0; id < points.size(); ++id) {
+                expected.emplace_back(
+                    (points[id] - query).euclidean_distance_sq(), id);
+            }
+            std::ranges::sort(expected);
+            for (std::size_t k : {0ul, 1ul, 5ul, 40ul, points.size() + 1}) {
+                auto result = tree.k_nearest(query, k);
+                check_equal(result.size(), std::min(k, points.size()));
+                check_equal(result, std::vector(expected.begin(),
+                                                expected.begin() +
+                                                    result.size()));
+            }
+        }
+        // filtered: only even ids
+        auto result =
+            tree.k_nearest(Pos3(0, 0, 0), 10, [](id_t id) { return id % 2 == 0; });
+        check_equal(result.size(), 10ul);
+        for (const auto &[_, id] : result) {
+            check_equal(id % 2, 0ul);
+        }
+    });
+    suite.test("closest_pairs", [&]() {
+        closest_pairs<int> stream(points, 1);
+        std::vector<std::tuple<long, id_t, id_t>> result;
+        while (auto pair = stream.next()) {
+            result.push_back(*pair);
+        }
+        check_equal(result.size(), all_pairs.size());
+        check(std::ranges::equal(result, all_pairs), "pairs out of order");
+    });
+    return suite.done(), suite.num_failed();
+}
+
 template <class T>
 void test_grid_basic(unit_test::TestSuite &suite, const Grid<T> &grid) {
     using namespace unit_test::checks;
@@ -228,15 +450,406 @@ std::size_t test_grid_repr() {
     return suite.done(), suite.num_failed();
 }
 
+template <class Layout>
+std::size_t test_grid_layout(const std::string &name) {
+    unit_test::TestSuite suite("aoc::ds::Grid<int, " + name + ">");
+    using namespace unit_test::checks;
+
+    // not a multiple of the tile size, and not square
+    constexpr int width = 37, height = 23;
+    std::vector<int> data(width * height);
+    for (int i = 0; auto &x : data) {
+        x = i++;
+    }
+    const Grid<int> expected(width, height, data);
+    Grid<int, Layout> grid(width, height, data);
+
+    suite.test("indexing", [&]() {
+        std::vector<bool> used(grid.data().size(), false);
+        expected.for_each([&](int value, const Pos &pos) {
+            const std::size_t index = grid.get_index(pos);
+            check(index < used.size() && !used[index], [&](auto &os) {
+                os << "bad index " << index << " for " << pos;
+            });
+            used[index] = true;
+            check_equal(grid.index_to_pos(index), pos);
+            check_equal(grid[pos], value);
+            check_equal(grid.at(pos.x, pos.y), value);
+        });
+    });
+    suite.test("for_each", [&]() {
+        Grid<int> visits(width, height, 0);
+        grid.for_each([&](int value, const Pos &pos) {
+            check_equal(value, expected[pos]);
+            ++visits[pos];
+        });
+        check(std::ranges::all_of(visits.data(), [](int n) { return n == 1; }),
+              "each cell visited once");
+        Grid<int, Layout> copy = grid;
+        copy.for_each([](int &value) { value *= 2; });
+        check_equal(copy[Pos(36, 22)], 2 * expected[Pos(36, 22)]);
+    });
+    suite.test("kernels", [&]() {
+        for (const Pos center : {Pos(0, 0), Pos(17, 16), Pos(36, 22)}) {
+            long expected_sum = 0, sum = 0;
+            expected.manhattan_kernel(
+                center, 3, [&](int value) { expected_sum += value; });
+            grid.manhattan_kernel(center, 3, [&](int value) { sum += value; });
+            expected.chebyshev_kernel(
+                center, 2, [&](int value) { expected_sum -= 3 * value; });
+            grid.chebyshev_kernel(center, 2,
+                                  [&](int value) { sum -= 3 * value; });
+            check_equal(sum, expected_sum);
+        }
+    });
+    suite.test("other constructors", [&]() {
+        std::vector<std::vector<int>> rows(height, std::vector<int>(width));
+        expected.for_each(
+            [&rows](int value, const Pos &pos) { rows[pos.y][pos.x] = value; });
+        const Grid<int, Layout> nested(rows);
+        check_equal(nested[Pos(20, 10)], expected[Pos(20, 10)]);
+        const Grid<int, Layout> moved(width, height, std::vector<int>(data));
+        check_equal(moved[Pos(5, 21)], expected[Pos(5, 21)]);
+        const auto chars = Grid<char, Layout>::from_buffer(
+            std::string_view("abc\ndef\n"));
+        check_equal(chars[Pos(2, 1)], 'f');
+    });
+    suite.test("repr", [&]() {
+        std::ostringstream expected_oss, oss;
+        expected_oss << pretty_print::repr(expected);
+        oss << pretty_print::repr(grid);
+        check_equal(oss.str(), expected_oss.str());
+    });
+    return suite.done(), suite.num_failed();
+}
+
+std::size_t test_grid_kernels() {
+    unit_test::TestSuite suite("aoc::ds::Grid kernels");
+    using namespace unit_test::checks;
+
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<int> dist(0, 9);
+    Grid<int> grid(11, 7, 0);
+    grid.for_each([&gen, &dist](int &value) { value = dist(gen); });
+    const auto is_odd = [](int value) { return value % 2 != 0; };
+
+    // brute-force reference, checking every position in the grid
+    const auto reference = [&grid](const Pos &center, int distance,
+                                   bool manhattan, auto &&func) {
+        grid.for_each([&](int value, const Pos &pos) {
+            const Delta d = pos - center;
+            const int dist = manhattan ? d.manhattan_distance()
+                                       : d.chebyshev_distance();
+            if (dist <= distance) {
+                func(value, pos, dist);
+            }
+        });
+    };
+
+    suite.test("kernel functors", [&]() {
+        for (int distance = 0; distance <= 3; ++distance) {
+            grid.for_each([&](int, const Pos &center) {
+                for (bool manhattan : {false, true}) {
+                    std::vector<std::tuple<Pos, int, int>> expected, actual;
+                    reference(center, distance, manhattan,
+                              [&expected](int value, const Pos &pos, int d) {
+                                  expected.emplace_back(pos, value, d);
+                              });
+                    const auto collect = [&actual](int value, const Pos &pos,
+                                                   int d) {
+                        actual.emplace_back(pos, value, d);
+                    };
+                    if (manhattan) {
+                        grid.manhattan_kernel(center, distance, collect);
+                    } else {
+                        grid.chebyshev_kernel(center, distance, collect);
+                    }
+                    check(expected == actual, [&](auto &os) {
+                        os << (manhattan ? "manhattan" : "chebyshev")
+                           << " kernel mismatch at " << center
+                           << ", distance " << distance;
+                    });
+                }
+            });
+        }
+    });
+    suite.test("reductions", [&]() {
+        for (int distance = 0; distance <= 3; ++distance) {
+            grid.for_each([&](int, const Pos &center) {
+                for (bool manhattan : {false, true}) {
+                    int expected_sum = 0, expected_count = 0;
+                    reference(center, distance, manhattan,
+                              [&](int value, const Pos &, int) {
+                                  expected_sum += value;
+                                  expected_count += is_odd(value);
+                              });
+                    const auto identity = [](int value) { return value; };
+                    int row_sum = 0;
+                    const auto add_row = [&row_sum](const Pos &,
+                                                    std::span<const int> row) {
+                        for (int value : row) {
+                            row_sum += value;
+                        }
+                    };
+                    if (manhattan) {
+                        check_equal(grid.manhattan_sum(center, distance,
+                                                       identity),
+                                    expected_sum);
+                        check_equal(
+                            grid.manhattan_count(center, distance, is_odd),
+                            expected_count);
+                        grid.manhattan_rows(center, distance, add_row);
+                    } else {
+                        check_equal(grid.chebyshev_sum(center, distance,
+                                                       identity),
+                                    expected_sum);
+                        check_equal(
+                            grid.chebyshev_count(center, distance, is_odd),
+                            expected_count);
+                        grid.chebyshev_rows(center, distance, add_row);
+                    }
+                    check_equal(row_sum, expected_sum);
+                }
+            });
+        }
+    });
+    suite.test("chebyshev_counts", [&]() {
+        for (int distance : {0, 1, 2, 5, 20}) {
+            const Grid<int> counts = grid.chebyshev_counts(is_odd, distance);
+            grid.for_each([&](int, const Pos &center) {
+                check_equal(counts[center],
+                            grid.chebyshev_count(center, distance, is_odd),
+                            [&](auto &os) {
+                                os << "at " << center << ", distance "
+                                   << distance;
+                            });
+            });
+        }
+        const Grid<int, TiledLayout<4>> tiled(grid.width, grid.height,
+                                              grid.data());
+        check(tiled.chebyshev_counts(is_odd).data() ==
+                  grid.chebyshev_counts(is_odd).data(),
+              "tiled layout matches");
+    });
+
+    return suite.done(), suite.num_failed();
+}
+
+std::size_t test_grid_from_buffer() {
+    unit_test::TestSuite suite("aoc::ds::Grid::from_buffer");
+    using namespace unit_test::checks;
+
+    const std::string text = "#.S\n..#\n9.E\n\nmoves\n";
+    const std::vector<std::string> lines{"#.S", "..#", "9.E"};
+
+    suite.test("chars", [&text, &lines]() {
+        const auto grid = Grid<char>::from_buffer(text);
+        check_equal(grid.width, 3);
+        check_equal(grid.height, 3);
+        check(grid.data() == Grid<char>(lines).data(),
+              "matches the grid from read_lines");
+        // no trailing newline
+        const auto grid2 = Grid<char>::from_buffer(std::string_view("ab\ncd"));
+        check_equal(grid2.height, 2);
+        check_equal(grid2[Pos(1, 1)], 'd');
+    });
+
+    suite.test("transform", [&text]() {
+        const auto grid = Grid<bool>::from_buffer(
+            text, [](char ch) { return ch == '#'; });
+        check_equal(grid.height, 3);
+        check(grid[Pos(0, 0)] && grid[Pos(2, 1)] && !grid[Pos(1, 1)],
+              "walls in the right places");
+        const auto digits = Grid<int>::from_buffer(text, [](char ch) {
+            return ch >= '0' && ch <= '9' ? ch - '0' : -1;
+        });
+        check_equal(digits[Pos(0, 2)], 9);
+        check_equal(digits[Pos(1, 2)], -1);
+    });
+
+    suite.test("view", [&text, &lines]() {
+        const GridView view(text);
+        check_equal(view.width, 3);
+        check_equal(view.height, 3);
+        check_equal(view[Pos(2, 0)], 'S');
+        check_equal(view.at(Pos(2, 2)), 'E');
+        check(!view.in_bounds(Pos(3, 0)), "newlines are out of bounds");
+        check_equal(view.row(1), std::string_view{"..#"});
+        check(view.to_grid().data() == Grid<char>(lines).data(),
+              "to_grid() matches the grid from read_lines");
+        int count = 0;
+        view.for_each([&view, &count](char ch, const Pos &pos) {
+            count += ch == view.row(pos.y)[pos.x];
+        });
+        check_equal(count, 9);
+    });
+
+    return suite.done(), suite.num_failed();
+}
+
+std::size_t test_bit_grid() {
+    unit_test::TestSuite suite("aoc::ds::BitGrid");
+    using namespace unit_test::checks;
+
+    // reference operations on a byte-per-cell grid
+    const auto to_grid = [](const BitGrid &bits) {
+        Grid<bool> grid(bits.width, bits.height, false);
+        bits.for_each(
+            [&grid](bool value, const Pos &pos) { grid[pos] = value; });
+        return grid;
+    };
+    const auto shifted = [](const Grid<bool> &grid, const Delta &delta) {
+        Grid<bool> result(grid, false);
+        grid.for_each([&](bool value, const Pos &pos) {
+            if (value && result.in_bounds(pos + delta)) {
+                result[pos + delta] = true;
+            }
+        });
+        return result;
+    };
+    const auto dilated = [](const Grid<bool> &grid, bool diagonal) {
+        Grid<bool> result(grid, false);
+        grid.for_each([&](bool value, const Pos &pos) {
+            if (!value) {
+                return;
+            }
+            const auto mark = [&result](bool, const Pos &p) {
+                result[p] = true;
+            };
+            if (diagonal) {
+                grid.chebyshev_kernel(pos, mark);
+            } else {
+                grid.manhattan_kernel(pos, mark);
+            }
+        });
+        return result;
+    };
+    const auto random_bits = [](int width, int height, unsigned seed) {
+        std::mt19937 gen(seed);
+        std::bernoulli_distribution dist(0.2);
+        BitGrid bits(width, height);
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                bits[Pos(x, y)] = dist(gen);
+            }
+        }
+        return bits;
+    };
+
+    for (int width : {1, 5, 63, 64, 65, 130}) {
+        suite.test("width " + std::to_string(width), [&, width]() {
+            const int height = 7;
+            BitGrid bits = random_bits(width, height, width);
+            const Grid<bool> grid = to_grid(bits);
+
+            check_equal(bits.count(),
+                        static_cast<std::size_t>(std::count(
+                            grid.data().begin(), grid.data().end(), true)));
+            std::size_t set_count = 0;
+            bits.for_each_set([&](const Pos &pos) {
+                check(grid[pos], "for_each_set visits only set cells");
+                ++set_count;
+            });
+            check_equal(set_count, bits.count());
+
+            for (const Delta delta : {Delta(0, 0), Delta(1, 0), Delta(-1, 0),
+                                      Delta(3, -2), Delta(-64, 1),
+                                      Delta(65, 0), Delta(-70, -1)}) {
+                BitGrid copy = bits;
+                copy.shift(delta);
+                check(to_grid(copy).data() == shifted(grid, delta).data(),
+                      "shift by " + std::to_string(delta.dx) + ", " +
+                          std::to_string(delta.dy));
+            }
+
+            BitGrid manhattan = bits;
+            manhattan.dilate_manhattan();
+            check(to_grid(manhattan).data() == dilated(grid, false).data(),
+                  "dilate_manhattan");
+            BitGrid chebyshev = bits;
+            chebyshev.dilate_chebyshev();
+            check(to_grid(chebyshev).data() == dilated(grid, true).data(),
+                  "dilate_chebyshev");
+
+            BitGrid flipped = bits;
+            flipped.flip();
+            check_equal(flipped.count() + bits.count(),
+                        static_cast<std::size_t>(width * height));
+            BitGrid both = bits;
+            both &= flipped;
+            check(both.none(), "x & ~x is empty");
+            both |= flipped;
+            both ^= bits;
+            check_equal(both.count(),
+                        static_cast<std::size_t>(width * height));
+            both.and_not(bits);
+            check(both == flipped, "and_not");
+        });
+    }
+
+    suite.test("flood fill", [&random_bits]() {
+        // open cells, with a flood from the corner confined to them
+        BitGrid open = random_bits(100, 50, 1);
+        open.flip();
+        open.set(Pos(0, 0));
+        BitGrid reached(open, false);
+        reached.set(Pos(0, 0));
+        std::size_t prev_count = 0;
+        while (reached.count() != prev_count) {
+            prev_count = reached.count();
+            reached.dilate_manhattan();
+            reached &= open;
+        }
+        // compare with a scalar flood fill
+        Grid<bool> seen(open.width, open.height, false);
+        std::vector<Pos> stack{Pos(0, 0)};
+        seen[Pos(0, 0)] = true;
+        std::size_t seen_count = 1;
+        while (!stack.empty()) {
+            Pos pos = stack.back();
+            stack.pop_back();
+            seen.manhattan_kernel(pos, [&](bool, const Pos &neighbor) {
+                if (open[neighbor] && !seen[neighbor]) {
+                    seen[neighbor] = true;
+                    ++seen_count;
+                    stack.push_back(neighbor);
+                }
+            });
+        }
+        check_equal(reached.count(), seen_count);
+    });
+
+    return suite.done(), suite.num_failed();
+}
+
 } // namespace aoc::ds::test
 
 int main() {
     std::size_t failed_count = 0;
     failed_count += aoc::ds::test::test_pairing_heap_max();
     failed_count += aoc::ds::test::test_pairing_heap_min();
+    failed_count +=
+        aoc::ds::test::test_pairing_heap_max<aoc::ds::pooled_pairing_heap<int>>(
+            "aoc::ds::pooled_pairing_heap<int>");
+    failed_count += aoc::ds::test::test_pairing_heap_min<
+        aoc::ds::pooled_pairing_heap<int, std::greater<int>>>(
+        "aoc::ds::pooled_pairing_heap<int, std::greater>");
+    failed_count += aoc::ds::test::test_pooled_pairing_heap_reuse();
+    failed_count += aoc::ds::test::test_bucket_queue();
+    failed_count += aoc::ds::test::test_disjoint_set();
+    failed_count += aoc::ds::test::test_kd_tree();
     failed_count += aoc::ds::test::test_grid<int>();
     failed_count += aoc::ds::test::test_grid<bool>();
     failed_count += aoc::ds::test::test_grid_repr();
+    failed_count += aoc::ds::test::test_grid_layout<aoc::ds::RowMajorLayout>(
+        "RowMajorLayout");
+    failed_count += aoc::ds::test::test_grid_layout<aoc::ds::TiledLayout<8>>(
+        "TiledLayout<8>");
+    failed_count += aoc::ds::test::test_grid_layout<aoc::ds::ZOrderLayout>(
+        "ZOrderLayout");
+    failed_count += aoc::ds::test::test_grid_kernels();
+    failed_count += aoc::ds::test::test_grid_from_buffer();
+    failed_count += aoc::ds::test::test_bit_grid();
     // run linter helper functions, to catch any failed asserts
     aoc::ds::test::_pairing_heap_lint_helper();
     aoc::ds::test::_grid_lint_helper();
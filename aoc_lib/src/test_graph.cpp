@@ -8,11 +8,16 @@
 
 #include "unit_test/unit_test.hpp"
 
+#include "ds/grid.hpp" // for Grid
 #include "graph_traversal.hpp"
-#include <algorithm>        // for sort
+#include "incremental_path.hpp" // for IncrementalGridPath
+#include "lib.hpp"          // for Pos, AbsDirection, DIRECTIONS
+#include <algorithm>        // for sort, for_each
 #include <cstddef>          // for size_t
 #include <initializer_list> // for initializer_list
 #include <set>              // for set
+#include <string>           // for string
+#include <tuple>            // for tie
 #include <unordered_map>    // for unordered_map
 #include <utility>          // for pair
 #include <vector>           // for vector
@@ -66,10 +71,463 @@ std::size_t test_tarjan_scc() {
     return test.done(), test.num_failed();
 }
 
+namespace {
+const ds::Grid<char> TEST_MAZE{std::vector<std::string>{
+    "S..#......",
+    ".#.#.####.",
+    ".#...#....",
+    ".####.#.#.",
+    "......#.#E",
+}};
+const Pos TEST_MAZE_START{0, 0};
+const Pos TEST_MAZE_END{9, 4};
+
+struct PosDir {
+    Pos pos;
+    AbsDirection dir;
+
+    auto operator<=>(const PosDir &) const = default;
+};
+
+// process_neighbors for Pos keys
+const auto maze_neighbors = [](const Pos &pos, auto &&process) {
+    TEST_MAZE.manhattan_kernel(pos, [&](char c, const Pos &neighbor) {
+        if (c != '#' && neighbor != pos) {
+            process(neighbor);
+        }
+    });
+};
+
+// process_neighbors for PosDir keys: move forwards or turn in place
+const auto maze_neighbors_dir = [](const PosDir &key, auto &&process) {
+    Pos forward = key.pos + Delta(key.dir, true);
+    if (TEST_MAZE.in_bounds(forward) && TEST_MAZE[forward] != '#') {
+        process(PosDir{forward, key.dir});
+    }
+    process(PosDir{key.pos, directions::turn(key.dir, RelDirection::left)});
+    process(PosDir{key.pos, directions::turn(key.dir, RelDirection::right)});
+};
+
+// reverse of maze_neighbors_dir: step backwards or turn in place
+const auto maze_neighbors_dir_rev = [](const PosDir &key, auto &&process) {
+    Pos backward = key.pos - Delta(key.dir, true);
+    if (TEST_MAZE.in_bounds(backward) && TEST_MAZE[backward] != '#') {
+        process(PosDir{backward, key.dir});
+    }
+    process(PosDir{key.pos, directions::turn(key.dir, RelDirection::left)});
+    process(PosDir{key.pos, directions::turn(key.dir, RelDirection::right)});
+};
+} // namespace
+
+std::size_t test_dense_indexer() {
+    unit_test::TestSuite suite("aoc::graph dense indexer");
+    using namespace unit_test::checks;
+
+    const auto is_target = [](const Pos &pos) { return pos == TEST_MAZE_END; };
+    const auto get_distance = [](const Pos &, const Pos &) { return 1; };
+    const auto heuristic = [](const Pos &pos) {
+        return (pos - TEST_MAZE_END).manhattan_distance();
+    };
+    const auto indexer = make_grid_indexer(TEST_MAZE);
+
+    suite.test("bfs", [&]() {
+        int expected = bfs(TEST_MAZE_START, maze_neighbors, is_target, {});
+        check_equal(expected, 17);
+        check_equal(bfs(TEST_MAZE_START, maze_neighbors, is_target, {},
+                        indexer),
+                    expected);
+    });
+    suite.test("dijkstra", [&]() {
+        auto expected = dijkstra(TEST_MAZE_START, maze_neighbors,
+                                 get_distance, is_target, {});
+        check_equal(expected.first, 17);
+        auto result = dijkstra(TEST_MAZE_START, maze_neighbors, get_distance,
+                               is_target, {}, indexer);
+        check_equal(result.first, expected.first);
+        check_equal(result.second.size(), expected.second.size());
+    });
+    suite.test("a_star", [&]() {
+        auto expected = a_star(TEST_MAZE_START, maze_neighbors, get_distance,
+                               is_target, heuristic, {});
+        check_equal(expected.first, 17);
+        auto result = a_star(TEST_MAZE_START, maze_neighbors, get_distance,
+                             is_target, heuristic, {}, indexer);
+        check_equal(result.first, expected.first);
+        check_equal(result.second.size(), expected.second.size());
+    });
+    suite.test("pos+dir keys", [&]() {
+        const auto get_distance_dir = [](const PosDir &from,
+                                         const PosDir &to) {
+            return from.dir == to.dir ? 1 : 1000;
+        };
+        const auto is_target_dir = [](const PosDir &key) {
+            return key.pos == TEST_MAZE_END;
+        };
+        const PosDir source{TEST_MAZE_START, AbsDirection::east};
+        auto expected = dijkstra(source, maze_neighbors_dir,
+                                 get_distance_dir, is_target_dir, {});
+        auto result =
+            dijkstra(source, maze_neighbors_dir, get_distance_dir,
+                     is_target_dir, {}, make_pos_dir_indexer(TEST_MAZE));
+        check_equal(result.first, expected.first);
+        check_equal(result.second.size(), expected.second.size());
+    });
+
+    return suite.done(), suite.num_failed();
+}
+
+std::size_t test_bounded_dijkstra() {
+    unit_test::TestSuite suite("aoc::graph::dijkstra with bucket queue");
+    using namespace unit_test::checks;
+
+    suite.test("pos+dir keys", []() {
+        const auto get_distance = [](const PosDir &from, const PosDir &to) {
+            return from.dir == to.dir ? 1 : 1000;
+        };
+        const auto is_target = [](const PosDir &key) {
+            return key.pos == TEST_MAZE_END;
+        };
+        const PosDir source{TEST_MAZE_START, AbsDirection::east};
+        auto expected = dijkstra(source, maze_neighbors_dir, get_distance,
+                                 is_target, {});
+        auto result =
+            dijkstra(source, maze_neighbors_dir,
+                     with_max_weight(1000, get_distance), is_target, {});
+        check_equal(result.first, expected.first);
+        check_equal(result.second.size(), expected.second.size());
+        result = dijkstra(source, maze_neighbors_dir,
+                          with_max_weight(1000, get_distance), is_target, {},
+                          make_pos_dir_indexer(TEST_MAZE));
+        check_equal(result.first, expected.first);
+    });
+
+    return suite.done(), suite.num_failed();
+}
+
+std::size_t test_decrease_key() {
+    unit_test::TestSuite suite("aoc::graph decrease-key searches");
+    using namespace unit_test::checks;
+
+    const auto get_distance = [](const PosDir &from, const PosDir &to) {
+        return from.dir == to.dir ? 1 : 1000;
+    };
+    const auto is_target = [](const PosDir &key) {
+        return key.pos == TEST_MAZE_END;
+    };
+    const auto heuristic = [](const PosDir &key) {
+        return (key.pos - TEST_MAZE_END).manhattan_distance();
+    };
+    const PosDir source{TEST_MAZE_START, AbsDirection::east};
+
+    suite.test("dijkstra", [&]() {
+        search_stats lazy_stats, stats;
+        auto expected = dijkstra(source, maze_neighbors_dir, get_distance,
+                                 is_target, {}, {}, &lazy_stats);
+        auto result = dijkstra_decrease_key(
+            source, maze_neighbors_dir, get_distance, is_target, {}, {},
+            &stats);
+        check_equal(result.first, expected.first);
+        check_equal(result.second.size(), expected.second.size());
+        check_equal(result.second.front(), source);
+        check(is_target(result.second.back()), "path doesn't end at target");
+        check(stats.pops <= stats.pushes, "more pops than pushes");
+        check(stats.pushes + stats.updates <=
+                  lazy_stats.pushes + lazy_stats.updates,
+              "decrease-key did more frontier operations");
+        check_equal(lazy_stats.updates, 0ul);
+
+        result = dijkstra_decrease_key(source, maze_neighbors_dir,
+                                       get_distance, is_target, {},
+                                       make_pos_dir_indexer(TEST_MAZE));
+        check_equal(result.first, expected.first);
+    });
+    suite.test("dijkstra with updates", []() {
+        // diamond: 0 -> 1 (10), 0 -> 2 (1), 2 -> 1 (1), 1 -> 3 (1)
+        const auto neighbors = [](int node, auto &&process) {
+            if (node == 0) {
+                process(1);
+                process(2);
+            } else if (node == 2) {
+                process(1);
+            } else if (node == 1) {
+                process(3);
+            }
+        };
+        const auto weight = [](int from, int to) {
+            return from == 0 && to == 1 ? 10 : 1;
+        };
+        search_stats stats;
+        auto result = dijkstra_decrease_key(
+            0, neighbors, weight, [](int node) { return node == 3; }, {}, {},
+            &stats);
+        check_equal(result.first, 3);
+        check_equal(result.second, std::vector<int>{0, 2, 1, 3});
+        check_equal(stats.updates, 1ul);
+        check_equal(stats.pushes, 4ul);
+        check_equal(stats.pops, 4ul);
+
+        result = dijkstra_decrease_key(
+            0, neighbors, weight, [](int node) { return node == 4; }, {});
+        check_equal(result.first, -1);
+        check(result.second.empty(), "path should be empty");
+    });
+    suite.test("a_star", [&]() {
+        search_stats lazy_stats, stats;
+        auto expected = a_star(source, maze_neighbors_dir, get_distance,
+                               is_target, heuristic, {}, {}, &lazy_stats);
+        auto result = a_star_decrease_key(source, maze_neighbors_dir,
+                                          get_distance, is_target, heuristic,
+                                          {}, {}, &stats);
+        check_equal(result.first, expected.first);
+        check_equal(result.second.size(), expected.second.size());
+        check(stats.pops <= stats.pushes, "more pops than pushes");
+        result = a_star_decrease_key<true>(
+            source, maze_neighbors_dir, get_distance, is_target, heuristic, {},
+            make_pos_dir_indexer(TEST_MAZE));
+        check_equal(result.first, expected.first);
+    });
+
+    return suite.done(), suite.num_failed();
+}
+
+std::size_t test_bidirectional() {
+    unit_test::TestSuite suite("aoc::graph bidirectional searches");
+    using namespace unit_test::checks;
+
+    const auto check_path = [](const auto &path, const auto &source,
+                               const auto &target, auto &&neighbors) {
+        check_equal(path.front(), source);
+        check_equal(path.back(), target);
+        for (std::size_t i = 0; i + 1 < path.size(); ++i) {
+            bool found = false;
+            neighbors(path[i], [&](const auto &neighbor) {
+                found = found || neighbor == path[i + 1];
+            });
+            check(found, "path contains a missing edge");
+        }
+    };
+
+    suite.test("bfs", [&]() {
+        auto [distance, path] =
+            bfs_bidirectional(TEST_MAZE_START, TEST_MAZE_END, maze_neighbors,
+                              maze_neighbors);
+        check_equal(distance, 17);
+        check_equal(path.size(), 18ul);
+        check_path(path, TEST_MAZE_START, TEST_MAZE_END, maze_neighbors);
+
+        std::tie(distance, path) =
+            bfs_bidirectional(TEST_MAZE_END, TEST_MAZE_START, maze_neighbors,
+                              maze_neighbors, make_grid_indexer(TEST_MAZE));
+        check_equal(distance, 17);
+        check_path(path, TEST_MAZE_END, TEST_MAZE_START, maze_neighbors);
+
+        std::tie(distance, path) = bfs_bidirectional(
+            TEST_MAZE_START, TEST_MAZE_START, maze_neighbors, maze_neighbors);
+        check_equal(distance, 0);
+        check_equal(path, std::vector<Pos>{TEST_MAZE_START});
+    });
+    suite.test("bfs directed", []() {
+        // 0 -> 1 -> 2 -> 3 -> 4, plus a shortcut 1 -> 3 and a dead end 4 -> 5
+        const std::unordered_map<int, std::vector<int>> edges{
+            {0, {1}}, {1, {2, 3}}, {2, {3}}, {3, {4}}, {4, {5}}};
+        std::unordered_map<int, std::vector<int>> reverse_edges;
+        for (const auto &[from, tos] : edges) {
+            for (int to : tos) {
+                reverse_edges[to].push_back(from);
+            }
+        }
+        const auto forward = [&edges](int node, auto &&process) {
+            if (auto it = edges.find(node); it != edges.end()) {
+                std::ranges::for_each(it->second, process);
+            }
+        };
+        const auto reverse = [&reverse_edges](int node, auto &&process) {
+            if (auto it = reverse_edges.find(node); it != reverse_edges.end()) {
+                std::ranges::for_each(it->second, process);
+            }
+        };
+        auto result = bfs_bidirectional(0, 4, forward, reverse);
+        check_equal(result.first, 3);
+        check_equal(result.second, std::vector<int>{0, 1, 3, 4});
+        result = bfs_bidirectional(4, 0, forward, reverse);
+        check_equal(result.first, -1);
+        check(result.second.empty(), "path should be empty");
+    });
+    suite.test("dijkstra", [&]() {
+        const auto get_distance = [](const PosDir &from, const PosDir &to) {
+            return from.dir == to.dir ? 1 : 1000;
+        };
+        const PosDir source{TEST_MAZE_START, AbsDirection::east};
+        for (const AbsDirection dir : DIRECTIONS) {
+            const PosDir target{TEST_MAZE_END, dir};
+            auto expected =
+                dijkstra(source, maze_neighbors_dir, get_distance,
+                         [&target](const PosDir &key) { return key == target; },
+                         {});
+            auto result = dijkstra_bidirectional(
+                source, target, maze_neighbors_dir, maze_neighbors_dir_rev,
+                get_distance);
+            check_equal(result.first, expected.first);
+            check_path(result.second, source, target, maze_neighbors_dir);
+            int path_length = 0;
+            for (std::size_t i = 0; i + 1 < result.second.size(); ++i) {
+                path_length +=
+                    get_distance(result.second[i], result.second[i + 1]);
+            }
+            check_equal(path_length, expected.first);
+
+            result = dijkstra_bidirectional(
+                source, target, maze_neighbors_dir, maze_neighbors_dir_rev,
+                with_max_weight(1000, get_distance),
+                make_pos_dir_indexer(TEST_MAZE));
+            check_equal(result.first, expected.first);
+        }
+    });
+
+    return suite.done(), suite.num_failed();
+}
+
+std::size_t test_parallel_bfs() {
+    unit_test::TestSuite suite("aoc::graph::bfs_parallel");
+    using namespace unit_test::checks;
+
+    constexpr int size = 200;
+    ds::Grid<bool> grid(size, size, true);
+    unsigned int state = 54321;
+    for (int i = 0; i < size * size / 4; ++i) {
+        state = state * 1103515245 + 12345;
+        const int index = (state >> 8) % (size * size);
+        grid[Pos(index % size, index / size)] = false;
+    }
+    const std::vector<Pos> sources{{0, 0}, {size / 2, size / 2}};
+    for (const Pos &source : sources) {
+        grid[source] = true;
+    }
+    const auto neighbors = [&grid](const Pos &pos, auto &&process) {
+        grid.manhattan_kernel(pos, [&](bool open, const Pos &neighbor) {
+            if (open && neighbor != pos) {
+                process(neighbor);
+            }
+        });
+    };
+    const auto indexer = make_grid_indexer(grid);
+
+    std::vector<int> expected(indexer.size(), -1);
+    bfs(sources, neighbors, {}, [&](const Pos &pos, int distance) {
+        expected[indexer(pos)] = distance;
+    });
+
+    suite.test("serial", [&]() {
+        check_equal(bfs_parallel(sources, neighbors, indexer, {1, 0}),
+                    expected);
+        // the default cutoff is larger than any level here
+        check_equal(bfs_parallel(sources, neighbors, indexer), expected);
+    });
+    suite.test("threads", [&]() {
+        for (unsigned int num_threads : {2u, 3u, 8u}) {
+            check_equal(
+                bfs_parallel(sources, neighbors, indexer, {num_threads, 1}),
+                expected);
+            check_equal(
+                bfs_parallel(sources, neighbors, indexer, {num_threads, 100}),
+                expected);
+        }
+    });
+
+    return suite.done(), suite.num_failed();
+}
+
+std::size_t test_incremental_path() {
+    unit_test::TestSuite suite("aoc::graph::IncrementalGridPath");
+    using namespace unit_test::checks;
+
+    // compare against a fresh bfs after each change
+    const auto check_grid = [](const ds::Grid<bool> &grid,
+                               IncrementalGridPath &engine, const Pos &source,
+                               const Pos &target) {
+        const auto neighbors = [&grid](const Pos &pos, auto &&process) {
+            grid.manhattan_kernel(pos, [&](bool open, const Pos &neighbor) {
+                if (open && neighbor != pos) {
+                    process(neighbor);
+                }
+            });
+        };
+        int expected = -1;
+        if (grid[source] && grid[target]) {
+            expected = bfs(
+                source, neighbors,
+                [&target](const Pos &pos) { return pos == target; }, {});
+        }
+        check_equal(engine.query(), expected);
+        auto path = engine.path();
+        check_equal(static_cast<int>(path.size()), expected + 1);
+        for (std::size_t i = 0; i < path.size(); ++i) {
+            check(grid[path[i]], "path goes through a blocked cell");
+            if (i > 0) {
+                check_equal((path[i] - path[i - 1]).manhattan_distance(), 1);
+            }
+        }
+    };
+
+    suite.test("maze", [&]() {
+        ds::Grid<bool> grid(TEST_MAZE.width, TEST_MAZE.height, true);
+        for (int y = 0; y < grid.height; ++y) {
+            for (int x = 0; x < grid.width; ++x) {
+                grid[Pos(x, y)] = TEST_MAZE[Pos(x, y)] != '#';
+            }
+        }
+        IncrementalGridPath engine(grid, TEST_MAZE_START, TEST_MAZE_END);
+        check_equal(engine.query(), 17);
+        check_grid(grid, engine, TEST_MAZE_START, TEST_MAZE_END);
+        // (4, 4) is off the path, and (4, 2) is the only way through
+        for (const Pos &pos : {Pos(4, 4), Pos(4, 2)}) {
+            grid[pos] = false;
+            engine.block(pos);
+            check_grid(grid, engine, TEST_MAZE_START, TEST_MAZE_END);
+        }
+        check_equal(engine.query(), -1);
+        grid[Pos(4, 2)] = true;
+        engine.unblock(Pos(4, 2));
+        check_grid(grid, engine, TEST_MAZE_START, TEST_MAZE_END);
+        check_equal(engine.query(), 17);
+    });
+    suite.test("random blocks", [&]() {
+        constexpr int size = 15;
+        ds::Grid<bool> grid(size, size, true);
+        const Pos source{0, 0};
+        const Pos target{size - 1, size - 1};
+        IncrementalGridPath engine(grid, source, target);
+        unsigned int state = 12345;
+        const auto next_random = [&state]() {
+            state = state * 1103515245 + 12345;
+            return (state >> 16) % (size * size);
+        };
+        for (int i = 0; i < 150; ++i) {
+            const Pos pos(next_random() % size, next_random() / size);
+            grid[pos] = !grid[pos];
+            if (grid[pos]) {
+                engine.unblock(pos);
+            } else {
+                engine.block(pos);
+            }
+            check_equal(engine.is_open(pos), grid[pos]);
+            check_grid(grid, engine, source, target);
+        }
+    });
+
+    return suite.done(), suite.num_failed();
+}
+
 } // namespace aoc::graph::test
 
 int main() {
     std::size_t failed_count = 0;
     failed_count += aoc::graph::test::test_tarjan_scc();
+    failed_count += aoc::graph::test::test_dense_indexer();
+    failed_count += aoc::graph::test::test_bounded_dijkstra();
+    failed_count += aoc::graph::test::test_decrease_key();
+    failed_count += aoc::graph::test::test_bidirectional();
+    failed_count += aoc::graph::test::test_parallel_bfs();
+    failed_count += aoc::graph::test::test_incremental_path();
     return unit_test::fix_exit_code(failed_count);
 }
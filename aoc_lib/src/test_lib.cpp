@@ -7,15 +7,23 @@
  *****************************************************************************/
 
 #include "unit_test/unit_test.hpp"
-#include "util/util.hpp" // for demangle
-
-#include "lib.hpp"  // for expect_input, as_number
-#include <cstddef>  // for size_t
-#include <iostream> // for istream
-#include <limits>   // for numeric_limits
-#include <sstream>  // for istringstream, ostringstream, skipws, noskipws
-#include <string>   // for string, to_string, string_literals
-#include <typeinfo> // for type_info
+#include "util/hash.hpp"        // for hash_bytes
+#include "util/thread_pool.hpp" // for ThreadPool
+#include "util/util.hpp"        // for demangle
+
+#include "cycle.hpp"     // for find_cycle, brent, fast_forward, cycle_info
+#include "lib.hpp"       // for expect_input, as_number, lines, scan_int
+#include <atomic>        // for atomic
+#include <cstddef>       // for size_t
+#include <cstdint>       // for uint64_t
+#include <iostream>      // for istream
+#include <limits>        // for numeric_limits
+#include <sstream>       // for istringstream, ostringstream, skipws, noskipws
+#include <string>        // for string, to_string, string_literals
+#include <string_view>   // for string_view
+#include <typeinfo>      // for type_info
+#include <unordered_map> // for unordered_map
+#include <vector>        // for vector
 // IWYU pragma: no_include <utility>  // for move (expect_input)
 
 namespace aoc::test {
@@ -109,6 +117,306 @@ std::size_t test_as_number_insertion() {
     return test.done(), test.num_failed();
 }
 
+std::size_t test_string_views() {
+    using namespace unit_test::checks;
+    unit_test::TestSuite suite("aoc string_view parsing");
+
+    suite.test("read_lines", []() {
+        using lines_t = std::vector<std::string_view>;
+        check_equal(aoc::read_lines(""), lines_t{});
+        check_equal(aoc::read_lines("a\nbc\n"), lines_t{"a", "bc"});
+        check_equal(aoc::read_lines("a\nbc"), lines_t{"a", "bc"});
+        check_equal(aoc::read_lines("a\n\n\nb\n"), lines_t{"a", "", "", "b"});
+        // should match std::getline
+        for (std::string text : {"", "\n", "x\n\n", "1\n2\n3", " \n \n"}) {
+            std::istringstream ss{text};
+            std::vector<std::string> expected = aoc::read_lines(ss);
+            check_equal(aoc::read_lines(text).size(), expected.size());
+        }
+    });
+
+    suite.test("fields", []() {
+        std::vector<std::string_view> result;
+        for (std::string_view field : aoc::fields("  12 a   bcd ")) {
+            result.push_back(field);
+        }
+        check_equal(result, std::vector<std::string_view>{"12", "a", "bcd"});
+        result.clear();
+        for (std::string_view field : aoc::fields("1,,2", ',')) {
+            result.push_back(field);
+        }
+        check_equal(result, std::vector<std::string_view>{"1", "2"});
+    });
+
+    suite.test("scan_int", []() {
+        std::string_view text = " 12\n-34\t+5 +-6";
+        int value = 0;
+        check(aoc::scan_int(text, value), "scanning 12");
+        check_equal(value, 12);
+        check(aoc::scan_int(text, value), "scanning -34");
+        check_equal(value, -34);
+        check(aoc::scan_int(text, value), "scanning +5");
+        check_equal(value, 5);
+        check(!aoc::scan_int(text, value), "failing on +-6");
+        check_equal(value, 5);
+        check_equal(text, std::string_view{"+-6"});
+
+        text = "300";
+        unsigned char small = 0;
+        check(!aoc::scan_int(text, small), "failing on overflow");
+        text = "   ";
+        check(!aoc::scan_int(text, value), "failing on whitespace");
+        check(text.empty(), "consuming trailing whitespace");
+    });
+
+    suite.test("read_vector", []() {
+        check_equal(aoc::read_vector<int>("1 2\n  -3 x 4"),
+                    std::vector<int>{1, 2, -3});
+        check_equal(aoc::read_vector<long>(""), std::vector<long>{});
+        // should match the stream version
+        std::string text = "7 6 4 2 1\n1 2 7 8 9\n";
+        std::istringstream ss{text};
+        check_equal(aoc::read_vector<int>(text), aoc::read_vector<int>(ss));
+    });
+
+    return suite.done(), suite.num_failed();
+}
+
+std::size_t test_int_scanning() {
+    using namespace unit_test::checks;
+    unit_test::TestSuite suite("aoc integer scanning");
+
+    // a digit run that straddles the 64-byte block boundary, and one that
+    // ends exactly at the end of a block
+    const std::string long_line =
+        std::string(60, ' ') + "123456 " + std::string(56, ' ') + "-42";
+
+    suite.test("read_vector matches istream", [&long_line]() {
+        for (std::string text :
+             {"", "1", "  -5 +7\n8", "1-2", "12abc 3", "1 2.5 3", "1 --2",
+              "1 + 2", "9999999999 1", "2147483647 -2147483648 2147483648",
+              "  00012\t\r\n3  ", long_line.c_str()}) {
+            std::istringstream ss{text};
+            check_equal(aoc::read_vector<int>(text), aoc::read_vector<int>(ss),
+                        "on \"" + text + "\"");
+        }
+        std::string text = "18446744073709551615 18446744073709551616";
+        std::istringstream ss{text};
+        check_equal(aoc::read_vector<unsigned long>(text),
+                    aoc::read_vector<unsigned long>(ss));
+    });
+
+    suite.test("parse_csv_ints matches read_csv", [&long_line]() {
+        for (std::string text :
+             {"", "1", "3,4,5", " 3, 4,\n5\n6", "1,2 ,3", "1,x,3", "1,,2",
+              "-1,+2,-3}", "7,8\n9,10", "300,2147483648,1"}) {
+            std::istringstream ss{text};
+            check_equal(aoc::parse_csv_ints<int>(text),
+                        aoc::read_csv<int>(ss), "on \"" + text + "\"");
+        }
+        std::string csv;
+        for (int i = 0; i < 100; ++i) {
+            csv += (i > 0 ? "," : "") + std::to_string(i * 997 - 5000);
+        }
+        std::istringstream ss{csv};
+        check_equal(aoc::parse_csv_ints<long>(csv), aoc::read_csv<long>(ss));
+    });
+
+    suite.test("parse_ints", [&long_line]() {
+        check_equal(aoc::parse_ints("x=3,y=-12..5"),
+                    std::vector<int>{3, -12, 5});
+        check_equal(aoc::parse_ints<unsigned>("x=3,y=-12..5"),
+                    std::vector<unsigned>{3, 12, 5});
+        check_equal(aoc::parse_ints("Button A: X+94, Y+34"),
+                    std::vector<int>{94, 34});
+        check_equal(aoc::parse_ints("no numbers"), std::vector<int>{});
+        check_equal(aoc::parse_ints(long_line),
+                    std::vector<int>{123456, -42});
+        check_equal(aoc::parse_ints<short>("1 2 99999 3"),
+                    std::vector<short>{1, 2});
+        check_equal(aoc::parse_ints<long>("-9223372036854775808"),
+                    std::vector<long>{std::numeric_limits<long>::min()});
+    });
+
+    return suite.done(), suite.num_failed();
+}
+
+std::size_t test_thread_pool() {
+    using namespace unit_test::checks;
+    unit_test::TestSuite suite("util::ThreadPool");
+
+    suite.test("runs every task", []() {
+        for (std::size_t num_threads : {1, 2, 4}) {
+            std::atomic<int> count = 0;
+            util::ThreadPool pool(num_threads);
+            for (int i = 0; i < 1000; ++i) {
+                pool.submit([&count]() { ++count; });
+            }
+            pool.wait();
+            check_equal(count.load(), 1000,
+                        "with " + std::to_string(num_threads) + " threads");
+        }
+    });
+
+    suite.test("tasks submitted from workers", []() {
+        std::atomic<int> count = 0;
+        util::ThreadPool pool(3);
+        for (int i = 0; i < 50; ++i) {
+            pool.submit([&pool, &count]() {
+                for (int j = 0; j < 20; ++j) {
+                    pool.submit([&count]() { ++count; });
+                }
+                ++count;
+            });
+        }
+        pool.wait();
+        check_equal(count.load(), 50 * 21);
+    });
+
+    suite.test("destructor finishes queued tasks", []() {
+        std::atomic<int> count = 0;
+        {
+            util::ThreadPool pool(2);
+            for (int i = 0; i < 100; ++i) {
+                pool.submit([&count]() { ++count; });
+            }
+        }
+        check_equal(count.load(), 100);
+    });
+
+    return suite.done(), suite.num_failed();
+}
+
+std::size_t test_cycle() {
+    using namespace unit_test::checks;
+    unit_test::TestSuite suite("aoc::cycle");
+
+    // x -> (x^2 + c) mod m, which has a tail and a cycle for most inputs
+    struct Rho {
+        long m;
+        long c;
+        void operator()(long &x) const { x = (x * x + c) % m; }
+    };
+    const auto identity_fp = [](long x) {
+        return static_cast<std::uint64_t>(x);
+    };
+    // reference (mu, lambda), from a table of every state
+    const auto naive_cycle = [](long x, const Rho &step) {
+        std::unordered_map<long, long> seen;
+        for (long i = 0;; ++i, step(x)) {
+            const auto [it, inserted] = seen.try_emplace(x, i);
+            if (!inserted) {
+                return aoc::cycle::cycle_info{it->second, i - it->second, i};
+            }
+        }
+    };
+    const auto naive_nth = [](long x, long n, const Rho &step) {
+        for (long i = 0; i < n; ++i) {
+            step(x);
+        }
+        return x;
+    };
+
+    suite.test("find_cycle and brent match a full table", [&]() {
+        for (long m : {2L, 7L, 101L, 1009L, 65537L}) {
+            for (long c : {1L, 2L, 5L}) {
+                const Rho step{m, c};
+                const auto expected = naive_cycle(3 % m, step);
+                for (bool use_brent : {false, true}) {
+                    long x = 3 % m;
+                    const auto info =
+                        use_brent ? aoc::cycle::brent(x, step, identity_fp)
+                                  : aoc::cycle::find_cycle(x, step, identity_fp);
+                    const std::string info_str =
+                        (use_brent ? "brent, m=" : "find_cycle, m=") +
+                        std::to_string(m) + ", c=" + std::to_string(c);
+                    check(info.has_value(), info_str);
+                    check_equal(info->start, expected.start, info_str);
+                    check_equal(info->length, expected.length, info_str);
+                    check_equal(x, naive_nth(3 % m, info->position, step),
+                                info_str + ", state at position");
+                }
+            }
+        }
+    });
+
+    suite.test("fast_forward", [&]() {
+        const Rho step{1009, 1};
+        for (long n : {0L, 1L, 5L, 100L, 1000L, 12345L}) {
+            long x = 3;
+            aoc::cycle::fast_forward(x, n, step, identity_fp);
+            check_equal(x, naive_nth(3, n, step), "n=" + std::to_string(n));
+        }
+        long x = 3;
+        aoc::cycle::fast_forward(x, 1'000'000'000'000L, step, identity_fp);
+        const auto expected = naive_cycle(3, step);
+        check_equal(x, naive_nth(3, expected.reduce(1'000'000'000'000L), step));
+    });
+
+    suite.test("fingerprint collisions", [&]() {
+        // every state collides, so only the verification can find the cycle
+        const Rho step{1009, 1};
+        const auto constant_fp = [](long) { return std::uint64_t{0}; };
+        for (long n : {10L, 1000L, 1'000'000L}) {
+            long x = 3;
+            aoc::cycle::fast_forward(x, n, step, constant_fp);
+            const auto expected = naive_cycle(3, step);
+            check_equal(x, naive_nth(3, expected.reduce(n), step),
+                        "n=" + std::to_string(n));
+        }
+        long x = 3;
+        const auto info = aoc::cycle::brent(x, step, constant_fp);
+        const auto expected = naive_cycle(3, step);
+        check(info.has_value());
+        check_equal(info->start, expected.start);
+        check_equal(info->length, expected.length);
+    });
+
+    suite.test("rejected candidate", [&]() {
+        // x_8 collides with x_0, and the cycle starts at x_13 while that
+        // candidate is being checked
+        const Rho step{1009, 1};
+        const auto expected = naive_cycle(3, step);
+        check_equal(expected.start, 13L);
+        const long x_8 = naive_nth(3, 8, step);
+        const auto collide_fp = [x_8](long x) {
+            return static_cast<std::uint64_t>(x == x_8 ? 3 : x);
+        };
+        long x = 3;
+        const auto info = aoc::cycle::find_cycle(x, step, collide_fp);
+        check(info.has_value());
+        check_equal(info->start, expected.start);
+        check_equal(info->length, expected.length);
+        check_equal(x, naive_nth(3, info->position, step));
+    });
+
+    suite.test("max_steps", [&]() {
+        // strictly increasing, so it never repeats
+        const auto increment = [](long &x) { ++x; };
+        long x = 0;
+        check(!aoc::cycle::find_cycle(x, increment, identity_fp, 100));
+        check_equal(x, 100L);
+        x = 0;
+        check(!aoc::cycle::fast_forward(x, 50, increment, identity_fp));
+        check_equal(x, 50L);
+    });
+
+    suite.test("hash_bytes", []() {
+        const std::vector<char> a{'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i'};
+        std::vector<char> b = a;
+        check_equal(util::hash_bytes(a), util::hash_bytes(b));
+        b.back() = 'j';
+        check(util::hash_bytes(a) != util::hash_bytes(b),
+              "changing a tail byte");
+        b = a;
+        b.push_back('\0');
+        check(util::hash_bytes(a) != util::hash_bytes(b),
+              "appending a zero byte");
+    });
+
+    return suite.done(), suite.num_failed();
+}
+
 } // namespace aoc::test
 
 int main() {
@@ -118,5 +426,9 @@ int main() {
     failed_count += aoc::test::test_as_number_extraction<unsigned char>();
     failed_count += aoc::test::test_as_number_insertion<char>();
     failed_count += aoc::test::test_as_number_insertion<unsigned char>();
+    failed_count += aoc::test::test_string_views();
+    failed_count += aoc::test::test_int_scanning();
+    failed_count += aoc::test::test_thread_pool();
+    failed_count += aoc::test::test_cycle();
     return unit_test::fix_exit_code(failed_count);
 }
@@ -7,15 +7,27 @@
 
 #include "util/math.hpp" // IWYU pragma: associated
 
+#include "ds/grid.hpp"   // for Grid
+#include "gauss_elim.hpp" // for row_echelon, solve_exact, ...
+#include "ilp.hpp"        // for ilp_min_sum, ilp_stats
+
 #include "unit_test/pretty_print.hpp" // for repr
 #include "unit_test/unit_test.hpp"
 #include "util/util.hpp" // for demangle
 
+#include <algorithm>        // for max, min
+#include <cmath>            // for abs
 #include <cstddef>          // for size_t
 #include <cstdint>          // for int64_t, uint64_t
 #include <initializer_list> // for initializer_list
 #include <iostream>         // for cout
-#include <string>           // for string
+#include <numeric>          // for lcm
+#include <optional>         // for optional
+#include <random>           // for mt19937, uniform_int_distribution, ...
+#include <stdexcept>        // for overflow_error
+#include <string>           // for string, to_string
+#include <utility>          // for pair, move
+#include <vector>           // for vector
 // IWYU pragma: no_include <typeinfo>  // for type_info (util::demangle)
 
 namespace aoc::math {
@@ -240,6 +252,427 @@ std::size_t test_crt() {
     return suite.done(), suite.num_failed();
 }
 
+std::size_t test_congruence_solver() {
+    unit_test::TestSuite suite("aoc::math::CongruenceSolver");
+    using namespace unit_test::checks;
+    using crt_entry = CongruenceSolver::crt_entry;
+
+    // smallest non-negative x satisfying every congruence, by brute force
+    const auto brute_force = [](const std::vector<crt_entry> &entries,
+                                long limit) -> std::optional<long> {
+        for (long x = 0; x < limit; ++x) {
+            bool ok = true;
+            for (const auto &[r, m] : entries) {
+                ok &= ((x - r) % m + m) % m == 0;
+            }
+            if (ok) {
+                return x;
+            }
+        }
+        return {};
+    };
+
+    suite.test("matches brute force", [&]() {
+        std::mt19937 gen(25);
+        std::uniform_int_distribution<long> mod_dist(1, 24);
+        std::uniform_int_distribution<int> count_dist(1, 4);
+        for (int trial = 0; trial < 500; ++trial) {
+            std::vector<crt_entry> entries;
+            long limit = 1;
+            for (int i = count_dist(gen); i > 0; --i) {
+                const long m = mod_dist(gen);
+                entries.push_back(
+                    {std::uniform_int_distribution<long>(-2 * m, 2 * m)(gen),
+                     m});
+                limit = std::lcm(limit, m);
+            }
+            CongruenceSolver solver;
+            const bool consistent = solver.add(entries);
+            const auto expected = brute_force(entries, limit);
+            const std::string info = "trial " + std::to_string(trial);
+            check_equal(consistent, expected.has_value(), info);
+            const auto result = solver.solution();
+            check_equal(result.has_value(), expected.has_value(), info);
+            if (result && expected) {
+                check_equal(result->remainder, *expected, info);
+                check_equal(result->modulus, limit, info);
+            }
+        }
+    });
+
+    suite.test("inconsistency is sticky", []() {
+        CongruenceSolver solver;
+        check(solver.add(1, 4));
+        check(!solver.add(2, 6), "x = 1 (mod 4) and x = 2 (mod 6)");
+        check(!solver.add(0, 1), "adding after an inconsistency");
+        check(!solver.consistent());
+        check(!solver.solution().has_value());
+    });
+
+    suite.test("wide moduli", []() {
+        // these primes multiply to more than 2^63, but less than 2^127
+        const long p = 1'000'000'007;
+        const long q = 998'244'353;
+        const long r = 1'000'000'009;
+        CongruenceSolver solver;
+        check(solver.add(5, p));
+        check(solver.add(7, q));
+        check(solver.add(11, r));
+        const __int128 modulus = static_cast<__int128>(p) * q * r;
+        check(solver.modulus() == modulus, "modulus");
+        check(solver.remainder() % p == 5 && solver.remainder() % q == 7 &&
+                  solver.remainder() % r == 11,
+              "remainder");
+        check(solver.remainder() >= 0 && solver.remainder() < modulus,
+              "remainder range");
+        bool threw = false;
+        try {
+            [[maybe_unused]] auto result = solver.solution();
+        } catch (const std::overflow_error &) {
+            threw = true;
+        }
+        check(threw, "solution() should overflow long");
+        // 2^61 - 1 is also prime, and overflows __int128
+        threw = false;
+        try {
+            solver.add(13, (1L << 61) - 1);
+        } catch (const std::overflow_error &) {
+            threw = true;
+        }
+        check(threw, "add() should overflow __int128");
+    });
+
+    suite.test("solve_each", []() {
+        CongruenceSolver base;
+        base.add(2, 6);
+        const std::vector<crt_entry> queries{{1, 5}, {3, 4}, {5, 9}, {0, 1}};
+        const auto results = base.solve_each(queries);
+        check_equal(results.size(), queries.size());
+        check(results[0] == crt_entry{26, 30}, "x = 1 (mod 5)");
+        check(!results[1].has_value(), "x = 3 (mod 4)");
+        check(results[2] == crt_entry{14, 18}, "x = 5 (mod 9)");
+        check(results[3] == crt_entry{2, 6}, "x = 0 (mod 1)");
+        check(base.solution() == crt_entry{2, 6}, "base is unchanged");
+    });
+
+    return suite.done(), suite.num_failed();
+}
+
+std::size_t test_ilp_min_sum() {
+    unit_test::TestSuite suite("aoc::math::ilp_min_sum");
+    using namespace unit_test::checks;
+    using aoc::ds::Grid;
+
+    // minimum of sum(x) over A x = b, trying every x with 0 <= x[c] <= limit
+    const auto brute_force = [](const Grid<int> &A, const std::vector<int> &b,
+                                int limit) {
+        std::optional<int> best;
+        std::vector<int> x(A.width, 0);
+        while (true) {
+            bool valid = true;
+            for (int r = 0; r < A.height && valid; ++r) {
+                int total = 0;
+                for (int c = 0; c < A.width; ++c) {
+                    total += A.at(c, r) * x[c];
+                }
+                valid = total == b[r];
+            }
+            int sum = 0;
+            for (int value : x) {
+                sum += value;
+            }
+            if (valid && (!best || sum < *best)) {
+                best = sum;
+            }
+            int c = 0;
+            while (c < A.width && x[c] == limit) {
+                x[c++] = 0;
+            }
+            if (c == A.width) {
+                return best;
+            }
+            ++x[c];
+        }
+    };
+
+    suite.test("2025 day 10 example", []() {
+        // [.##.] (3) (1,3) (2) (2,3) (0,2) (0,1) {3,5,4,7}
+        Grid<int> A(6, 4, 0);
+        for (auto [c, r] : {std::pair{0, 3}, {1, 1}, {1, 3}, {2, 2}, {3, 2},
+                            {3, 3}, {4, 0}, {4, 2}, {5, 0}, {5, 1}}) {
+            A.at(c, r) = 1;
+        }
+        aoc::math::ilp_stats stats;
+        check_equal(aoc::math::ilp_min_sum(A, {3, 5, 4, 7}, &stats),
+                    std::optional<int>(10));
+        check(stats.nodes > 0);
+    });
+
+    suite.test("infeasible", []() {
+        Grid<int> A(2, 1, 2);
+        check_equal(aoc::math::ilp_min_sum(A, {3}), std::optional<int>());
+        // inconsistent after elimination
+        Grid<int> B(2, 2, 1);
+        check_equal(aoc::math::ilp_min_sum(B, {1, 2}), std::optional<int>());
+    });
+
+    suite.test("matches brute force", [&brute_force]() {
+        std::mt19937 gen(10);
+        std::uniform_int_distribution<int> size_dist(1, 5);
+        std::uniform_int_distribution<int> coeff_dist(0, 2);
+        std::uniform_int_distribution<int> x_dist(0, 4);
+        for (int i = 0; i < 200; ++i) {
+            const int width = size_dist(gen);
+            const int height = size_dist(gen);
+            Grid<int> A(width, height, 0);
+            A.for_each([&](int &value) { value = coeff_dist(gen); });
+            std::vector<int> b(height, 0);
+            for (int c = 0; c < width; ++c) {
+                const int x = x_dist(gen);
+                for (int r = 0; r < height; ++r) {
+                    b[r] += A.at(c, r) * x;
+                }
+            }
+            // a column of zeros is unbounded, but should always be 0
+            int limit = 0;
+            for (int value : b) {
+                limit = std::max(limit, value);
+            }
+            check_equal(aoc::math::ilp_min_sum(A, b),
+                        brute_force(A, b, limit),
+                        "on system " + std::to_string(i));
+        }
+    });
+
+    return suite.done(), suite.num_failed();
+}
+
+std::size_t test_gauss_elim() {
+    unit_test::TestSuite suite("aoc::math::gauss_elim");
+    using namespace unit_test::checks;
+    using aoc::ds::Grid;
+
+    const auto multiply = []<class T>(const Grid<T> &A,
+                                      const std::vector<T> &x) {
+        std::vector<T> b(A.height, 0);
+        for (int r = 0; r < A.height; ++r) {
+            for (int c = 0; c < A.width; ++c) {
+                b[r] += A.at(c, r) * x[c];
+            }
+        }
+        return b;
+    };
+    // fills A with random coefficients, and returns b = A x
+    const auto random_system = [&multiply]<class T>(std::mt19937 &gen,
+                                                    Grid<T> &A,
+                                                    const std::vector<T> &x) {
+        std::uniform_int_distribution<int> coeff_dist(-5, 5);
+        A.for_each([&](T &value) { value = coeff_dist(gen); });
+        return multiply(A, x);
+    };
+
+    suite.test("integer solve", [&random_system]() {
+        std::mt19937 gen(22);
+        std::uniform_int_distribution<int> size_dist(1, 6);
+        std::uniform_int_distribution<long long> x_dist(-10, 10);
+        int solved = 0;
+        for (int i = 0; i < 300; ++i) {
+            const int n = size_dist(gen);
+            std::vector<long long> x(n);
+            for (auto &value : x) {
+                value = x_dist(gen);
+            }
+            Grid<long long> A(n, n);
+            std::vector<long long> b = random_system(gen, A, x);
+            Grid<long long> A2 = A;
+            std::vector<long long> b2 = b;
+            if (aoc::math::row_echelon(A, b)) {
+                ++solved;
+                check_equal(aoc::math::back_substitute(A, b), x,
+                            "on system " + std::to_string(i));
+                // the RowPermuter interface gives the same answer
+                auto rp = aoc::math::gauss_elim(A2, b2);
+                check(rp.has_value(), "on system " + std::to_string(i));
+                check_equal(aoc::math::solve_upper_triangular(A2, b2, *rp), x,
+                            "on system " + std::to_string(i));
+            }
+        }
+        check(solved > 200, "too many singular systems");
+    });
+
+    suite.test("floating-point solve", [&random_system]() {
+        std::mt19937 gen(22);
+        std::uniform_int_distribution<int> size_dist(2, 8);
+        std::uniform_real_distribution<double> x_dist(-10, 10);
+        for (int i = 0; i < 300; ++i) {
+            const int n = size_dist(gen);
+            std::vector<double> x(n);
+            for (auto &value : x) {
+                value = x_dist(gen);
+            }
+            Grid<double> A(n, n);
+            std::vector<double> b = random_system(gen, A, x);
+            if (aoc::math::row_echelon(A, b)) {
+                std::vector<double> result = aoc::math::back_substitute(A, b);
+                for (int c = 0; c < n; ++c) {
+                    check(std::abs(result[c] - x[c]) < 1e-6,
+                          "on system " + std::to_string(i) + ", x[" +
+                              std::to_string(c) + "]");
+                }
+            }
+        }
+    });
+
+    suite.test("integer reduced row echelon", [&random_system, &multiply]() {
+        std::mt19937 gen(23);
+        std::uniform_int_distribution<int> size_dist(1, 6);
+        std::uniform_int_distribution<int> x_dist(-10, 10);
+        for (int i = 0; i < 300; ++i) {
+            const std::string info = "on system " + std::to_string(i);
+            const int width = size_dist(gen);
+            const int height = size_dist(gen);
+            std::vector<long long> x(width);
+            for (auto &value : x) {
+                value = x_dist(gen);
+            }
+            Grid<long long> A(width, height);
+            std::vector<long long> b = random_system(gen, A, x);
+            // give some systems a zero column or a repeated row
+            if (i % 3 == 1) {
+                for (int r = 0; r < height; ++r) {
+                    A.at(0, r) = 0;
+                }
+            } else if (i % 3 == 2) {
+                for (int c = 0; c < width; ++c) {
+                    A.at(c, height - 1) = A.at(c, 0);
+                }
+            }
+            b = multiply(A, x);
+            const int rank = aoc::math::reduced_row_echelon(A, b);
+            check(rank <= std::min(width, height), info);
+            int prev_col = -1;
+            for (int r = 0; r < height; ++r) {
+                // x still satisfies every row
+                long long total = 0;
+                int pivot_col = -1;
+                for (int c = 0; c < width; ++c) {
+                    total += A.at(c, r) * x[c];
+                    if (pivot_col == -1 && A.at(c, r) != 0) {
+                        pivot_col = c;
+                    }
+                }
+                check_equal(total, b[r], info);
+                if (r >= rank) {
+                    check_equal(pivot_col, -1, info + ": non-zero row");
+                    continue;
+                }
+                check(pivot_col > prev_col, info + ": pivots out of order");
+                check(A.at(pivot_col, r) > 0, info + ": negative pivot");
+                for (int r2 = 0; r2 < height; ++r2) {
+                    if (r2 != r) {
+                        check_equal(A.at(pivot_col, r2), 0LL,
+                                    info + ": pivot column not cleared");
+                    }
+                }
+                prev_col = pivot_col;
+            }
+        }
+    });
+
+    suite.test("exact solve", [&multiply]() {
+        const auto throws_overflow = [](auto &&func) {
+            try {
+                func();
+            } catch (const std::overflow_error &) {
+                return true;
+            }
+            return false;
+        };
+        const std::vector<long> x{3, -7, 2};
+
+        // fits in long
+        Grid<long> small(3, 3, std::vector<long>{2, 1, 1, 1, 3, 2, 1, 0, 0});
+        check_equal(aoc::math::solve_exact(small, multiply(small, x)),
+                    std::optional(x));
+        check(aoc::math::exact_solve_fits<long>(small, multiply(small, x)),
+              "small system should be known to fit in long");
+
+        // 2x2 minors fit, but the fraction-free products in the second step
+        // don't fit in long
+        Grid<long> medium(3, 3,
+                          std::vector<long>{12345671, 2345678, 3456789,
+                                            4567891, 15678912, 6789123,
+                                            7891234, 8912345, 19123456});
+        const std::vector<long> b = multiply(medium, x);
+        std::vector<long> result;
+        check(aoc::math::detail::solve_exact_as<long>(medium, b, result) ==
+                  aoc::math::detail::exact_status::OVERFLOW,
+              "medium system should overflow long");
+        check_equal(aoc::math::solve_exact(medium, b), std::optional(x));
+        check(!aoc::math::exact_solve_fits<long>(medium, b),
+              "medium system shouldn't be known to fit in long");
+
+        // too big for __int128 as well
+        Grid<long> large(4, 4, 0L);
+        std::mt19937 gen(123);
+        std::uniform_int_distribution<long> dist(1'000'000'000'000,
+                                                 9'000'000'000'000);
+        large.for_each([&](long &value) { value = dist(gen); });
+        const std::vector<long> x4{1, 2, 3, 4};
+        check(!aoc::math::exact_solve_fits<__int128>(large,
+                                                     multiply(large, x4)),
+              "large system shouldn't be known to fit in __int128");
+        check(throws_overflow([&]() {
+                  aoc::math::solve_exact(large, multiply(large, x4));
+              }),
+              "large system should overflow __int128");
+
+        // singular, and a non-integral solution
+        Grid<long> singular(2, 2, std::vector<long>{1, 2, 2, 4});
+        check_equal(aoc::math::solve_exact(singular, {3L, 6L}),
+                    std::optional<std::vector<long>>());
+        Grid<long> fractional(1, 1, std::vector<long>{2});
+        check_equal(aoc::math::solve_exact(fractional, {1L}),
+                    std::optional<std::vector<long>>());
+    });
+
+    suite.test("batch", [&random_system]() {
+        std::mt19937 gen(24);
+        std::uniform_int_distribution<long long> x_dist(-10, 10);
+        constexpr int n = 4;
+        aoc::math::SystemBatch<long long> batch(n, n);
+        std::vector<Grid<long long>> grids;
+        std::vector<std::vector<long long>> rhs;
+        for (int i = 0; i < 50; ++i) {
+            std::vector<long long> x(n);
+            for (auto &value : x) {
+                value = x_dist(gen);
+            }
+            Grid<long long> A(n, n);
+            std::vector<long long> b = random_system(gen, A, x);
+            check_equal(batch.add(A, b), static_cast<std::size_t>(i));
+            grids.push_back(std::move(A));
+            rhs.push_back(std::move(b));
+        }
+        check_equal(batch.size(), std::size_t{50});
+        check_equal(batch.b(3, 2), rhs[3][2]);
+        check_equal(batch.a(3, 2, 1), grids[3].at(1, 2));
+
+        const std::vector<bool> ok = aoc::math::row_echelon(batch);
+        for (std::size_t i = 0; i < ok.size(); ++i) {
+            const std::string info = "on system " + std::to_string(i);
+            check_equal(ok[i], aoc::math::row_echelon(grids[i], rhs[i]), info);
+            if (ok[i]) {
+                check_equal(aoc::math::back_substitute(batch, i),
+                            aoc::math::back_substitute(grids[i], rhs[i]),
+                            info);
+            }
+        }
+    });
+
+    return suite.done(), suite.num_failed();
+}
+
 } // namespace aoc::math::test
 
 int main() {
@@ -267,6 +700,9 @@ int main() {
 
     failed_count += test_extended_gcd();
     failed_count += test_crt();
+    failed_count += test_congruence_solver();
+    failed_count += test_gauss_elim();
+    failed_count += test_ilp_min_sum();
 
     return unit_test::fix_exit_code(failed_count);
 }
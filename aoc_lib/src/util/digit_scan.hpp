@@ -0,0 +1,139 @@
+/******************************************************************************
+ * File:        digit_scan.hpp
+ *
+ * Author:      Eric T. Johnson (yut23)
+ * Created:     2026-10-16
+ * Description: Vectorized search for runs of decimal digits in a buffer.
+ *****************************************************************************/
+
+#ifndef DIGIT_SCAN_HPP_R5TJ0WQD
+#define DIGIT_SCAN_HPP_R5TJ0WQD
+
+#include <bit>         // for countr_zero
+#include <cstddef>     // for size_t
+#include <cstdint>     // for uint64_t, uint32_t
+#include <cstring>     // for memcpy
+#include <string_view> // for string_view
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h> // IWYU pragma: keep
+#endif
+
+namespace util {
+
+namespace detail {
+/// bytes handled per step of `for_each_digit_run`
+constexpr std::size_t DIGIT_BLOCK_SIZE = 64;
+
+/**
+ * Returns a mask with bit i set if p[i] is an ASCII digit, for i in [0, 64).
+ */
+inline std::uint64_t digit_mask(const char *p) {
+#if defined(__AVX2__)
+    const __m256i lo = _mm256_set1_epi8('0' - 1);
+    const __m256i hi = _mm256_set1_epi8('9' + 1);
+    std::uint64_t mask = 0;
+    for (int i = 0; i < 2; ++i) {
+        __m256i v = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i *>(p + 32 * i));
+        __m256i is_digit = _mm256_and_si256(_mm256_cmpgt_epi8(v, lo),
+                                            _mm256_cmpgt_epi8(hi, v));
+        mask |= std::uint64_t{static_cast<std::uint32_t>(
+                    _mm256_movemask_epi8(is_digit))}
+                << (32 * i);
+    }
+    return mask;
+#elif defined(__SSE2__)
+    const __m128i lo = _mm_set1_epi8('0' - 1);
+    const __m128i hi = _mm_set1_epi8('9' + 1);
+    std::uint64_t mask = 0;
+    for (int i = 0; i < 4; ++i) {
+        __m128i v =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 16 * i));
+        __m128i is_digit =
+            _mm_and_si128(_mm_cmpgt_epi8(v, lo), _mm_cmplt_epi8(v, hi));
+        mask |= std::uint64_t{static_cast<std::uint32_t>(
+                    _mm_movemask_epi8(is_digit))}
+                << (16 * i);
+    }
+    return mask;
+#else
+    std::uint64_t mask = 0;
+    for (std::size_t i = 0; i < DIGIT_BLOCK_SIZE; ++i) {
+        mask |= std::uint64_t{p[i] >= '0' && p[i] <= '9'} << i;
+    }
+    return mask;
+#endif
+}
+} // namespace detail
+
+/**
+ * Calls `f(begin, end)` with the bounds of each maximal run of ASCII digits in
+ * `text`, in order. Stops early if `f` returns false.
+ *
+ * Classifies 64 bytes at a time with SSE2 or AVX2 when available, and finds
+ * the run boundaries with bit tricks on the resulting mask. The last partial
+ * block is copied into a padded buffer, so this never reads past the end of
+ * `text` (which matters for memory-mapped files).
+ */
+template <class F>
+void for_each_digit_run(std::string_view text, F &&f) {
+    using detail::DIGIT_BLOCK_SIZE;
+    const char *const first = text.data();
+    const std::size_t size = text.size();
+    // start of the run in progress, if any
+    const char *run_start = nullptr;
+    // whether the last byte of the previous block was a digit
+    std::uint64_t carry = 0;
+
+    // returns false to stop early
+    const auto process_block = [&](const char *block, std::uint64_t mask) {
+        std::uint64_t shifted = (mask << 1) | carry;
+        std::uint64_t starts = mask & ~shifted;
+        std::uint64_t ends = ~mask & shifted;
+        carry = mask >> 63;
+        while (true) {
+            if (run_start == nullptr) {
+                if (starts == 0) {
+                    return true;
+                }
+                run_start = block + std::countr_zero(starts);
+                starts &= starts - 1;
+            } else {
+                if (ends == 0) {
+                    return true;
+                }
+                const char *run_end = block + std::countr_zero(ends);
+                ends &= ends - 1;
+                if (!f(run_start, run_end)) {
+                    return false;
+                }
+                run_start = nullptr;
+            }
+        }
+    };
+
+    std::size_t offset = 0;
+    for (; offset + DIGIT_BLOCK_SIZE <= size; offset += DIGIT_BLOCK_SIZE) {
+        if (!process_block(first + offset,
+                           detail::digit_mask(first + offset))) {
+            return;
+        }
+    }
+    if (offset < size) {
+        char padded[DIGIT_BLOCK_SIZE] = {};
+        std::memcpy(padded, first + offset, size - offset);
+        std::uint64_t mask = detail::digit_mask(padded);
+        // the padding isn't digits, so any run still going at the end of the
+        // text ends inside this block
+        if (!process_block(first + offset, mask)) {
+            return;
+        }
+    } else if (run_start != nullptr) {
+        f(run_start, first + size);
+    }
+}
+
+} // namespace util
+
+#endif /* end of include guard: DIGIT_SCAN_HPP_R5TJ0WQD */
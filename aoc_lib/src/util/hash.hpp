@@ -10,10 +10,14 @@
 #define HASH_HPP_QKWFTL3O
 
 #include "util/concepts.hpp" // for Hashable
-#include <algorithm>         // for max  // IWYU pragma: keep
+#include <algorithm>         // for max, min  // IWYU pragma: keep
 #include <cstdint>           // for uint64_t
 #include <cstdlib>           // for size_t
+#include <cstring>           // for memcpy
 #include <functional>        // for hash
+#include <ranges>            // for contiguous_range, sized_range, range_value_t
+#include <span>              // for span, as_bytes
+#include <type_traits>       // for is_trivially_copyable_v
 // IWYU pragma: no_include <unordered_map>  // for operator==
 
 namespace util {
@@ -53,6 +57,34 @@ void make_hash(std::size_t &seed, const Ts... components) {
     hash::murmurhash2_finalize(seed);
 }
 
+/**
+ * Hashes the raw bytes of a contiguous range, 8 bytes at a time. Meant for
+ * cheap fingerprints of large flat states (e.g. a Grid's data()), where
+ * hashing each element separately would dominate.
+ */
+template <std::ranges::contiguous_range R>
+    requires std::ranges::sized_range<R> &&
+             std::is_trivially_copyable_v<std::ranges::range_value_t<R>>
+std::uint64_t hash_bytes(const R &values,
+                         std::size_t seed = 0x9e3779b97f4a7c15ull) {
+    const std::span bytes = std::as_bytes(std::span(values));
+    const std::size_t size = bytes.size();
+    std::size_t i = 0;
+    for (; i + sizeof(std::uint64_t) <= size; i += sizeof(std::uint64_t)) {
+        std::uint64_t word;
+        std::memcpy(&word, bytes.data() + i, sizeof(word));
+        hash::murmurhash2_combine(seed, word);
+    }
+    if (i < size) {
+        std::uint64_t word = 0;
+        std::memcpy(&word, bytes.data() + i, size - i);
+        hash::murmurhash2_combine(seed, word);
+    }
+    hash::murmurhash2_combine(seed, size);
+    hash::murmurhash2_finalize(seed);
+    return seed;
+}
+
 /**
  * From https://artificial-mind.net/blog/2021/10/09/unordered-map-badness.
  *
@@ -73,6 +105,7 @@ double unordered_map_badness(Map const &map) {
 }
 } // namespace hash
 
+using hash::hash_bytes;
 using hash::make_hash;
 
 } // namespace util
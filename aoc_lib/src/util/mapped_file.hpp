@@ -0,0 +1,94 @@
+/******************************************************************************
+ * File:        mapped_file.hpp
+ *
+ * Author:      Eric T. Johnson (yut23)
+ * Created:     2026-10-16
+ * Description: Read-only memory-mapped files.
+ *****************************************************************************/
+
+#ifndef MAPPED_FILE_HPP_W2NF8ZKE
+#define MAPPED_FILE_HPP_W2NF8ZKE
+
+#include <cerrno>       // for errno
+#include <cstddef>      // for size_t
+#include <string>       // for string
+#include <string_view>  // for string_view
+#include <system_error> // for system_error, system_category
+#include <utility>      // for exchange
+
+#include <fcntl.h>    // for open, O_RDONLY
+#include <sys/mman.h> // for mmap, munmap, madvise
+#include <sys/stat.h> // for fstat
+#include <unistd.h>   // for close
+
+namespace util {
+
+/**
+ * Maps a whole file into memory read-only, and exposes it as a string_view.
+ * The view is only valid while the MappedFile is alive.
+ */
+class MappedFile {
+    const char *m_data = nullptr;
+    std::size_t m_size = 0;
+
+  public:
+    explicit MappedFile(const std::string &filename) {
+        int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd == -1) {
+            throw std::system_error(errno, std::system_category(), filename);
+        }
+        struct stat st {};
+        if (::fstat(fd, &st) == -1) {
+            int err = errno;
+            ::close(fd);
+            throw std::system_error(err, std::system_category(), filename);
+        }
+        m_size = static_cast<std::size_t>(st.st_size);
+        // mmap rejects zero-length mappings, so leave empty files unmapped
+        if (m_size > 0) {
+            void *addr =
+                ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr == MAP_FAILED) {
+                int err = errno;
+                ::close(fd);
+                throw std::system_error(err, std::system_category(),
+                                        filename);
+            }
+            // inputs are always parsed front to back
+            ::madvise(addr, m_size, MADV_SEQUENTIAL);
+            m_data = static_cast<const char *>(addr);
+        }
+        // the mapping stays valid after the descriptor is closed
+        ::close(fd);
+    }
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+    MappedFile(MappedFile &&other) noexcept
+        : m_data(std::exchange(other.m_data, nullptr)),
+          m_size(std::exchange(other.m_size, 0)) {}
+    MappedFile &operator=(MappedFile &&other) noexcept {
+        if (this != &other) {
+            unmap();
+            m_data = std::exchange(other.m_data, nullptr);
+            m_size = std::exchange(other.m_size, 0);
+        }
+        return *this;
+    }
+    ~MappedFile() { unmap(); }
+
+    std::string_view view() const { return {m_data, m_size}; }
+    std::size_t size() const { return m_size; }
+
+  private:
+    void unmap() {
+        if (m_data != nullptr) {
+            ::munmap(const_cast<char *>(m_data), m_size);
+            m_data = nullptr;
+        }
+    }
+};
+
+} // namespace util
+
+#endif /* end of include guard: MAPPED_FILE_HPP_W2NF8ZKE */
@@ -11,13 +11,16 @@
 
 #include <array>       // for array
 #include <cmath>       // for signbit
-#include <concepts>    // for integral, same_as
+#include <concepts>    // for integral, signed_integral, same_as
 #include <cstddef>     // for size_t
 #include <iterator>    // for operator== (next_power_of_10) // IWYU pragma: keep
 #include <limits>      // for numeric_limits
-#include <stdexcept>   // for invalid_argument
+#include <numeric>     // for gcd
+#include <optional>    // for optional
+#include <span>        // for span
+#include <stdexcept>   // for invalid_argument, overflow_error
 #include <type_traits> // for remove_cvref_t
-#include <utility>     // for forward
+#include <utility>     // for forward, exchange
 #include <vector>      // for vector
 
 namespace aoc::math {
@@ -116,6 +119,28 @@ constexpr IntegerT powi(IntegerT base, unsigned int exponent) {
     }
 }
 
+/**
+ * Signed integer types, including __int128, which std::signed_integral
+ * doesn't accept outside of the GNU dialects.
+ */
+template <class T>
+concept signed_integer = std::signed_integral<T> || std::same_as<T, __int128>;
+
+/// std::gcd, extended to __int128.
+template <signed_integer T>
+constexpr T gcd(T a, T b) {
+    if constexpr (std::signed_integral<T>) {
+        return std::gcd(a, b);
+    } else {
+        a = a < 0 ? -a : a;
+        b = b < 0 ? -b : b;
+        while (b != 0) {
+            a = std::exchange(b, a % b);
+        }
+        return a;
+    }
+}
+
 struct extended_gcd_result {
     long gcd;
     long bezout_a;
@@ -162,6 +187,11 @@ extended_gcd_result extended_gcd(long a, long b) {
     return result;
 }
 
+/**
+ * Solves a list of congruences all at once, using CongruenceSolver (so the
+ * moduli don't need to be coprime). Throws std::invalid_argument if they're
+ * inconsistent.
+ */
 struct CRT {
     struct crt_entry {
         long remainder;
@@ -185,33 +215,147 @@ struct CRT {
     crt_entry solve() const;
 };
 
+/**
+ * Incrementally combines congruences x = r_i (mod m_i) into a single
+ * congruence x = r (mod m), where m is the lcm of the m_i. Unlike CRT, the
+ * moduli don't need to be coprime.
+ *
+ * The combined congruence is kept in __int128, and adding a congruence throws
+ * std::overflow_error if m doesn't fit. Once a congruence contradicts the
+ * earlier ones, the system stays inconsistent and later adds do nothing.
+ */
+class CongruenceSolver {
+  public:
+    using crt_entry = CRT::crt_entry;
+
+  private:
+    __int128 m_remainder = 0;
+    __int128 m_modulus = 1;
+    bool m_consistent = true;
+
+  public:
+    /// Adds x = remainder (mod modulus). Returns false if the system is now
+    /// inconsistent.
+    bool add(long remainder, long modulus);
+    bool add(const crt_entry &entry) {
+        return add(entry.remainder, entry.modulus);
+    }
+    /// Adds each entry in order, stopping at the first contradiction.
+    bool add(std::span<const crt_entry> entries);
+
+    bool consistent() const { return m_consistent; }
+    __int128 remainder() const { return m_remainder; }
+    __int128 modulus() const { return m_modulus; }
+
+    /**
+     * Returns the combined congruence, with 0 <= remainder < modulus, or {} if
+     * the system is inconsistent. Throws std::overflow_error if the modulus
+     * doesn't fit in a long.
+     */
+    std::optional<crt_entry> solution() const;
+
+    /**
+     * Returns solution() for this system plus each of `queries` on its own,
+     * without modifying this system (so a shared prefix of congruences is
+     * only combined once).
+     */
+    std::vector<std::optional<crt_entry>>
+    solve_each(std::span<const crt_entry> queries) const;
+};
+
+bool CongruenceSolver::add(long remainder, long modulus) {
+    if (modulus <= 0) {
+        throw std::invalid_argument("modulus must be positive");
+    }
+    if (!m_consistent) {
+        return false;
+    }
+    remainder %= modulus;
+    if (remainder < 0) {
+        remainder += modulus;
+    }
+    // gcd(m, modulus) == gcd(m % modulus, modulus), which stays in a long
+    const long m_reduced = static_cast<long>(m_modulus % modulus);
+    const long g = std::gcd(m_reduced, modulus);
+    long diff = remainder - static_cast<long>(m_remainder % modulus);
+    if (diff < 0) {
+        diff += modulus;
+    }
+    if (diff % g != 0) {
+        m_consistent = false;
+        return false;
+    }
+    // solve m * k = diff (mod modulus) for k, in the reduced modulus
+    const long step = modulus / g;
+    long k = 0;
+    if (step != 1) {
+        long inverse = extended_gcd((m_reduced / g) % step, step).bezout_a;
+        if (inverse < 0) {
+            inverse += step;
+        }
+        k = static_cast<long>(static_cast<__int128>(diff / g) * inverse % step);
+    }
+    __int128 new_modulus;
+    if (__builtin_mul_overflow(m_modulus, step, &new_modulus)) {
+        throw std::overflow_error("overflow in aoc::math::CongruenceSolver");
+    }
+    // k < step, so this is less than new_modulus
+    m_remainder += m_modulus * k;
+    m_modulus = new_modulus;
+    return true;
+}
+
+bool CongruenceSolver::add(std::span<const crt_entry> entries) {
+    for (const crt_entry &entry : entries) {
+        if (!add(entry)) {
+            return false;
+        }
+    }
+    return m_consistent;
+}
+
+std::optional<CongruenceSolver::crt_entry> CongruenceSolver::solution() const {
+    if (!m_consistent) {
+        return {};
+    }
+    if (m_modulus > std::numeric_limits<long>::max()) {
+        throw std::overflow_error("overflow in aoc::math::CongruenceSolver");
+    }
+    return crt_entry{.remainder = static_cast<long>(m_remainder),
+                     .modulus = static_cast<long>(m_modulus)};
+}
+
+std::vector<std::optional<CongruenceSolver::crt_entry>>
+CongruenceSolver::solve_each(std::span<const crt_entry> queries) const {
+    std::vector<std::optional<crt_entry>> results;
+    results.reserve(queries.size());
+    for (const crt_entry &query : queries) {
+        CongruenceSolver tmp = *this;
+        tmp.add(query);
+        results.push_back(tmp.solution());
+    }
+    return results;
+}
+
 CRT::crt_entry CRT::solve_pair(const crt_entry &entry_a,
                                const crt_entry &entry_b) {
-    // use extended Euclidean algorithm to get the Bézout coefficients
-    auto gcd = extended_gcd(entry_a.modulus, entry_b.modulus);
-    if (gcd.gcd != 1) {
-        throw std::invalid_argument("moduli must be coprime");
-    }
-    auto rem = entry_a.remainder * gcd.bezout_b * entry_b.modulus +
-               entry_b.remainder * gcd.bezout_a * entry_a.modulus;
-    // return the smallest positive remainder
-    crt_entry entry = {.remainder = rem,
-                       .modulus = entry_a.modulus * entry_b.modulus};
-    while (entry.remainder < 0) {
-        entry.remainder += entry.modulus;
-    }
-    return entry;
+    CongruenceSolver solver;
+    solver.add(entry_a);
+    if (!solver.add(entry_b)) {
+        throw std::invalid_argument("congruences are inconsistent");
+    }
+    return *solver.solution();
 }
 
 CRT::crt_entry CRT::solve() const {
     if (entries.empty()) {
         throw std::invalid_argument("CRT object must have at least 1 entry");
     }
-    auto tmp = entries.front();
-    for (std::size_t i = 1; i < entries.size(); ++i) {
-        tmp = solve_pair(tmp, entries[i]);
+    CongruenceSolver solver;
+    if (!solver.add(entries)) {
+        throw std::invalid_argument("congruences are inconsistent");
     }
-    return tmp;
+    return *solver.solution();
 }
 
 } // namespace aoc::math
@@ -0,0 +1,158 @@
+/******************************************************************************
+ * File:        thread_pool.hpp
+ *
+ * Author:      Eric T. Johnson (yut23)
+ * Created:     2026-10-17
+ * Description: A small work-stealing thread pool.
+ *****************************************************************************/
+
+#ifndef THREAD_POOL_HPP_J7QX3D5M
+#define THREAD_POOL_HPP_J7QX3D5M
+
+#include <algorithm>          // for max
+#include <atomic>             // for atomic
+#include <condition_variable> // for condition_variable
+#include <cstddef>            // for size_t
+#include <deque>              // for deque
+#include <functional>         // for function
+#include <memory>             // for unique_ptr, make_unique
+#include <mutex>              // for mutex, lock_guard, unique_lock
+#include <optional>           // for optional
+#include <thread>             // for jthread, hardware_concurrency
+#include <utility>            // for move
+#include <vector>             // for vector
+
+namespace util {
+
+/**
+ * Fixed-size pool of worker threads. Each worker has its own deque of tasks:
+ * it takes work from the back of its own deque, and when that runs out, it
+ * steals from the front of the other workers' deques.
+ *
+ * Tasks submitted from outside the pool are spread round-robin over the
+ * workers, and tasks submitted from a worker go on that worker's deque. Tasks
+ * must not throw.
+ */
+class ThreadPool {
+    using task_t = std::function<void()>;
+
+    struct Worker {
+        std::mutex mutex;
+        std::deque<task_t> tasks;
+    };
+
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    std::vector<std::jthread> m_threads;
+    // number of tasks in the deques
+    std::atomic<std::size_t> m_queued = 0;
+    // number of tasks submitted but not yet finished
+    std::atomic<std::size_t> m_pending = 0;
+    std::atomic<std::size_t> m_next_worker = 0;
+    bool m_stopping = false;
+
+    // protects m_stopping, and is used for sleeping and waiting
+    std::mutex m_mutex;
+    std::condition_variable m_work_available;
+    std::condition_variable m_all_done;
+
+    static inline thread_local const ThreadPool *t_pool = nullptr;
+    static inline thread_local std::size_t t_index = 0;
+
+    std::optional<task_t> pop_task(std::size_t index) {
+        {
+            Worker &own = *m_workers[index];
+            std::lock_guard lock(own.mutex);
+            if (!own.tasks.empty()) {
+                task_t task = std::move(own.tasks.back());
+                own.tasks.pop_back();
+                return task;
+            }
+        }
+        for (std::size_t i = 1; i < m_workers.size(); ++i) {
+            Worker &victim = *m_workers[(index + i) % m_workers.size()];
+            std::lock_guard lock(victim.mutex);
+            if (!victim.tasks.empty()) {
+                task_t task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                return task;
+            }
+        }
+        return std::nullopt;
+    }
+
+    void run_worker(std::size_t index) {
+        t_pool = this;
+        t_index = index;
+        while (true) {
+            if (auto task = pop_task(index)) {
+                --m_queued;
+                (*task)();
+                if (--m_pending == 0) {
+                    std::lock_guard lock(m_mutex);
+                    m_all_done.notify_all();
+                }
+                continue;
+            }
+            std::unique_lock lock(m_mutex);
+            m_work_available.wait(
+                lock, [this]() { return m_stopping || m_queued > 0; });
+            if (m_stopping && m_queued == 0) {
+                return;
+            }
+        }
+    }
+
+  public:
+    explicit ThreadPool(
+        std::size_t num_threads = std::thread::hardware_concurrency()) {
+        num_threads = std::max<std::size_t>(num_threads, 1);
+        for (std::size_t i = 0; i < num_threads; ++i) {
+            m_workers.push_back(std::make_unique<Worker>());
+        }
+        for (std::size_t i = 0; i < num_threads; ++i) {
+            m_threads.emplace_back([this, i]() { run_worker(i); });
+        }
+    }
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    /// Finishes all the queued tasks, then stops the workers.
+    ~ThreadPool() {
+        {
+            std::lock_guard lock(m_mutex);
+            m_stopping = true;
+        }
+        m_work_available.notify_all();
+        m_threads.clear();
+    }
+
+    std::size_t size() const { return m_workers.size(); }
+
+    void submit(task_t task) {
+        const std::size_t index = t_pool == this
+                                      ? t_index
+                                      : m_next_worker++ % m_workers.size();
+        ++m_pending;
+        {
+            // lock so a worker can't miss the wakeup between checking
+            // m_queued and going to sleep, and count the task before it can
+            // be taken
+            std::lock_guard lock(m_mutex);
+            ++m_queued;
+            Worker &worker = *m_workers[index];
+            std::lock_guard worker_lock(worker.mutex);
+            worker.tasks.push_back(std::move(task));
+        }
+        m_work_available.notify_one();
+    }
+
+    /// Blocks until every submitted task has finished.
+    void wait() {
+        std::unique_lock lock(m_mutex);
+        m_all_done.wait(lock, [this]() { return m_pending == 0; });
+    }
+};
+
+} // namespace util
+
+#endif /* end of include guard: THREAD_POOL_HPP_J7QX3D5M */
@@ -0,0 +1,28 @@
+#!/bin/bash
+# Generates a source file that links every day into one binary, by renaming
+# each day's main() and including its source file directly (see
+# aoc_lib/src/runner.hpp).
+#
+# usage: gen_all_days.sh src/dayNN.cpp... > all_days.cpp
+set -euo pipefail
+
+days=()
+for src_file in "$@"; do
+  days+=("$(basename "$src_file" .cpp)")
+done
+
+echo '// generated by tools/cpp/gen_all_days.sh, do not edit'
+echo
+for day in "${days[@]}"; do
+  printf '#define main %s_main\n#include "%s.cpp" // IWYU pragma: keep\n#undef main\n\n' "$day" "$day"
+done
+echo '#include "runner.hpp"'
+echo
+echo 'int main(int argc, char **argv) {'
+echo '    static constexpr aoc::runner::Day days[] = {'
+for day in "${days[@]}"; do
+  printf '        {%d, %s_main},\n' "$((10#${day#day}))" "$day"
+done
+echo '    };'
+echo '    return aoc::runner::run(argc, argv, days);'
+echo '}'
@@ -12,6 +12,9 @@ Usage: $0 <day> [--num NUM [-f]] [hyperfine options...]
 
 Run aoc under perf(1) and hyperfine generate flamegraphs.
 
+For hardware counters on specific regions of code (see aoc_lib/src/perf.hpp),
+run a build/fast or build/profile binary with AOC_PERF=1 instead.
+
 Options:
  --num NUM    set the run number
  -f, --force  overwrite existing runs instead of incrementing the run number
@@ -1,37 +1,125 @@
 #!/bin/bash
 set -euo pipefail
 
+usage() {
+  echo "Usage: run_answer_tests.sh [-j jobs] [-m memory_limit] [--no-cache] [day...]"
+}
+
 AOC_ROOT="$(git rev-parse --show-toplevel)"
 # shellcheck source=lib.sh
 source "$AOC_ROOT/tools/lib.sh"
 # cd to the base directory for this year
 cd -- "$AOC_ROOT/$AOC_YEAR"
 
+max_jobs=$(nproc)
+memory_limit=4G
+if [[ -n ${GITHUB_ACTIONS:+x} ]]; then
+  # don't use systemd-run when running on GHA
+  memory_limit=none
+fi
+use_cache=y
+days=()
+while [[ $# -gt 0 ]]; do
+  case $1 in
+    -j|--jobs)
+      max_jobs=$2
+      shift 2
+      ;;
+    -j*)
+      max_jobs=${1#-j}
+      shift
+      ;;
+    -m|--memory-limit)
+      memory_limit=$2
+      shift 2
+      ;;
+    --no-cache)
+      use_cache=n
+      shift
+      ;;
+    -h|--help)
+      usage
+      exit 0
+      ;;
+    -*)
+      echo "Error: unrecognized option '$1'"
+      usage
+      exit 1
+      ;;
+    *)
+      days+=("$1")
+      shift
+      ;;
+  esac
+done
+
+# same as ./aoc: print a stacktrace on UBSan errors, and have ASan print a
+# backtrace when an assertion fails
+export UBSAN_OPTIONS=${UBSAN_OPTIONS:-print_stacktrace=1}
+export ASAN_OPTIONS="${ASAN_OPTIONS:+${ASAN_OPTIONS}:}handle_abort=1"
+
+# Outputs from successful runs, keyed by the hash of the binary and the name
+# and hash of the input file, so tests where none of these have changed don't
+# need to be run again. The name is part of the key since some days behave
+# differently for example inputs. The output is still compared against the
+# answer file every time.
+cache_dir=build/answer_test_cache
+results_dir=$(mktemp -d)
+trap 'rm -rf "$results_dir"' EXIT
+# stop any running tests on SIGINT (systemd-run doesn't pass it on to the
+# unit, since its standard streams are redirected)
+trap 'kill $(jobs -p) 2>/dev/null || true
+      if [[ $memory_limit != none ]]; then
+        systemctl --quiet --user stop "aoc-test-*.service" 2>/dev/null || true
+      fi
+      exit 130' INT
+
+# writes "<status> <time>" to $result_file, and the output, stderr and diff to
+# files next to it
 run_test() {
-  local day input output args ret
+  local day input output result_file binary_hash
+  local cache_file cmd start end ret time status
   day=$1
-  # just the basename
-  input=$(basename "$2")
+  input=$2
   output=$3
-  args=()
-  if [[ -n ${GITHUB_ACTIONS:+x} ]]; then
-    # don't use systemd-run when running on GHA
-    args+=(-m none)
+  result_file=$4
+  binary_hash=$5
+  cache_file=
+  if [[ $use_cache == y ]]; then
+    cache_file="$cache_dir/$binary_hash-$(basename "$input")-$(sha256sum <"$input" | cut -d' ' -f1)"
   fi
-  ./aoc "$day" -q "${args[@]}" -i "$input" | diff "$output" - && ret=$? || ret=$?
-  if [[ $ret -eq 130 ]]; then
-    # killed by SIGINT, exit immediately
-    exit $ret
+  if [[ -n $cache_file ]] && [[ -f $cache_file ]]; then
+    cp "$cache_file" "$result_file.out"
+    time=cached
+  else
+    cmd=("build/release/day$day" "$input")
+    if [[ $memory_limit != none ]]; then
+      # limit memory usage like ./aoc does, with a separate transient unit for
+      # each test, since several run at once
+      cmd=(systemd-run --user --unit="aoc-test-$BASHPID" --quiet --collect
+           --pipe --wait --same-dir -p MemoryMax="$memory_limit"
+           -p MemorySwapMax=0 -E ASAN_OPTIONS -E UBSAN_OPTIONS "${cmd[@]}")
+    fi
+    start=$(date +%s%N)
+    { echo "Day ${day#0}:"; "${cmd[@]}"; } \
+      >"$result_file.out" 2>"$result_file.err" && ret=$? || ret=$?
+    end=$(date +%s%N)
+    printf -v time '%.1f ms' "$(( (end - start) / 1000 ))e-3"
+    if [[ $ret -eq 0 ]] && [[ -n $cache_file ]]; then
+      mkdir -p "$cache_dir"
+      # write atomically, since other jobs may be reading it
+      cp "$result_file.out" "$cache_file.$BASHPID"
+      mv "$cache_file.$BASHPID" "$cache_file"
+    fi
   fi
-  if [[ $ret -eq 0 ]]; then
-    printf 'Day %2d, %13s answer test \033[32mpassed\033[0m\n' "${day#0}" "$input:"
+  if diff "$output" "$result_file.out" >"$result_file.diff"; then
+    status=passed
   else
-    printf 'Day %2d, %13s answer test \033[31mfailed\033[0m\n' "${day#0}" "$input:"
+    status=failed
   fi
-  return $ret
+  printf '%s %s\n' "$status" "$time" >"$result_file"
 }
 
-days=("$@")
 if [[ ${#days[@]} -eq 0 ]]; then
   # run all tests
   for src_file in src/day*.cpp; do
@@ -60,7 +148,7 @@ for day in "${padded_days[@]}"; do
   fi
 done
 if [[ ${#targets[@]} -gt 0 ]]; then
-  make -j8 "${targets[@]}" || printf '\n'
+  make -j"$max_jobs" "${targets[@]}" || printf '\n'
 fi
 # check for compilation errors here rather than inside the loop, as I was
 # getting spurious failures if I touched the source files while this script was
@@ -74,6 +162,8 @@ done
 
 
 fail_count=0
+tests=()
+sweep_start=$(date +%s%N)
 for day in "${padded_days[@]}"; do
   outputs=("answer_tests/day${day}"/*)
   if [[ ${#outputs[@]} -eq 0 ]]; then
@@ -84,13 +174,44 @@ for day in "${padded_days[@]}"; do
     (( fail_count += ${#outputs[@]} ))
     continue
   fi
+  binary_hash=$(sha256sum <"build/release/day$day" | cut -d' ' -f1)
   for output in "${outputs[@]}"; do
     input="input/${output#answer_tests/}"
     if [[ -e "$input" ]]; then
-      if ! run_test "$day" "$input" "$output"; then
-        (( ++fail_count ))
-      fi
+      # limit the number of tests running at once
+      while [[ $(jobs -rp | wc -l) -ge $max_jobs ]]; do
+        wait -n || true
+      done
+      run_test "$day" "$input" "$output" "$results_dir/${#tests[@]}" \
+        "$binary_hash" &
+      tests+=("$day $input")
     fi
   done
 done
+wait
+
+# print the results in order
+cached_count=0
+for i in "${!tests[@]}"; do
+  read -r day input <<<"${tests[$i]}"
+  input=$(basename "$input")
+  status=failed
+  time=-
+  if [[ -s "$results_dir/$i" ]]; then
+    read -r status time <"$results_dir/$i"
+  fi
+  if [[ $time == cached ]]; then
+    (( ++cached_count ))
+  fi
+  if [[ $status == passed ]]; then
+    printf 'Day %2d, %13s answer test \033[32mpassed\033[0m (%s)\n' "${day#0}" "$input:" "$time"
+  else
+    cat "$results_dir/$i.diff" "$results_dir/$i.err" 2>/dev/null || true
+    printf 'Day %2d, %13s answer test \033[31mfailed\033[0m (%s)\n' "${day#0}" "$input:" "$time"
+    (( ++fail_count ))
+  fi
+done
+sweep_end=$(date +%s%N)
+printf -v sweep_time '%.2f s' "$(( (sweep_end - sweep_start) / 1000000 ))e-3"
+printf '%d tests (%d cached) in %s\n' "${#tests[@]}" "$cached_count" "$sweep_time"
 exit "$fail_count"